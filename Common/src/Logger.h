@@ -9,10 +9,10 @@
 	#define STRINGIFY2( x ) #x
 	#define STRINGIFY( x ) STRINGIFY2( x )
 
-	#define LOG_INFO( message, ... ) Common::LogInfo( message, __VA_ARGS__ )
-	#define LOG_WARNING( message, ... ) Common::LogWarning( message, __VA_ARGS__ )
-	#define LOG_ERROR( message, ... ) Common::LogError( __FILE__, STRINGIFY( __LINE__ ), message, __VA_ARGS__ )
-	#define LOG_FATAL( message, ... ) Common::LogFatal( __FILE__, STRINGIFY( __LINE__ ), message, __VA_ARGS__ )
+	#define LOG_INFO( message, ... ) Common::LogInfo( message, ##__VA_ARGS__ )
+	#define LOG_WARNING( message, ... ) Common::LogWarning( message, ##__VA_ARGS__ )
+	#define LOG_ERROR( message, ... ) Common::LogError( __FILE__, STRINGIFY( __LINE__ ), message, ##__VA_ARGS__ )
+	#define LOG_FATAL( message, ... ) Common::LogFatal( __FILE__, STRINGIFY( __LINE__ ), message, ##__VA_ARGS__ )
 	#define TIME_FORMAT "%H:%M:%S"
 
 namespace Common
@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <cassert>
+#include <utility>
 
 #include "fixed_size_function.hpp"
 #include "logger.h"
@@ -22,6 +23,10 @@ namespace Common
 			static constexpr SubscriptionId INVALID_SUBSCRIPTION_ID = 0;
 			static constexpr SubscriptionId MAX_SUBSCRIPTION_ID = MAX_UINT16;
 
+		private:
+			struct SubscriptionData;
+
+		public:
 			struct SubscriptionHandler
 			{
 				public:
@@ -16,15 +16,15 @@ typedef int64_t int64;
 typedef float float32;
 typedef double float64;
 
-constexpr uint8 MAX_UINT8 = 0xFFui8;
-constexpr uint16 MAX_UINT16 = 0xFFFFui16;
-constexpr uint32 MAX_UINT32 = 0xFFFFFFFFui32;
-constexpr uint64 MAX_UINT64 = 0xFFFFFFFFFFFFFFFFui64;
-
-constexpr int8 MAX_INT8 = 0x7Fui8;
-constexpr int16 MAX_INT16 = 0x7FFFui16;
-constexpr int32 MAX_INT32 = 0x7FFFFFFFui32;
-constexpr int64 MAX_INT64 = 0x7FFFFFFFFFFFFFFFui64;
+constexpr uint8 MAX_UINT8 = 0xFFu;
+constexpr uint16 MAX_UINT16 = 0xFFFFu;
+constexpr uint32 MAX_UINT32 = 0xFFFFFFFFu;
+constexpr uint64 MAX_UINT64 = 0xFFFFFFFFFFFFFFFFull;
+
+constexpr int8 MAX_INT8 = 0x7F;
+constexpr int16 MAX_INT16 = 0x7FFF;
+constexpr int32 MAX_INT32 = 0x7FFFFFFF;
+constexpr int64 MAX_INT64 = 0x7FFFFFFFFFFFFFFFll;
 
 constexpr uint8 HALF_UINT8 = ( MAX_UINT8 / 2 );
 constexpr uint16 HALF_UINT16 = ( MAX_UINT16 / 2 );
@@ -98,16 +98,16 @@ void ClientNetworkEntityCreator::OnNetworkEntityComponentConfigure( Engine::ECS:
 		return;
 	}
 
-	auto callback_for_owner = [ entity ]( NetLib::Buffer& buffer ) mutable
+	auto callback_for_owner = [ entity ]( NetLib::BitReader& reader ) mutable
 	{
-		DeserializeForOwner( entity, buffer );
+		DeserializeForOwner( entity, reader );
 	};
 
 	_config.communicationCallbacks->OnUnserializeEntityStateForOwner.AddSubscriber( callback_for_owner );
 
-	auto callback_for_non_owner = [ entity ]( NetLib::Buffer& buffer ) mutable
+	auto callback_for_non_owner = [ entity ]( NetLib::BitReader& reader ) mutable
 	{
-		DeserializeForNonOwner( entity, buffer );
+		DeserializeForNonOwner( entity, reader );
 	};
 
 	_config.communicationCallbacks->OnUnserializeEntityStateForNonOwner.AddSubscriber( callback_for_non_owner );
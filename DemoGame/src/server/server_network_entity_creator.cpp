@@ -58,16 +58,16 @@ void ServerNetworkEntityCreator::OnNetworkEntityComponentConfigure( Engine::ECS:
 	}
 
 	const Engine::ECS::World& world = *_world;
-	auto callback_for_owner = [ &world, entity ]( NetLib::Buffer& buffer ) mutable
+	auto callback_for_owner = [ &world, entity ]( NetLib::BitWriter& writer ) mutable
 	{
-		SerializeForOwner( world, entity, buffer );
+		SerializeForOwner( world, entity, writer );
 	};
 
 	_config.communicationCallbacks->OnSerializeEntityStateForOwner.AddSubscriber( callback_for_owner );
 
-	auto callback_for_non_owner = [ entity ]( NetLib::Buffer& buffer ) mutable
+	auto callback_for_non_owner = [ entity ]( NetLib::BitWriter& writer ) mutable
 	{
-		SerializeForNonOwner( entity, buffer );
+		SerializeForNonOwner( entity, writer );
 	};
 
 	_config.communicationCallbacks->OnSerializeEntityStateForNonOwner.AddSubscriber( callback_for_non_owner );
@@ -1,6 +1,7 @@
 #include "player_network_entity_serialization_callbacks.h"
 
 #include "vec2f.h"
+#include "logger.h"
 
 #include "ecs/game_entity.hpp"
 #include "ecs/world.h"
@@ -13,37 +14,52 @@
 
 #include "shared/global_components/network_peer_global_component.h"
 
-#include "core/buffer.h"
+#include "core/bit_writer.h"
+#include "core/bit_reader.h"
 
 #include "shared/player_simulation/player_state.h"
 #include "shared/player_simulation/player_state_utils.h"
 
-void SerializeForOwner( const Engine::ECS::World& world, const Engine::ECS::GameEntity& entity, NetLib::Buffer& buffer )
+// Non owners only use the movement direction for visuals, so it is quantized. Its components are in range [-1, 1]
+constexpr float32 MOVEMENT_DIRECTION_MIN_VALUE = -1.f;
+constexpr float32 MOVEMENT_DIRECTION_MAX_VALUE = 1.f;
+constexpr float32 MOVEMENT_DIRECTION_RESOLUTION = 0.01f;
+
+void SerializeForOwner( const Engine::ECS::World& world, const Engine::ECS::GameEntity& entity,
+                        NetLib::BitWriter& writer )
 {
 	const ServerPlayerStateStorageComponent& serverPlayerStateStorage =
 	    entity.GetComponent< ServerPlayerStateStorageComponent >();
-	SerializePlayerStateToBuffer( serverPlayerStateStorage.lastPlayerStateSimulated, buffer );
+	SerializePlayerState( serverPlayerStateStorage.lastPlayerStateSimulated, writer );
 }
 
-void SerializeForNonOwner( const Engine::ECS::GameEntity& entity, NetLib::Buffer& buffer )
+void SerializeForNonOwner( const Engine::ECS::GameEntity& entity, NetLib::BitWriter& writer )
 {
 	const ServerPlayerStateStorageComponent& serverPlayerStateStorage =
 	    entity.GetComponent< ServerPlayerStateStorageComponent >();
-
-	buffer.WriteFloat( serverPlayerStateStorage.lastPlayerStateSimulated.position.X() );
-	buffer.WriteFloat( serverPlayerStateStorage.lastPlayerStateSimulated.position.Y() );
-	buffer.WriteFloat( serverPlayerStateStorage.lastPlayerStateSimulated.rotationAngle );
-	buffer.WriteFloat( serverPlayerStateStorage.lastPlayerStateSimulated.movementDirection.X() );
-	buffer.WriteFloat( serverPlayerStateStorage.lastPlayerStateSimulated.movementDirection.Y() );
-
-	// TODO Serialize this in a more efficient way to fit multiple bools in one byte
-	buffer.WriteInteger( serverPlayerStateStorage.lastPlayerStateSimulated.isWalking ? 1 : 0 );
-	buffer.WriteInteger( serverPlayerStateStorage.lastPlayerStateSimulated.isAiming ? 1 : 0 );
+	const PlayerSimulation::PlayerState& playerState = serverPlayerStateStorage.lastPlayerStateSimulated;
+
+	writer.WriteFloat( playerState.position.X() );
+	writer.WriteFloat( playerState.position.Y() );
+	writer.WriteFloat( playerState.rotationAngle );
+	writer.WriteQuantizedFloat( playerState.movementDirection.X(), MOVEMENT_DIRECTION_MIN_VALUE,
+	                            MOVEMENT_DIRECTION_MAX_VALUE, MOVEMENT_DIRECTION_RESOLUTION );
+	writer.WriteQuantizedFloat( playerState.movementDirection.Y(), MOVEMENT_DIRECTION_MIN_VALUE,
+	                            MOVEMENT_DIRECTION_MAX_VALUE, MOVEMENT_DIRECTION_RESOLUTION );
+
+	writer.WriteBool( playerState.isWalking );
+	writer.WriteBool( playerState.isAiming );
 }
 
-void DeserializeForOwner( Engine::ECS::GameEntity& entity, NetLib::Buffer& buffer )
+void DeserializeForOwner( Engine::ECS::GameEntity& entity, NetLib::BitReader& reader )
 {
-	PlayerSimulation::PlayerState playerState = PlayerSimulation::DeserializePlayerStateFromBuffer( buffer );
+	PlayerSimulation::PlayerState playerState;
+	if ( !PlayerSimulation::DeserializePlayerState( reader, playerState ) )
+	{
+		LOG_ERROR( "[%s] Can't deserialize player state for owner. Ignoring it.", THIS_FUNCTION_NAME );
+		return;
+	}
+
 	ClientSidePredictionComponent& clientSidePredictionComponent =
 	    entity.GetComponent< ClientSidePredictionComponent >();
 
@@ -51,21 +67,38 @@ void DeserializeForOwner( Engine::ECS::GameEntity& entity, NetLib::Buffer& buffe
 	clientSidePredictionComponent.isPendingPlayerStateFromServer = true;
 }
 
-void DeserializeForNonOwner( Engine::ECS::GameEntity& entity, NetLib::Buffer& buffer )
+void DeserializeForNonOwner( Engine::ECS::GameEntity& entity, NetLib::BitReader& reader )
 {
+	float32 positionX, positionY;
+	float32 rotationAngle;
+	float32 movementDirectionX, movementDirectionY;
+	bool isWalking, isAiming;
+
+	bool result = reader.ReadFloat( positionX );
+	result = result && reader.ReadFloat( positionY );
+	result = result && reader.ReadFloat( rotationAngle );
+	result = result && reader.ReadQuantizedFloat( movementDirectionX, MOVEMENT_DIRECTION_MIN_VALUE,
+	                                              MOVEMENT_DIRECTION_MAX_VALUE, MOVEMENT_DIRECTION_RESOLUTION );
+	result = result && reader.ReadQuantizedFloat( movementDirectionY, MOVEMENT_DIRECTION_MIN_VALUE,
+	                                              MOVEMENT_DIRECTION_MAX_VALUE, MOVEMENT_DIRECTION_RESOLUTION );
+	result = result && reader.ReadBool( isWalking );
+	result = result && reader.ReadBool( isAiming );
+
+	if ( !result )
+	{
+		LOG_ERROR( "[%s] Can't deserialize player state for non owner. Ignoring it.", THIS_FUNCTION_NAME );
+		return;
+	}
+
 	PlayerInterpolatedStateComponent& interpolatedStateComponent =
 	    entity.GetComponent< PlayerInterpolatedStateComponent >();
 
 	PlayerInterpolatedState newState;
-	newState.position.X( buffer.ReadFloat() );
-	newState.position.Y( buffer.ReadFloat() );
-	newState.rotationAngle = buffer.ReadFloat();
-	newState.movementDirection.X( buffer.ReadFloat() );
-	newState.movementDirection.Y( buffer.ReadFloat() );
-
-	// TODO Serialize this in a more efficient way to fit multiple bools in one byte
-	newState.isWalking = buffer.ReadInteger() == 1 ? true : false;
-	newState.isAiming = buffer.ReadInteger() == 1 ? true : false;
+	newState.position = Vec2f( positionX, positionY );
+	newState.rotationAngle = rotationAngle;
+	newState.movementDirection = Vec2f( movementDirectionX, movementDirectionY );
+	newState.isWalking = isWalking;
+	newState.isAiming = isAiming;
 
 	interpolatedStateComponent.state = newState;
 }
@@ -11,11 +11,12 @@ namespace Engine
 
 namespace NetLib
 {
-	class Buffer;
+	class BitWriter;
+	class BitReader;
 }
 
 void SerializeForOwner( const Engine::ECS::World& world, const Engine::ECS::GameEntity& entity,
-                        NetLib::Buffer& buffer );
-void SerializeForNonOwner( const Engine::ECS::GameEntity& entity, NetLib::Buffer& buffer );
-void DeserializeForOwner( Engine::ECS::GameEntity& entity, NetLib::Buffer& buffer );
-void DeserializeForNonOwner( Engine::ECS::GameEntity& entity, NetLib::Buffer& buffer );
\ No newline at end of file
+                        NetLib::BitWriter& writer );
+void SerializeForNonOwner( const Engine::ECS::GameEntity& entity, NetLib::BitWriter& writer );
+void DeserializeForOwner( Engine::ECS::GameEntity& entity, NetLib::BitReader& reader );
+void DeserializeForNonOwner( Engine::ECS::GameEntity& entity, NetLib::BitReader& reader );
\ No newline at end of file
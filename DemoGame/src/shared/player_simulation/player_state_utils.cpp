@@ -9,7 +9,8 @@
 
 #include "shared/components/player_controller_component.h"
 
-#include "core/Buffer.h"
+#include "core/bit_writer.h"
+#include "core/bit_reader.h"
 
 namespace PlayerSimulation
 {
@@ -45,41 +46,47 @@ namespace PlayerSimulation
 		playerController.state = player_state;
 	}
 
-	void SerializePlayerStateToBuffer( const PlayerState& player_state, NetLib::Buffer& buffer )
+	// The owner compares this state against its own prediction, so floats are sent without quantization
+	void SerializePlayerState( const PlayerState& player_state, NetLib::BitWriter& writer )
 	{
-		buffer.WriteInteger( player_state.tick );
-		buffer.WriteFloat( player_state.position.X() );
-		buffer.WriteFloat( player_state.position.Y() );
+		writer.WriteInteger( player_state.tick );
+		writer.WriteFloat( player_state.position.X() );
+		writer.WriteFloat( player_state.position.Y() );
 
-		buffer.WriteFloat( player_state.rotationAngle );
-		buffer.WriteFloat( player_state.timeLeftUntilNextShot );
+		writer.WriteFloat( player_state.rotationAngle );
+		writer.WriteFloat( player_state.timeLeftUntilNextShot );
 
-		buffer.WriteFloat( player_state.movementDirection.X() );
-		buffer.WriteFloat( player_state.movementDirection.Y() );
+		writer.WriteFloat( player_state.movementDirection.X() );
+		writer.WriteFloat( player_state.movementDirection.Y() );
 
-		// TODO Serialize this in a more efficient way to fit multiple bools in one byte
-		buffer.WriteInteger( player_state.isWalking ? 1 : 0 );
-		buffer.WriteInteger( player_state.isAiming ? 1 : 0 );
+		writer.WriteBool( player_state.isWalking );
+		writer.WriteBool( player_state.isAiming );
 	}
 
-	PlayerState DeserializePlayerStateFromBuffer( NetLib::Buffer& buffer )
+	bool DeserializePlayerState( NetLib::BitReader& reader, PlayerState& player_state )
 	{
-		PlayerState playerState;
+		float32 positionX, positionY;
+		float32 movementDirectionX, movementDirectionY;
 
-		playerState.tick = buffer.ReadInteger();
-		playerState.position.X( buffer.ReadFloat() );
-		playerState.position.Y( buffer.ReadFloat() );
+		bool result = reader.ReadInteger( player_state.tick );
+		result = result && reader.ReadFloat( positionX );
+		result = result && reader.ReadFloat( positionY );
 
-		playerState.rotationAngle = buffer.ReadFloat();
-		playerState.timeLeftUntilNextShot = buffer.ReadFloat();
+		result = result && reader.ReadFloat( player_state.rotationAngle );
+		result = result && reader.ReadFloat( player_state.timeLeftUntilNextShot );
 
-		playerState.movementDirection.X( buffer.ReadFloat() );
-		playerState.movementDirection.Y( buffer.ReadFloat() );
+		result = result && reader.ReadFloat( movementDirectionX );
+		result = result && reader.ReadFloat( movementDirectionY );
 
-		// TODO Serialize this in a more efficient way to fit multiple bools in one byte
-		playerState.isWalking = buffer.ReadInteger() == 1 ? true : false;
-		playerState.isAiming = buffer.ReadInteger() == 1 ? true : false;
+		result = result && reader.ReadBool( player_state.isWalking );
+		result = result && reader.ReadBool( player_state.isAiming );
 
-		return playerState;
+		if ( result )
+		{
+			player_state.position = Vec2f( positionX, positionY );
+			player_state.movementDirection = Vec2f( movementDirectionX, movementDirectionY );
+		}
+
+		return result;
 	}
 } // namespace PlayerSimulation
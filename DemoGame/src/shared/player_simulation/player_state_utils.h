@@ -11,7 +11,8 @@ namespace Engine
 
 namespace NetLib
 {
-	class Buffer;
+	class BitWriter;
+	class BitReader;
 }
 
 namespace PlayerSimulation
@@ -21,6 +22,6 @@ namespace PlayerSimulation
 	PlayerState GetPlayerStateFromPlayerEntity( const Engine::ECS::GameEntity& player_entity, uint32 current_tick );
 	void ApplyPlayerStateToPlayerEntity( Engine::ECS::GameEntity& player_entity, const PlayerState& player_state );
 
-	void SerializePlayerStateToBuffer( const PlayerState& player_state, NetLib::Buffer& buffer );
-	PlayerState DeserializePlayerStateFromBuffer( NetLib::Buffer& buffer );
+	void SerializePlayerState( const PlayerState& player_state, NetLib::BitWriter& writer );
+	bool DeserializePlayerState( NetLib::BitReader& reader, PlayerState& player_state );
 }
\ No newline at end of file
@@ -3,6 +3,10 @@
 #include "ecs/game_entity.hpp"
 #include "ecs/world.h"
 
+#include "transform/transform_component.h"
+#include "transform/transform_hierarchy_helper_functions.h"
+
+#include "shared/components/network_entity_component.h"
 #include "shared/global_components/network_peer_global_component.h"
 
 PosTickNetworkSystem::PosTickNetworkSystem()
@@ -10,8 +14,30 @@ PosTickNetworkSystem::PosTickNetworkSystem()
 {
 }
 
+static void Server_UpdateNetworkEntityPositions( Engine::ECS::World& world, NetLib::Server& server )
+{
+	// The server uses them to decide which network entities are relevant to each remote peer
+	const std::vector< Engine::ECS::GameEntity > networkEntities = world.GetEntitiesOfType< NetworkEntityComponent >();
+	const Engine::TransformComponentProxy transformComponentProxy;
+
+	auto cit = networkEntities.cbegin();
+	for ( ; cit != networkEntities.cend(); ++cit )
+	{
+		const NetworkEntityComponent& networkEntityComponent = cit->GetComponent< NetworkEntityComponent >();
+		const Engine::TransformComponent& transform = cit->GetComponent< Engine::TransformComponent >();
+		const Vec2f position = transformComponentProxy.GetGlobalPosition( transform );
+		server.SetNetworkEntityPosition( networkEntityComponent.networkEntityId, position.X(), position.Y() );
+	}
+}
+
 void PosTickNetworkSystem::Execute( Engine::ECS::World& world, float32 elapsed_time )
 {
 	NetworkPeerGlobalComponent& networkPeerComponent = world.GetGlobalComponent< NetworkPeerGlobalComponent >();
+	if ( networkPeerComponent.peer->GetPeerType() == NetLib::PeerType::SERVER &&
+	     networkPeerComponent.peer->GetConnectionState() == NetLib::PeerConnectionState::Connected )
+	{
+		Server_UpdateNetworkEntityPositions( world, *networkPeerComponent.GetPeerAsServer() );
+	}
+
 	networkPeerComponent.peer->Tick( elapsed_time );
 }
@@ -2,6 +2,8 @@
 
 #include "logger.h"
 
+#include <cstring>
+
 namespace NetLib
 {
 	// Evaluate if supporting address creation from hostname such as hello.com. In order to do that you will need to use
@@ -46,7 +48,7 @@ namespace NetLib
 		const int32 iResult = inet_pton( _addressInfo.sin_family, _ip.c_str(), &_addressInfo.sin_addr );
 		if ( iResult == -1 )
 		{
-			LOG_ERROR( "Error at converting IP string into address. Error code: %d", WSAGetLastError() );
+			LOG_ERROR( "Error at converting IP string into address. Error code: %d", GetLastSocketError() );
 		}
 		else if ( iResult == 0 )
 		{
@@ -70,7 +72,7 @@ namespace NetLib
 		{
 			const uint32 IP_MAX_SIZE = 256;
 			char clientIp[ IP_MAX_SIZE ];
-			ZeroMemory( clientIp, IP_MAX_SIZE );
+			std::memset( clientIp, 0, IP_MAX_SIZE );
 			inet_ntop( _addressInfo.sin_family, &_addressInfo.sin_addr, clientIp, IP_MAX_SIZE );
 			std::string ipString( clientIp );
 			_ip.assign( clientIp );
@@ -1,14 +1,14 @@
 #pragma once
 #include "numeric_types.h"
 
-#include <winsock2.h>
-#include <ws2tcpip.h>
+#include "core/socket_platform.h"
+
 #include <string>
 
 namespace NetLib
 {
-	constexpr char* IPV4_ANY = "0.0.0.0";
-	constexpr char* IPV4_LOOPBACK = "127.0.0.1";
+	constexpr const char* IPV4_ANY = "0.0.0.0";
+	constexpr const char* IPV4_LOOPBACK = "127.0.0.1";
 
 	enum class IPVersion
 	{
@@ -44,7 +44,7 @@ namespace NetLib
 			IPVersion _ipVersion;
 			uint32 _port;
 
-			// Cache adress info into winsocks struct for better performance
+			// Cache adress info into sockets struct for better performance
 			struct sockaddr_in _addressInfo;
 
 			friend class Socket;
@@ -7,6 +7,7 @@
 
 #include "core/remote_peer.h"
 #include "core/time_clock.h"
+#include "core/buffer.h"
 
 #include "inputs/i_input_state.h"
 
@@ -17,7 +18,7 @@
 namespace NetLib
 {
 	Client::Client( float32 serverMaxInactivityTimeout )
-	    : Peer( PeerType::CLIENT, 1, 1024, 1024 )
+	    : Peer( PeerType::CLIENT, 1, MTU_SIZE_BYTES, MTU_SIZE_BYTES )
 	    , _serverAddress( "127.0.0.1", 54000 )
 	    , inGameMessageID( 0 )
 	    , _replicationMessagesProcessor()
@@ -45,12 +46,10 @@ namespace NetLib
 		message->SetReliability( false );
 		std::unique_ptr< InputStateMessage > inputsMessage( static_cast< InputStateMessage* >( message.release() ) );
 
-		int32 dataSize = inputState.GetSize();
-		uint8* data = new uint8[ dataSize ];
+		const uint16 dataSize = static_cast< uint16 >( inputState.GetSize() );
+		uint8* data = inputsMessage->AllocateData( dataSize );
 		Buffer inputDataBuffer( data, dataSize );
 		inputState.Serialize( inputDataBuffer );
-		inputsMessage->dataSize = dataSize;
-		inputsMessage->data = data;
 
 		serverPeer->AddMessage( std::move( inputsMessage ) );
 
@@ -136,6 +135,7 @@ namespace NetLib
 			else
 			{
 				_timeSyncer.Update( elapsedTime, *serverRemotePeer, _messageFactory );
+				SendReplicationAcks( *serverRemotePeer );
 			}
 		}
 	}
@@ -192,6 +192,25 @@ namespace NetLib
 		_replicationMessagesProcessor.Client_ProcessReceivedReplicationMessage( message );
 	}
 
+	void Client::SendReplicationAcks( RemotePeer& server_remote_peer )
+	{
+		auto send_ack = [ this, &server_remote_peer ]( uint16 snapshot_sequence_number,
+		                                               uint16 number_of_updates_received )
+		{
+			std::unique_ptr< Message > message = _messageFactory.LendMessage( MessageType::ReplicationAck );
+			message->SetOrdered( false );
+			message->SetReliability( false );
+
+			std::unique_ptr< ReplicationAckMessage > ackMessage(
+			    static_cast< ReplicationAckMessage* >( message.release() ) );
+			ackMessage->snapshotSequenceNumber = snapshot_sequence_number;
+			ackMessage->numberOfUpdatesReceived = number_of_updates_received;
+			server_remote_peer.AddMessage( std::move( ackMessage ) );
+		};
+
+		_replicationMessagesProcessor.Client_ConsumePendingSnapshotAcks( send_ack );
+	}
+
 	void Client::OnServerDisconnect()
 	{
 		LOG_INFO( "ON SERVER DISCONNECT" );
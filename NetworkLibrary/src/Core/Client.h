@@ -56,6 +56,7 @@ namespace NetLib
 			void ProcessDisconnection( const DisconnectionMessage& message, RemotePeer& remotePeer );
 			void ProcessTimeResponse( const TimeResponseMessage& message );
 			void ProcessReplicationAction( const ReplicationMessage& message );
+			void SendReplicationAcks( RemotePeer& server_remote_peer );
 
 			void OnServerDisconnect();
 
@@ -42,6 +42,7 @@ namespace NetLib
 		connectionConfiguration.canStartConnections = ( _type == PeerType::CLIENT );
 		connectionConfiguration.connectionTimeoutSeconds = 5.f;
 		connectionConfiguration.sendDenialOnTimeout = ( _type == PeerType::SERVER );
+		connectionConfiguration.maxAckWindowSize = MAX_ACK_WINDOW_SIZE;
 		if ( _type == PeerType::CLIENT )
 		{
 			connectionConfiguration.connectionPipeline = new Connection::ClientConnectionPipeline();
@@ -65,6 +66,17 @@ namespace NetLib
 			return false;
 		}
 
+		_socketMetricsHandler.StartUp(
+		    1.f, Metrics::MetricsEnableConfig::CUSTOM,
+		    { Metrics::MetricType::RECEIVE_BATCH_SIZE, Metrics::MetricType::SEND_BATCH_SIZE } );
+
+		// The socket is bound at this point so it can be read from another thread. Socket shards always use it
+		const bool useReceiveThread = _isReceiveThreadEnabled || !_shardSockets.empty();
+		if ( useReceiveThread && !_receiveThread.Start( _socket ) )
+		{
+			LOG_WARNING( "Error while starting the receive thread. The socket will be read from the game thread" );
+		}
+
 		_currentTick = 1;
 		LOG_INFO( "Peer started succesfully" );
 		return true;
@@ -92,6 +104,7 @@ namespace NetLib
 			return false;
 		}
 
+		_socketMetricsHandler.Update( elapsedTime );
 		TickPendingConnections( elapsedTime );
 		TickRemotePeers( elapsedTime );
 		TickConcrete( elapsedTime );
@@ -150,6 +163,18 @@ namespace NetLib
 		return result;
 	}
 
+	uint32 Peer::GetSocketMetric( Metrics::MetricType metric_type, Metrics::ValueType value_type ) const
+	{
+		uint32 result = 0;
+		if ( _connectionState != PeerConnectionState::Disconnected &&
+		     _socketMetricsHandler.HasMetric( metric_type ) )
+		{
+			result = _socketMetricsHandler.GetValue( metric_type, value_type );
+		}
+
+		return result;
+	}
+
 	float64 Peer::GetLocalTime() const
 	{
 		// TODO Make the time clock class not be a singleton and be a peer class variable. You will need probably a
@@ -176,8 +201,6 @@ namespace NetLib
 
 	Peer::~Peer()
 	{
-		delete[] _receiveBuffer;
-		delete[] _sendBuffer;
 	}
 
 	Peer::Peer( PeerType type, uint32 maxConnections, uint32 receiveBufferSize, uint32 sendBufferSize )
@@ -186,7 +209,16 @@ namespace NetLib
 	    , _socket()
 	    , _address( Address::GetInvalid() )
 	    , _receiveBufferSize( receiveBufferSize )
+	    , _receiveBatch( RECEIVE_BATCH_CAPACITY, receiveBufferSize )
+	    , _isReceiveThreadEnabled( false )
+	    , _receiveThread( RECEIVE_THREAD_QUEUE_CAPACITY, RECEIVE_BATCH_CAPACITY, receiveBufferSize )
+	    , _numberOfSocketShards( 1 )
+	    , _shardSockets()
+	    , _shardReceiveThreads()
+	    , _shardSendQueues()
 	    , _sendBufferSize( sendBufferSize )
+	    , _sendQueue( _socket, SEND_QUEUE_CAPACITY, sendBufferSize )
+	    , _socketMetricsHandler()
 	    , _remotePeersHandler()
 	    , _onLocalPeerConnect()
 	    , _onLocalPeerDisconnect()
@@ -197,17 +229,22 @@ namespace NetLib
 	    , _messageFactory( 3 )
 	    , _connectionManager()
 	{
-		_receiveBuffer = new uint8[ _receiveBufferSize ];
-		_sendBuffer = new uint8[ _sendBufferSize ];
 		_remotePeersHandler.Initialize( maxConnections, &_messageFactory );
+		_sendQueue.SetMetricsHandler( &_socketMetricsHandler );
 	}
 
-	void Peer::SendPacketToAddress( const NetworkPacket& packet, const Address& address ) const
+	void Peer::SendPacketToAddress( const NetworkPacket& packet, const Address& address )
 	{
-		Buffer buffer = Buffer( _sendBuffer, packet.Size() );
-		packet.Write( buffer );
+		const uint32 packetSize = packet.Size();
+		uint8* bufferData = _sendQueue.AcquireDatagramBuffer( packetSize );
+		if ( bufferData == nullptr )
+		{
+			return;
+		}
 
-		_socket.SendTo( _sendBuffer, packet.Size(), address );
+		Buffer buffer = Buffer( bufferData, packetSize );
+		packet.Write( buffer );
+		_sendQueue.CommitDatagram( packetSize, address );
 	}
 
 	bool Peer::AddRemotePeer( const Address& addressInfo, uint16 id, uint64 clientSalt, uint64 serverSalt )
@@ -215,17 +252,94 @@ namespace NetLib
 		return _remotePeersHandler.AddRemotePeer( addressInfo, id, clientSalt, serverSalt );
 	}
 
-	bool Peer::BindSocket( const Address& address ) const
+	void Peer::SetNumberOfSocketShards( uint32 number_of_shards )
+	{
+		if ( number_of_shards == 0 )
+		{
+			LOG_WARNING( "The number of socket shards must be greater than zero. Using 1" );
+			number_of_shards = 1;
+		}
+
+		_numberOfSocketShards = number_of_shards;
+	}
+
+	bool Peer::BindSocket( const Address& address )
 	{
+		bool useSocketShards = ( _numberOfSocketShards > 1 );
+		if ( useSocketShards && _type != PeerType::SERVER )
+		{
+			LOG_WARNING( "Socket shards are only supported by servers. Using a single socket" );
+			useSocketShards = false;
+		}
+
+		if ( useSocketShards && _socket.EnableReusePort() != SocketResult::SOKT_SUCCESS )
+		{
+			LOG_WARNING( "Error while enabling socket shards. Using a single socket" );
+			useSocketShards = false;
+		}
+
 		SocketResult result = _socket.Bind( address );
 		if ( result != SocketResult::SOKT_SUCCESS )
 		{
 			return false;
 		}
 
+		if ( useSocketShards && !StartSocketShards( address ) )
+		{
+			LOG_WARNING( "Error while starting socket shards. Using a single socket" );
+			StopSocketShards();
+		}
+
 		return true;
 	}
 
+	bool Peer::StartSocketShards( const Address& address )
+	{
+		for ( uint32 i = 1; i < _numberOfSocketShards; ++i )
+		{
+			std::unique_ptr< Socket > socket = std::make_unique< Socket >();
+			if ( socket->Start() != SocketResult::SOKT_SUCCESS ||
+			     socket->EnableReusePort() != SocketResult::SOKT_SUCCESS ||
+			     socket->Bind( address ) != SocketResult::SOKT_SUCCESS )
+			{
+				return false;
+			}
+
+			std::unique_ptr< ReceiveThread > receiveThread = std::make_unique< ReceiveThread >(
+			    RECEIVE_THREAD_QUEUE_CAPACITY, RECEIVE_BATCH_CAPACITY, _receiveBufferSize );
+			if ( !receiveThread->Start( *socket ) )
+			{
+				return false;
+			}
+
+			// Remote peers whose traffic arrives on this socket are sent through it too
+			std::unique_ptr< DatagramSendQueue > sendQueue =
+			    std::make_unique< DatagramSendQueue >( *socket, SEND_QUEUE_CAPACITY, _sendBufferSize );
+			sendQueue->SetMetricsHandler( &_socketMetricsHandler );
+
+			_shardSockets.push_back( std::move( socket ) );
+			_shardReceiveThreads.push_back( std::move( receiveThread ) );
+			_shardSendQueues.push_back( std::move( sendQueue ) );
+		}
+
+		LOG_INFO( "Started %u socket shards", _numberOfSocketShards );
+		return true;
+	}
+
+	void Peer::StopSocketShards()
+	{
+		// Threads and send queues go first as they must not be using their socket once it is closed
+		_shardReceiveThreads.clear();
+		_shardSendQueues.clear();
+
+		for ( auto it = _shardSockets.begin(); it != _shardSockets.end(); ++it )
+		{
+			( *it )->Close();
+		}
+
+		_shardSockets.clear();
+	}
+
 	void Peer::DisconnectAllRemotePeers( bool shouldNotify, Connection::ConnectionFailedReasonType reason )
 	{
 		if ( shouldNotify )
@@ -306,20 +420,51 @@ namespace NetLib
 
 	void Peer::ReadReceivedData()
 	{
-		Address remoteAddress = Address::GetInvalid();
-		uint32 numberOfBytesRead = 0;
+		// The main socket is shard 0
+		for ( uint32 i = 0; i < _shardReceiveThreads.size(); ++i )
+		{
+			ReadReceivedDataFromQueue( _shardReceiveThreads[ i ]->GetQueue(), i + 1 );
+		}
+
+		if ( _receiveThread.IsRunning() )
+		{
+			ReadReceivedDataFromQueue( _receiveThread.GetQueue(), 0 );
+			return;
+		}
+
+		// Non-blocking readiness check. If there is nothing pending in the socket avoid calling recvfrom at all, which
+		// would just fail with a would-block error
+		if ( _socket.WaitForIncomingData( 0 ) != SocketResult::SOKT_SUCCESS )
+		{
+			return;
+		}
+
+		Address resetRemoteAddress = Address::GetInvalid();
 		bool arePendingDatagramsToRead = true;
 
 		do
 		{
-			SocketResult result =
-			    _socket.ReceiveFrom( _receiveBuffer, _receiveBufferSize, remoteAddress, numberOfBytesRead );
+			_receiveBatch.Clear();
+			const SocketResult result = _socket.ReceiveBatchFrom( _receiveBatch, resetRemoteAddress );
+
+			// Process whatever was read, even if the batch stopped early due to an error
+			const uint32 numberOfDatagrams = _receiveBatch.GetCount();
+			for ( uint32 i = 0; i < numberOfDatagrams; ++i )
+			{
+				Buffer buffer = Buffer( _receiveBatch.GetDatagramData( i ), _receiveBatch.GetDatagramSize( i ) );
+				ReadDatagram( buffer, _receiveBatch.GetDatagramAddress( i ), 0 );
+			}
+
+			if ( numberOfDatagrams > 0 &&
+			     _socketMetricsHandler.HasMetric( Metrics::MetricType::RECEIVE_BATCH_SIZE ) )
+			{
+				_socketMetricsHandler.AddValue( Metrics::MetricType::RECEIVE_BATCH_SIZE, numberOfDatagrams );
+			}
 
 			if ( result == SocketResult::SOKT_SUCCESS )
 			{
-				// Data read succesfully. Keep going!
-				Buffer buffer = Buffer( _receiveBuffer, numberOfBytesRead );
-				ReadDatagram( buffer, remoteAddress );
+				// A partially filled batch means that the socket has been drained
+				arePendingDatagramsToRead = _receiveBatch.IsFull();
 			}
 			else if ( result == SocketResult::SOKT_ERR || result == SocketResult::SOKT_WOULDBLOCK )
 			{
@@ -329,17 +474,52 @@ namespace NetLib
 			else if ( result == SocketResult::SOKT_CONNRESET )
 			{
 				// The remote socket got closed unexpectedly
-				RemotePeer* remotePeer = _remotePeersHandler.GetRemotePeerFromAddress( remoteAddress );
-				if ( remotePeer != nullptr )
-				{
-					StartDisconnectingRemotePeer( remotePeer->GetClientIndex(), false,
-					                              Connection::ConnectionFailedReasonType::UNKNOWN );
-				}
+				OnRemoteSocketReset( resetRemoteAddress );
 			}
 		} while ( arePendingDatagramsToRead );
 	}
 
-	void Peer::ReadDatagram( Buffer& buffer, const Address& address )
+	void Peer::ReadReceivedDataFromQueue( DatagramReceiveQueue& queue, uint32 socket_shard_index )
+	{
+		// Only drain what is already queued so a flood of packets can't keep the game thread here forever
+		const uint32 maxNumberOfDatagrams = queue.GetCapacity();
+		uint32 numberOfDatagrams = 0;
+		ReceivedDatagram datagram;
+		while ( numberOfDatagrams < maxNumberOfDatagrams && queue.TryPeek( datagram ) )
+		{
+			if ( datagram.isConnectionReset )
+			{
+				OnRemoteSocketReset( *datagram.address );
+			}
+			else
+			{
+				Buffer buffer = Buffer( datagram.data, datagram.size );
+				ReadDatagram( buffer, *datagram.address, socket_shard_index );
+			}
+
+			queue.Pop();
+			++numberOfDatagrams;
+		}
+
+		const uint32 numberOfDroppedDatagrams = queue.ConsumeNumberOfDroppedDatagrams();
+		if ( numberOfDroppedDatagrams > 0 )
+		{
+			LOG_WARNING( "The receive thread queue got full. %u datagrams have been dropped",
+			             numberOfDroppedDatagrams );
+		}
+	}
+
+	void Peer::OnRemoteSocketReset( const Address& address )
+	{
+		RemotePeer* remotePeer = _remotePeersHandler.GetRemotePeerFromAddress( address );
+		if ( remotePeer != nullptr )
+		{
+			StartDisconnectingRemotePeer( remotePeer->GetClientIndex(), false,
+			                              Connection::ConnectionFailedReasonType::UNKNOWN );
+		}
+	}
+
+	void Peer::ReadDatagram( Buffer& buffer, const Address& address, uint32 socket_shard_index )
 	{
 		// TODO Add validation for tampered or corrupted packets so it doesn't crash when a tampered message arrives.
 		//  Read incoming packet
@@ -355,13 +535,13 @@ namespace NetLib
 		}
 
 		// Store messages within transmission channels for being processed
-		StoreReceivedMessages( packet, address );
+		StoreReceivedMessages( packet, address, socket_shard_index );
 
 		// Clean up packet
 		NetworkPacketUtils::CleanPacket( _messageFactory, packet );
 	}
 
-	void Peer::StoreReceivedMessages( NetworkPacket& packet, const Address& address )
+	void Peer::StoreReceivedMessages( NetworkPacket& packet, const Address& address, uint32 socket_shard_index )
 	{
 		bool processedSuccessfully = false;
 
@@ -369,6 +549,7 @@ namespace NetLib
 		bool isPacketFromRemotePeer = ( remotePeer != nullptr );
 		if ( isPacketFromRemotePeer )
 		{
+			remotePeer->SetSocketShardIndex( socket_shard_index );
 			remotePeer->ProcessPacket( packet );
 		}
 		else
@@ -407,13 +588,14 @@ namespace NetLib
 		std::vector< Connection::SuccessConnectionData > successfulConnections;
 		_connectionManager.GetSuccessConnectionsData( successfulConnections );
 
-		for ( auto& cit = successfulConnections.cbegin(); cit != successfulConnections.cend(); ++cit )
+		for ( auto cit = successfulConnections.cbegin(); cit != successfulConnections.cend(); ++cit )
 		{
 			// TODO Change this and get rid of both salts in remote peer. Just keep the data prefix
 			if ( AddRemotePeer( cit->address, cit->id, cit->dataPrefix, 0 ) )
 			{
 				RemotePeer* remotePeer = _remotePeersHandler.GetRemotePeerFromId( cit->id );
 				ASSERT( remotePeer != nullptr, "Remote peer cannot be nullptr after its creation" );
+				remotePeer->SetAckWindowSize( cit->ackWindowSize );
 				OnPendingConnectionAccepted( *cit );
 				ExecuteOnRemotePeerConnect( cit->id );
 			}
@@ -431,7 +613,7 @@ namespace NetLib
 		std::vector< Connection::FailedConnectionData > deniedConnections;
 		_connectionManager.GetFailedConnectionsData( deniedConnections );
 
-		for ( auto& cit = deniedConnections.cbegin(); cit != deniedConnections.cend(); ++cit )
+		for ( auto cit = deniedConnections.cbegin(); cit != deniedConnections.cend(); ++cit )
 		{
 			OnPendingConnectionDenied( *cit );
 		}
@@ -465,13 +647,24 @@ namespace NetLib
 
 		for ( ; validRemotePeersIt != pastTheEndIt; ++validRemotePeersIt )
 		{
-			( *validRemotePeersIt )->SendData( _socket );
+			// Each remote peer is sent through the socket shard its traffic arrives on. The main socket is shard 0
+			const uint32 socketShardIndex = ( *validRemotePeersIt )->GetSocketShardIndex();
+			DatagramSendQueue& sendQueue =
+			    ( socketShardIndex == 0 ) ? _sendQueue : *_shardSendQueues[ socketShardIndex - 1 ];
+			( *validRemotePeersIt )->SendData( sendQueue );
+		}
+
+		// Send everything queued during this tick, including pending connections data, at once
+		_sendQueue.Flush();
+		for ( auto it = _shardSendQueues.begin(); it != _shardSendQueues.end(); ++it )
+		{
+			( *it )->Flush();
 		}
 	}
 
 	void Peer::SendDataToPendingConnections()
 	{
-		_connectionManager.SendData( _socket );
+		_connectionManager.SendData( _sendQueue );
 	}
 
 	void Peer::StartDisconnectingRemotePeer( uint32 id, bool shouldNotify,
@@ -561,8 +754,14 @@ namespace NetLib
 
 		StopConcrete();
 		DisconnectAllRemotePeers( _stopRequestShouldNotifyRemotePeers, _stopRequestReason );
+		// Make sure disconnection messages go out before closing the socket
+		_sendQueue.Flush();
+		// The receive thread must not be waiting on the socket once it is closed
+		_receiveThread.Stop();
+		StopSocketShards();
 		_socket.Close();
 		_connectionManager.ShutDown();
+		_socketMetricsHandler.ShutDown();
 
 		_isStopRequested = false;
 
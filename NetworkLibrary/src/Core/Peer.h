@@ -4,11 +4,15 @@
 #include <vector>
 #include <list>
 #include <string>
+#include <memory>
 
 #include "delegate.hpp"
 
 #include "core/address.h"
 #include "core/socket.h"
+#include "core/datagram_batch.h"
+#include "core/datagram_send_queue.h"
+#include "core/receive_thread.h"
 #include "core/remote_peers_handler.h"
 
 #include "communication/message_factory.h"
@@ -18,6 +22,8 @@
 
 #include "transmission_channels/transmission_channel.h"
 
+#include "metrics/metrics_handler.h"
+
 class Buffer;
 
 namespace NetLib
@@ -33,6 +39,13 @@ namespace NetLib
 		struct FailedConnectionData;
 	}
 
+	// Max number of datagrams read from the socket per batched receive call
+	constexpr uint32 RECEIVE_BATCH_CAPACITY = 32;
+	// Max number of datagrams queued during a tick before the send queue gets flushed automatically
+	constexpr uint32 SEND_QUEUE_CAPACITY = 64;
+	// Max number of datagrams the receive thread can hold until the game thread drains them. Must be a power of two
+	constexpr uint32 RECEIVE_THREAD_QUEUE_CAPACITY = 1024;
+
 	struct RemotePeerDisconnectionData
 	{
 			uint32 id;
@@ -70,6 +83,24 @@ namespace NetLib
 			/// <param name="port">The port to listen at. For client = 0. For server = a non-zero port</param>
 			/// <returns></returns>
 			bool Start( const std::string& ip, uint32 port );
+
+			/// <summary>
+			/// Enables or disables reading the socket from a dedicated receive thread. Received datagrams are queued
+			/// by that thread and PreTick only drains the queue. It must be called before Start, otherwise it will
+			/// take effect the next time the peer is started.
+			/// </summary>
+			void SetReceiveThreadEnabled( bool enabled ) { _isReceiveThreadEnabled = enabled; }
+			bool IsReceiveThreadEnabled() const { return _isReceiveThreadEnabled; }
+
+			/// <summary>
+			/// Sets the number of sockets a server binds to its port with SO_REUSEPORT. The OS spreads remote peers
+			/// among them. Each socket is read by its own receive thread and the data of the remote peers whose traffic
+			/// arrives on it is sent through it, while decoding, simulation and serialization stay on the game thread.
+			/// A value of 1 disables sharding. It must be called before Start and it is ignored by clients and on
+			/// platforms without SO_REUSEPORT.
+			/// </summary>
+			void SetNumberOfSocketShards( uint32 number_of_shards );
+			uint32 GetNumberOfSocketShards() const { return _numberOfSocketShards; }
 			bool PreTick();
 			bool Tick( float32 elapsedTime );
 			bool Stop();
@@ -95,6 +126,12 @@ namespace NetLib
 			uint32 GetMetric( uint32 remote_peer_id, Metrics::MetricType metric_type,
 			                  Metrics::ValueType value_type ) const;
 
+			/// <summary>
+			/// Get the metric value from the local peer socket level metrics, such as the receive and send batch
+			/// sizes. If the peer is not started or the metric is not found, a value of 0 is returned.
+			/// </summary>
+			uint32 GetSocketMetric( Metrics::MetricType metric_type, Metrics::ValueType value_type ) const;
+
 			float64 GetLocalTime() const;
 			float64 GetServerTime() const;
 
@@ -130,9 +167,17 @@ namespace NetLib
 			virtual void TickConcrete( float32 elapsedTime ) = 0;
 			virtual bool StopConcrete() = 0;
 
-			void SendPacketToAddress( const NetworkPacket& packet, const Address& address ) const;
+			/// <summary>
+			/// Serializes the packet into the send queue. It will be sent at the end of the tick along with the rest of
+			/// outgoing data
+			/// </summary>
+			void SendPacketToAddress( const NetworkPacket& packet, const Address& address );
 			bool AddRemotePeer( const Address& addressInfo, uint16 id, uint64 clientSalt, uint64 serverSalt );
-			bool BindSocket( const Address& address ) const;
+			/// <summary>
+			/// Binds the socket to the address. If socket sharding is enabled, it also binds the rest of shard sockets
+			/// to the same address.
+			/// </summary>
+			bool BindSocket( const Address& address );
 
 			void StartDisconnectingRemotePeer( uint32 id, bool shouldNotify,
 			                                   Connection::ConnectionFailedReasonType reason );
@@ -158,19 +203,38 @@ namespace NetLib
 
 		private:
 			/// <summary>
-			/// Reads all the incoming received data from the socket
+			/// Reads all the incoming received data from the socket in batches of up to RECEIVE_BATCH_CAPACITY
+			/// datagrams
 			/// </summary>
 			void ReadReceivedData();
 
 			/// <summary>
-			/// Reads an incoming datagram received from the specified address
+			/// Reads all the datagrams queued by a receive thread since the last call
+			/// </summary>
+			void ReadReceivedDataFromQueue( DatagramReceiveQueue& queue, uint32 socket_shard_index );
+
+			/// <summary>
+			/// Creates and binds the sockets, besides the main one, of every socket shard and starts their receive
+			/// threads. The main socket must already be bound to the address with SO_REUSEPORT enabled.
+			/// </summary>
+			bool StartSocketShards( const Address& address );
+			void StopSocketShards();
+
+			/// <summary>
+			/// Starts disconnecting the remote peer at the specified address, if any, after its socket got closed
+			/// unexpectedly
+			/// </summary>
+			void OnRemoteSocketReset( const Address& address );
+
+			/// <summary>
+			/// Reads an incoming datagram received from the specified address through the socket of the shard
 			/// </summary>
-			void ReadDatagram( Buffer& buffer, const Address& address );
+			void ReadDatagram( Buffer& buffer, const Address& address, uint32 socket_shard_index );
 
 			/// <summary>
 			/// Stores all the messages from a network packet into the corresponding transmission channels
 			/// </summary>
-			void StoreReceivedMessages( NetworkPacket& packet, const Address& address );
+			void StoreReceivedMessages( NetworkPacket& packet, const Address& address, uint32 socket_shard_index );
 
 			/// <summary>
 			/// Process all the pending received data from all the remote peers
@@ -193,7 +257,8 @@ namespace NetLib
 			                                Connection::ConnectionFailedReasonType reason );
 
 			/// <summary>
-			/// Sends pending data to all the connected remote peers
+			/// Sends pending data to all the connected remote peers. The data from pending connections and remote
+			/// peers is gathered in the send queue and flushed here with a single batched socket call
 			/// </summary>
 			void SendDataToRemotePeers();
 			void SendDataToPendingConnections();
@@ -213,9 +278,22 @@ namespace NetLib
 			Socket _socket;
 
 			const uint32 _receiveBufferSize;
-			uint8* _receiveBuffer;
+			DatagramBatch _receiveBatch;
+			bool _isReceiveThreadEnabled;
+			ReceiveThread _receiveThread;
+
+			// The main socket is the first shard. These are the rest of them, each one with its own receive thread and
+			// its own send queue
+			uint32 _numberOfSocketShards;
+			std::vector< std::unique_ptr< Socket > > _shardSockets;
+			std::vector< std::unique_ptr< ReceiveThread > > _shardReceiveThreads;
+			std::vector< std::unique_ptr< DatagramSendQueue > > _shardSendQueues;
 			const uint32 _sendBufferSize;
-			uint8* _sendBuffer;
+			// Per tick send arena. Outgoing packets are serialized straight into it
+			DatagramSendQueue _sendQueue;
+
+			// Socket level metrics such as batch sizes. Remote peer metrics live in each remote peer
+			Metrics::MetricsHandler _socketMetricsHandler;
 
 			uint32 _currentTick;
 
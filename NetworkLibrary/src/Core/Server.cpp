@@ -7,6 +7,7 @@
 #include "asserts.h"
 
 #include "core/time_clock.h"
+#include "core/buffer.h"
 
 #include "inputs/i_input_state.h"
 #include "inputs/i_input_state_factory.h"
@@ -23,7 +24,7 @@
 namespace NetLib
 {
 	Server::Server( int32 maxConnections )
-	    : Peer( PeerType::SERVER, maxConnections, 1024, 1024 )
+	    : Peer( PeerType::SERVER, maxConnections, MTU_SIZE_BYTES, MTU_SIZE_BYTES )
 	    , _remotePeerInputsHandler()
 	    , _replicationManager()
 	{
@@ -43,7 +44,7 @@ namespace NetLib
 			return false;
 		}
 
-		_replicationManager.CreateNetworkEntity( _messageFactory, entityType, controlledByPeerId, posX, posY );
+		_replicationManager.CreateNetworkEntity( entityType, controlledByPeerId, posX, posY );
 		return true;
 	}
 
@@ -56,7 +57,27 @@ namespace NetLib
 			return;
 		}
 
-		_replicationManager.RemoveNetworkEntity( _messageFactory, entityId );
+		_replicationManager.RemoveNetworkEntity( entityId );
+	}
+
+	bool Server::SetNetworkEntityPosition( uint32 entityId, float32 posX, float32 posY )
+	{
+		return _replicationManager.SetNetworkEntityPosition( entityId, posX, posY );
+	}
+
+	void Server::SetInterestManager( IInterestManager* interestManager )
+	{
+		_replicationManager.SetInterestManager( interestManager );
+	}
+
+	void Server::SetEntityPriorityFunction( const EntityPriorityFunction& priorityFunction )
+	{
+		_replicationManager.SetEntityPriorityFunction( priorityFunction );
+	}
+
+	void Server::SetMaxReplicationBytesPerTick( uint32 maxBytes )
+	{
+		_replicationManager.SetMaxReplicationBytesPerTick( maxBytes );
 	}
 
 	void Server::RegisterInputStateFactory( IInputStateFactory* factory )
@@ -133,6 +154,15 @@ namespace NetLib
 					ProcessInputs( inputsMessage, remotePeer );
 					break;
 				}
+			case MessageType::ReplicationAck:
+				{
+					const ReplicationAckMessage& replicationAckMessage =
+					    static_cast< const ReplicationAckMessage& >( message );
+					_replicationManager.Server_ProcessReplicationAck( remotePeer.GetClientIndex(),
+					                                                  replicationAckMessage.snapshotSequenceNumber,
+					                                                  replicationAckMessage.numberOfUpdatesReceived );
+					break;
+				}
 			case MessageType::PingPong:
 				{
 					break;
@@ -247,12 +277,12 @@ namespace NetLib
 			}
 		}
 
-		_replicationManager.ClearReplicationMessages( _messageFactory );
+		_replicationManager.Server_IncrementSnapshotSequenceNumber();
 	}
 
 	void Server::RemoveReplicationEntitiesControlledByPeer( uint32 id )
 	{
-		_replicationManager.RemoveNetworkEntitiesControllerByPeer( _messageFactory, id );
+		_replicationManager.RemoveNetworkEntitiesControllerByPeer( id );
 	}
 
 	bool Server::StopConcrete()
@@ -272,5 +302,6 @@ namespace NetLib
 	void Server::InternalOnRemotePeerDisconnect( const RemotePeer& remote_peer )
 	{
 		_remotePeerInputsHandler.RemoveInputsBuffer( remote_peer.GetClientIndex() );
+		_replicationManager.Server_RemoveRemotePeer( remote_peer.GetClientIndex() );
 	}
 } // namespace NetLib
@@ -32,6 +32,24 @@ namespace NetLib
 			void DestroyNetworkEntity( uint32 entityId );
 			// TODO Create a method for destroying all network entities controlled by a remote peer
 
+			/// <summary>
+			/// Updates the position used to decide which remote peers a network entity is relevant to.
+			/// </summary>
+			bool SetNetworkEntityPosition( uint32 entityId, float32 posX, float32 posY );
+
+			/// <summary>
+			/// Sets the interest manager that decides which network entities are replicated to each remote peer. The
+			/// server doesn't take ownership of it. Pass nullptr to use the default grid based one.
+			/// </summary>
+			void SetInterestManager( IInterestManager* interestManager );
+
+			/// <summary>
+			/// Sets the function that decides which entity updates are sent first when they don't fit in the
+			/// replication budget. Pass nullptr to use the default one.
+			/// </summary>
+			void SetEntityPriorityFunction( const EntityPriorityFunction& priorityFunction );
+			void SetMaxReplicationBytesPerTick( uint32 maxBytes );
+
 			void RegisterInputStateFactory( IInputStateFactory* factory );
 			const IInputState* GetInputFromRemotePeer( uint32 remotePeerId );
 			const IInputState* GetLastInputPoppedFromRemotePeer( uint32 remote_peer_id ) const;
@@ -1,13 +1,17 @@
 #include "socket.h"
 
-#include "core/address.h"
+// Windows (winsock2) backend. The Linux backend lives in socket_linux.cpp
+#if defined( _WIN32 )
 
-#include "logger.h"
+	#include "core/address.h"
+	#include "core/datagram_batch.h"
+
+	#include "logger.h"
 
 namespace NetLib
 {
 	Socket::Socket()
-	    : _listenSocket( INVALID_SOCKET )
+	    : _listenSocket( INVALID_SOCKET_HANDLE )
 	{
 	}
 
@@ -28,12 +32,12 @@ namespace NetLib
 
 	int32 Socket::GetLastError() const
 	{
-		return WSAGetLastError();
+		return GetLastSocketError();
 	}
 
 	bool Socket::IsValid() const
 	{
-		return !( _listenSocket == INVALID_SOCKET );
+		return !( _listenSocket == INVALID_SOCKET_HANDLE );
 	}
 
 	SocketResult Socket::SetBlockingMode( bool status )
@@ -86,6 +90,13 @@ namespace NetLib
 		return SocketResult::SOKT_SUCCESS;
 	}
 
+	SocketResult Socket::EnableReusePort()
+	{
+		// SO_REUSEADDR on Windows lets sockets steal each other's port instead of load balancing between them
+		LOG_WARNING( "Socket error. SO_REUSEPORT is not supported on Windows" );
+		return SocketResult::SOKT_ERR;
+	}
+
 	SocketResult Socket::Close()
 	{
 		if ( !IsValid() )
@@ -107,7 +118,7 @@ namespace NetLib
 			return SocketResult::SOKT_ERR;
 		}
 
-		_listenSocket = INVALID_SOCKET;
+		_listenSocket = INVALID_SOCKET_HANDLE;
 
 		LOG_INFO( "Socket succesfully closed" );
 		return SocketResult::SOKT_SUCCESS;
@@ -223,8 +234,101 @@ namespace NetLib
 		return SocketResult::SOKT_SUCCESS;
 	}
 
+	SocketResult Socket::ReceiveBatchFrom( DatagramBatch& batch, Address& resetRemoteAddress ) const
+	{
+		if ( !IsValid() )
+		{
+			return SocketResult::SOKT_ERR;
+		}
+
+		// Winsock doesn't have a batched receive call so read datagram by datagram until the batch is full or there
+		// is nothing left to read
+		SocketResult result = SocketResult::SOKT_WOULDBLOCK;
+		while ( !batch.IsFull() )
+		{
+			const uint32 slotIndex = batch._count;
+			uint32 numberOfBytesRead = 0;
+			const SocketResult datagramResult =
+			    ReceiveFrom( batch.GetSlotData( slotIndex ), batch._datagramMaxSize, batch._addresses[ slotIndex ],
+			                 numberOfBytesRead );
+
+			if ( datagramResult == SocketResult::SOKT_SUCCESS )
+			{
+				batch._sizes[ slotIndex ] = numberOfBytesRead;
+				++batch._count;
+				result = SocketResult::SOKT_SUCCESS;
+			}
+			else if ( datagramResult == SocketResult::SOKT_WOULDBLOCK )
+			{
+				break;
+			}
+			else
+			{
+				if ( datagramResult == SocketResult::SOKT_CONNRESET )
+				{
+					resetRemoteAddress = batch._addresses[ slotIndex ];
+				}
+
+				result = datagramResult;
+				break;
+			}
+		}
+
+		return result;
+	}
+
+	SocketResult Socket::SendBatchTo( const DatagramBatch& batch, uint32& numberOfDatagramsSent ) const
+	{
+		numberOfDatagramsSent = 0;
+
+		if ( !IsValid() )
+		{
+			return SocketResult::SOKT_ERR;
+		}
+
+		// Winsock doesn't have a batched send call so send datagram by datagram
+		for ( uint32 i = 0; i < batch.GetCount(); ++i )
+		{
+			if ( SendTo( batch.GetDatagramData( i ), batch.GetDatagramSize( i ), batch.GetDatagramAddress( i ) ) ==
+			     SocketResult::SOKT_SUCCESS )
+			{
+				++numberOfDatagramsSent;
+			}
+		}
+
+		return ( numberOfDatagramsSent == batch.GetCount() ) ? SocketResult::SOKT_SUCCESS : SocketResult::SOKT_ERR;
+	}
+
+	SocketResult Socket::WaitForIncomingData( uint32 timeoutMilliseconds ) const
+	{
+		if ( !IsValid() )
+		{
+			return SocketResult::SOKT_ERR;
+		}
+
+		fd_set readSet;
+		FD_ZERO( &readSet );
+		FD_SET( _listenSocket, &readSet );
+
+		timeval timeout;
+		timeout.tv_sec = timeoutMilliseconds / 1000;
+		timeout.tv_usec = ( timeoutMilliseconds % 1000 ) * 1000;
+
+		// The first parameter is ignored by winsock. It is only kept for compatibility with Berkeley sockets
+		const int32 iResult = select( 0, &readSet, nullptr, nullptr, &timeout );
+		if ( iResult == SOCKET_ERROR )
+		{
+			LOG_ERROR( "Socket error. Error while waiting for incoming data. Error code %d", GetLastError() );
+			return SocketResult::SOKT_ERR;
+		}
+
+		return ( iResult > 0 ) ? SocketResult::SOKT_SUCCESS : SocketResult::SOKT_WOULDBLOCK;
+	}
+
 	Socket::~Socket()
 	{
 		Close();
 	}
 } // namespace NetLib
+
+#endif
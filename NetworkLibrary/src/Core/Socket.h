@@ -1,14 +1,16 @@
 #pragma once
 #include "numeric_types.h"
 
-#include <winsock2.h>
-#include <ws2tcpip.h>
+#include "core/socket_platform.h"
 
 namespace NetLib
 {
 	class Address;
+	class DatagramBatch;
 
 	constexpr uint32 MTU_SIZE_BYTES = 1500;
+	// Max number of datagrams moved by a single batched receive/send system call
+	constexpr uint32 MAX_DATAGRAMS_PER_BATCH_CALL = 64;
 
 	enum SocketResult : uint8
 	{
@@ -27,9 +29,34 @@ namespace NetLib
 
 			SocketResult Start();
 			SocketResult Bind( const Address& address ) const;
+			/// <summary>
+			/// Allows several sockets to bind to the same address and port so the OS distributes incoming datagrams
+			/// among them, keeping every remote address on the same socket. It must be called after Start and before
+			/// Bind. Only supported on Linux (SO_REUSEPORT). On Windows it returns SOKT_ERR.
+			/// </summary>
+			SocketResult EnableReusePort();
 			SocketResult ReceiveFrom( uint8* incomingDataBuffer, uint32 incomingDataBufferSize, Address& remoteAddress,
 			                          uint32& numberOfBytesRead ) const;
 			SocketResult SendTo( const uint8* dataBuffer, uint32 dataBufferSize, const Address& remoteAddress ) const;
+			/// <summary>
+			/// Receives as many datagrams as possible into the free slots of the batch. On Linux this is done with a
+			/// single recvmmsg call while on Windows it falls back to one recvfrom call per datagram. Datagrams read
+			/// before an error are kept in the batch. Returns SOKT_WOULDBLOCK if there was nothing to read and
+			/// SOKT_CONNRESET if a remote socket was closed, in which case resetRemoteAddress is set to its address.
+			/// </summary>
+			SocketResult ReceiveBatchFrom( DatagramBatch& batch, Address& resetRemoteAddress ) const;
+			/// <summary>
+			/// Sends all the datagrams within the batch. On Linux this is done with sendmmsg calls of up to
+			/// MAX_DATAGRAMS_PER_BATCH_CALL datagrams while on Windows it falls back to one sendto call per datagram.
+			/// Returns SOKT_SUCCESS only if every datagram was sent.
+			/// </summary>
+			SocketResult SendBatchTo( const DatagramBatch& batch, uint32& numberOfDatagramsSent ) const;
+			/// <summary>
+			/// Waits up to timeoutMilliseconds until there is incoming data ready to be read. Returns SOKT_SUCCESS if
+			/// there is data pending, SOKT_WOULDBLOCK if the timeout expired without data and SOKT_ERR on failure. A
+			/// timeout of 0 performs a non-blocking readiness check.
+			/// </summary>
+			SocketResult WaitForIncomingData( uint32 timeoutMilliseconds ) const;
 			SocketResult Close();
 
 			~Socket();
@@ -41,6 +68,10 @@ namespace NetLib
 			SocketResult SetBlockingMode( bool status );
 			SocketResult Create();
 
-			SOCKET _listenSocket;
+			SocketHandle _listenSocket;
+#if defined( __linux__ )
+			// Epoll instance where the listen socket is registered for read readiness notifications
+			SocketHandle _epollHandle;
+#endif
 	};
 } // namespace NetLib
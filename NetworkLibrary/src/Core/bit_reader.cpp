@@ -0,0 +1,129 @@
+#include "bit_reader.h"
+
+#include "logger.h"
+#include "asserts.h"
+
+#include "core/buffer.h"
+
+#include "utils/bitwise_utils.h"
+
+#include <cstring>
+
+namespace NetLib
+{
+	BitReader::BitReader( Buffer& buffer )
+	    : _buffer( buffer )
+	    , _scratch( 0 )
+	    , _scratchBits( 0 )
+	    , _numberOfBitsRead( 0 )
+	{
+	}
+
+	bool BitReader::ReadBits( uint32& value, uint32 number_of_bits )
+	{
+		ASSERT( number_of_bits <= 32, "[BitReader.%s] Can't read more than 32 bits at once. Bits: %u",
+		        THIS_FUNCTION_NAME, number_of_bits );
+
+		while ( _scratchBits < number_of_bits )
+		{
+			uint8 byte;
+			if ( !_buffer.ReadByte( byte ) )
+			{
+				return false;
+			}
+
+			_scratch |= static_cast< uint64 >( byte ) << _scratchBits;
+			_scratchBits += 8;
+		}
+
+		const uint64 mask = ( static_cast< uint64 >( 1 ) << number_of_bits ) - 1;
+		value = static_cast< uint32 >( _scratch & mask );
+		_scratch >>= number_of_bits;
+		_scratchBits -= number_of_bits;
+		_numberOfBitsRead += number_of_bits;
+		return true;
+	}
+
+	bool BitReader::ReadBool( bool& value )
+	{
+		uint32 bit;
+		if ( !ReadBits( bit, 1 ) )
+		{
+			return false;
+		}
+
+		value = ( bit == 1 );
+		return true;
+	}
+
+	bool BitReader::ReadInteger( uint32& value )
+	{
+		return ReadBits( value, 32 );
+	}
+
+	bool BitReader::ReadFloat( float32& value )
+	{
+		uint32 bits;
+		if ( !ReadBits( bits, 32 ) )
+		{
+			return false;
+		}
+
+		std::memcpy( &value, &bits, sizeof( float32 ) );
+		return true;
+	}
+
+	bool BitReader::ReadRangedInteger( int32& value, int32 min, int32 max )
+	{
+		ASSERT( min < max, "[BitReader.%s] Invalid range [%d, %d].", THIS_FUNCTION_NAME, min, max );
+
+		const uint32 range = static_cast< uint32 >( static_cast< int64 >( max ) - min );
+		uint32 relativeValue;
+		if ( !ReadBits( relativeValue, BitwiseUtils::GetNumberOfBitsRequired( range ) ) )
+		{
+			return false;
+		}
+
+		if ( relativeValue > range )
+		{
+			LOG_WARNING( "[BitReader.%s] Read value is out of range [%d, %d].", THIS_FUNCTION_NAME, min, max );
+			return false;
+		}
+
+		value = static_cast< int32 >( static_cast< int64 >( min ) + relativeValue );
+		return true;
+	}
+
+	bool BitReader::ReadQuantizedFloat( float32& value, float32 min, float32 max, float32 resolution )
+	{
+		const uint32 maxStep = BitwiseUtils::GetNumberOfQuantizationSteps( min, max, resolution );
+		uint32 step;
+		if ( !ReadBits( step, BitwiseUtils::GetNumberOfBitsRequired( maxStep ) ) )
+		{
+			return false;
+		}
+
+		if ( step > maxStep )
+		{
+			LOG_WARNING( "[BitReader.%s] Read quantized value is out of range [%f, %f].", THIS_FUNCTION_NAME, min,
+			             max );
+			return false;
+		}
+
+		value = min + ( static_cast< float32 >( step ) * resolution );
+		if ( value > max )
+		{
+			value = max;
+		}
+
+		return true;
+	}
+
+	void BitReader::AlignToByte()
+	{
+		// Pending bits always belong to a byte that has already been consumed from the buffer
+		_numberOfBitsRead += _scratchBits;
+		_scratch = 0;
+		_scratchBits = 0;
+	}
+} // namespace NetLib
@@ -0,0 +1,44 @@
+#pragma once
+#include "numeric_types.h"
+
+namespace NetLib
+{
+	class Buffer;
+
+	/// <summary>
+	/// Bit packed read stream on top of a Buffer, the counterpart of BitWriter. Bytes are pulled from the buffer only
+	/// when needed, so once a read finishes the buffer access index is at the byte boundary that follows the last bit
+	/// read. All reads return false if there is not enough data or if the decoded value is out of its range.
+	/// </summary>
+	class BitReader
+	{
+		public:
+			BitReader( Buffer& buffer );
+			BitReader( const BitReader& ) = delete;
+
+			BitReader& operator=( const BitReader& ) = delete;
+
+			~BitReader() {}
+
+			uint32 GetNumberOfBitsRead() const { return _numberOfBitsRead; }
+
+			bool ReadBits( uint32& value, uint32 number_of_bits );
+			bool ReadBool( bool& value );
+			bool ReadInteger( uint32& value );
+			bool ReadFloat( float32& value );
+			bool ReadRangedInteger( int32& value, int32 min, int32 max );
+			bool ReadQuantizedFloat( float32& value, float32 min, float32 max, float32 resolution );
+
+			/// <summary>
+			/// Discards the padding bits left in the current byte. Call it before reading byte aligned data from the
+			/// buffer again.
+			/// </summary>
+			void AlignToByte();
+
+		private:
+			Buffer& _buffer;
+			uint64 _scratch;
+			uint32 _scratchBits;
+			uint32 _numberOfBitsRead;
+	};
+} // namespace NetLib
@@ -0,0 +1,122 @@
+#include "bit_writer.h"
+
+#include "logger.h"
+#include "asserts.h"
+
+#include "core/buffer.h"
+
+#include "utils/bitwise_utils.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace NetLib
+{
+	BitWriter::BitWriter( Buffer& buffer )
+	    : _buffer( buffer )
+	    , _scratch( 0 )
+	    , _scratchBits( 0 )
+	    , _numberOfBitsWritten( 0 )
+	    , _isOverflowed( false )
+	{
+	}
+
+	BitWriter::~BitWriter()
+	{
+		ASSERT( _scratchBits == 0, "[BitWriter.%s] There are %u bits pending. Call Flush before destroying it.",
+		        THIS_FUNCTION_NAME, _scratchBits );
+	}
+
+	void BitWriter::WriteBits( uint32 value, uint32 number_of_bits )
+	{
+		ASSERT( number_of_bits <= 32, "[BitWriter.%s] Can't write more than 32 bits at once. Bits: %u",
+		        THIS_FUNCTION_NAME, number_of_bits );
+		ASSERT( number_of_bits == 32 || ( static_cast< uint64 >( value ) >> number_of_bits ) == 0,
+		        "[BitWriter.%s] Value %u doesn't fit in %u bits.", THIS_FUNCTION_NAME, value, number_of_bits );
+
+		_scratch |= static_cast< uint64 >( value ) << _scratchBits;
+		_scratchBits += number_of_bits;
+		_numberOfBitsWritten += number_of_bits;
+
+		while ( _scratchBits >= 8 )
+		{
+			WriteByteToBuffer( static_cast< uint8 >( _scratch & 0xFF ) );
+			_scratch >>= 8;
+			_scratchBits -= 8;
+		}
+	}
+
+	void BitWriter::WriteBool( bool value )
+	{
+		WriteBits( value ? 1 : 0, 1 );
+	}
+
+	void BitWriter::WriteInteger( uint32 value )
+	{
+		WriteBits( value, 32 );
+	}
+
+	void BitWriter::WriteFloat( float32 value )
+	{
+		uint32 bits;
+		std::memcpy( &bits, &value, sizeof( uint32 ) );
+		WriteBits( bits, 32 );
+	}
+
+	void BitWriter::WriteRangedInteger( int32 value, int32 min, int32 max )
+	{
+		ASSERT( min < max, "[BitWriter.%s] Invalid range [%d, %d].", THIS_FUNCTION_NAME, min, max );
+		ASSERT( value >= min && value <= max, "[BitWriter.%s] Value %d is out of range [%d, %d].",
+		        THIS_FUNCTION_NAME, value, min, max );
+
+		const uint32 range = static_cast< uint32 >( static_cast< int64 >( max ) - min );
+		const uint32 relativeValue = static_cast< uint32 >( static_cast< int64 >( value ) - min );
+		WriteBits( relativeValue, BitwiseUtils::GetNumberOfBitsRequired( range ) );
+	}
+
+	void BitWriter::WriteQuantizedFloat( float32 value, float32 min, float32 max, float32 resolution )
+	{
+		const uint32 maxStep = BitwiseUtils::GetNumberOfQuantizationSteps( min, max, resolution );
+
+		float32 clampedValue = value;
+		if ( clampedValue < min )
+		{
+			clampedValue = min;
+		}
+		else if ( clampedValue > max )
+		{
+			clampedValue = max;
+		}
+
+		uint32 step = static_cast< uint32 >( std::round( ( clampedValue - min ) / resolution ) );
+		if ( step > maxStep )
+		{
+			step = maxStep;
+		}
+
+		WriteBits( step, BitwiseUtils::GetNumberOfBitsRequired( maxStep ) );
+	}
+
+	void BitWriter::Flush()
+	{
+		if ( _scratchBits > 0 )
+		{
+			WriteByteToBuffer( static_cast< uint8 >( _scratch & 0xFF ) );
+			_numberOfBitsWritten += 8 - _scratchBits;
+		}
+
+		_scratch = 0;
+		_scratchBits = 0;
+	}
+
+	void BitWriter::WriteByteToBuffer( uint8 value )
+	{
+		if ( _buffer.GetRemainingSize() == 0 )
+		{
+			_isOverflowed = true;
+			return;
+		}
+
+		_buffer.WriteByte( value );
+	}
+} // namespace NetLib
@@ -0,0 +1,62 @@
+#pragma once
+#include "numeric_types.h"
+
+namespace NetLib
+{
+	class Buffer;
+
+	/// <summary>
+	/// Bit packed write stream on top of a Buffer. Values are accumulated into a scratch word and moved to the buffer
+	/// one byte at a time, so fields don't need to be byte aligned. Call Flush before reading the buffer size or
+	/// writing byte aligned data into the buffer again, the last partial byte is padded with zeroes.
+	/// </summary>
+	class BitWriter
+	{
+		public:
+			BitWriter( Buffer& buffer );
+			BitWriter( const BitWriter& ) = delete;
+
+			BitWriter& operator=( const BitWriter& ) = delete;
+
+			~BitWriter();
+
+			uint32 GetNumberOfBitsWritten() const { return _numberOfBitsWritten; }
+			/// <summary>
+			/// Returns true if more bits were written than fit in the buffer. The bits that didn't fit are dropped.
+			/// </summary>
+			bool IsOverflowed() const { return _isOverflowed; }
+
+			/// <summary>
+			/// Writes the lowest number_of_bits bits of value. number_of_bits must be in range [0, 32].
+			/// </summary>
+			void WriteBits( uint32 value, uint32 number_of_bits );
+			void WriteBool( bool value );
+			void WriteInteger( uint32 value );
+			void WriteFloat( float32 value );
+
+			/// <summary>
+			/// Writes value using only the bits required to represent the range [min, max].
+			/// </summary>
+			void WriteRangedInteger( int32 value, int32 min, int32 max );
+
+			/// <summary>
+			/// Writes value clamped to the range [min, max] and quantized with the given resolution. The number of bits
+			/// used depends on (max - min) / resolution.
+			/// </summary>
+			void WriteQuantizedFloat( float32 value, float32 min, float32 max, float32 resolution );
+
+			/// <summary>
+			/// Moves any pending bits into the buffer, padding the last byte with zeroes.
+			/// </summary>
+			void Flush();
+
+		private:
+			void WriteByteToBuffer( uint8 value );
+
+			Buffer& _buffer;
+			uint64 _scratch;
+			uint32 _scratchBits;
+			uint32 _numberOfBitsWritten;
+			bool _isOverflowed;
+	};
+} // namespace NetLib
@@ -0,0 +1,71 @@
+#include "datagram_batch.h"
+
+#include "logger.h"
+#include "asserts.h"
+
+namespace NetLib
+{
+	DatagramBatch::DatagramBatch( uint32 capacity, uint32 datagram_max_size )
+	    : _capacity( capacity )
+	    , _datagramMaxSize( datagram_max_size )
+	    , _count( 0 )
+	    , _data( nullptr )
+	    , _sizes( capacity, 0 )
+	    , _addresses( capacity, Address::GetInvalid() )
+	{
+		ASSERT( _capacity > 0, "[DatagramBatch.%s] Capacity must be greater than 0", THIS_FUNCTION_NAME );
+		_data = new uint8[ _capacity * _datagramMaxSize ];
+	}
+
+	DatagramBatch::~DatagramBatch()
+	{
+		delete[] _data;
+		_data = nullptr;
+	}
+
+	uint8* DatagramBatch::GetDatagramData( uint32 index )
+	{
+		ASSERT( index < _count, "[DatagramBatch.%s] Index out of bounds. Index: %u, Count: %u", THIS_FUNCTION_NAME,
+		        index, _count );
+		return GetSlotData( index );
+	}
+
+	const uint8* DatagramBatch::GetDatagramData( uint32 index ) const
+	{
+		ASSERT( index < _count, "[DatagramBatch.%s] Index out of bounds. Index: %u, Count: %u", THIS_FUNCTION_NAME,
+		        index, _count );
+		return GetSlotData( index );
+	}
+
+	uint32 DatagramBatch::GetDatagramSize( uint32 index ) const
+	{
+		ASSERT( index < _count, "[DatagramBatch.%s] Index out of bounds. Index: %u, Count: %u", THIS_FUNCTION_NAME,
+		        index, _count );
+		return _sizes[ index ];
+	}
+
+	const Address& DatagramBatch::GetDatagramAddress( uint32 index ) const
+	{
+		ASSERT( index < _count, "[DatagramBatch.%s] Index out of bounds. Index: %u, Count: %u", THIS_FUNCTION_NAME,
+		        index, _count );
+		return _addresses[ index ];
+	}
+
+	uint8* DatagramBatch::GetNextFreeSlot()
+	{
+		return IsFull() ? nullptr : GetSlotData( _count );
+	}
+
+	bool DatagramBatch::CommitNextFreeSlot( uint32 size, const Address& address )
+	{
+		if ( IsFull() || size > _datagramMaxSize )
+		{
+			return false;
+		}
+
+		_sizes[ _count ] = size;
+		_addresses[ _count ] = address;
+		++_count;
+		return true;
+	}
+} // namespace NetLib
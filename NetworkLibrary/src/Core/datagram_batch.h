@@ -0,0 +1,68 @@
+#pragma once
+#include "numeric_types.h"
+
+#include <vector>
+
+#include "core/address.h"
+
+namespace NetLib
+{
+	/// <summary>
+	/// Fixed capacity set of datagrams backed by a single contiguous allocation of capacity * datagram_max_size
+	/// bytes. It is used to move several datagrams per socket call (recvmmsg/sendmmsg on Linux) and it is reused
+	/// between calls, so no allocations happen after construction. Datagrams are written in place: get the next free
+	/// slot, serialize into it and commit it.
+	/// </summary>
+	class DatagramBatch
+	{
+		public:
+			DatagramBatch( uint32 capacity, uint32 datagram_max_size );
+			DatagramBatch( const DatagramBatch& ) = delete;
+			DatagramBatch( DatagramBatch&& ) = delete;
+
+			DatagramBatch& operator=( const DatagramBatch& ) = delete;
+			DatagramBatch& operator=( DatagramBatch&& ) = delete;
+
+			~DatagramBatch();
+
+			uint32 GetCapacity() const { return _capacity; }
+			uint32 GetCount() const { return _count; }
+			uint32 GetDatagramMaxSize() const { return _datagramMaxSize; }
+			bool IsEmpty() const { return _count == 0; }
+			bool IsFull() const { return _count == _capacity; }
+
+			uint8* GetDatagramData( uint32 index );
+			const uint8* GetDatagramData( uint32 index ) const;
+			uint32 GetDatagramSize( uint32 index ) const;
+			const Address& GetDatagramAddress( uint32 index ) const;
+
+			/// <summary>
+			/// Returns the next free slot, of GetDatagramMaxSize bytes, or nullptr if the batch is full. The slot is
+			/// not part of the batch until CommitNextFreeSlot is called.
+			/// </summary>
+			uint8* GetNextFreeSlot();
+
+			/// <summary>
+			/// Adds the datagram written into the slot returned by GetNextFreeSlot to the batch. Returns false if the
+			/// batch is full or if the size is bigger than the slot size.
+			/// </summary>
+			bool CommitNextFreeSlot( uint32 size, const Address& address );
+
+			void Clear() { _count = 0; }
+
+		private:
+			uint8* GetSlotData( uint32 index ) { return _data + ( index * _datagramMaxSize ); }
+			const uint8* GetSlotData( uint32 index ) const { return _data + ( index * _datagramMaxSize ); }
+
+			const uint32 _capacity;
+			const uint32 _datagramMaxSize;
+			uint32 _count;
+
+			uint8* _data;
+			std::vector< uint32 > _sizes;
+			std::vector< Address > _addresses;
+
+			// The socket fills the slots in place when receiving
+			friend class Socket;
+	};
+} // namespace NetLib
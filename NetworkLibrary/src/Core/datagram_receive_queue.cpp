@@ -0,0 +1,111 @@
+#include "datagram_receive_queue.h"
+
+#include "logger.h"
+#include "asserts.h"
+
+namespace NetLib
+{
+	DatagramReceiveQueue::DatagramReceiveQueue( uint32 capacity, uint32 datagram_max_size )
+	    : _capacity( capacity )
+	    , _datagramMaxSize( datagram_max_size )
+	    , _data( nullptr )
+	    , _sizes( capacity, 0 )
+	    , _addresses( capacity, Address::GetInvalid() )
+	    , _connectionResets( capacity, 0 )
+	    , _head( 0 )
+	    , _tail( 0 )
+	    , _numberOfDroppedDatagrams( 0 )
+	{
+		ASSERT( _capacity > 0 && ( _capacity & ( _capacity - 1 ) ) == 0,
+		        "[DatagramReceiveQueue.%s] Capacity must be a power of two. Capacity: %u", THIS_FUNCTION_NAME,
+		        _capacity );
+		_data = new uint8[ _capacity * _datagramMaxSize ];
+	}
+
+	DatagramReceiveQueue::~DatagramReceiveQueue()
+	{
+		delete[] _data;
+		_data = nullptr;
+	}
+
+	uint8* DatagramReceiveQueue::GetNextFreeSlot()
+	{
+		const uint32 tail = _tail.load( std::memory_order_relaxed );
+		if ( tail - _head.load( std::memory_order_acquire ) == _capacity )
+		{
+			return nullptr;
+		}
+
+		return GetSlotData( tail );
+	}
+
+	bool DatagramReceiveQueue::CommitNextFreeSlot( uint32 size, const Address& address )
+	{
+		if ( size > _datagramMaxSize )
+		{
+			return false;
+		}
+
+		return Publish( size, address, false );
+	}
+
+	bool DatagramReceiveQueue::PushConnectionReset( const Address& address )
+	{
+		return Publish( 0, address, true );
+	}
+
+	bool DatagramReceiveQueue::Publish( uint32 size, const Address& address, bool is_connection_reset )
+	{
+		const uint32 tail = _tail.load( std::memory_order_relaxed );
+		if ( tail - _head.load( std::memory_order_acquire ) == _capacity )
+		{
+			return false;
+		}
+
+		const uint32 slotIndex = GetSlotIndex( tail );
+		_sizes[ slotIndex ] = size;
+		_addresses[ slotIndex ] = address;
+		_connectionResets[ slotIndex ] = is_connection_reset ? 1 : 0;
+
+		// Make the slot contents visible before the consumer can see the new tail
+		_tail.store( tail + 1, std::memory_order_release );
+		return true;
+	}
+
+	bool DatagramReceiveQueue::IsEmpty() const
+	{
+		return _head.load( std::memory_order_relaxed ) == _tail.load( std::memory_order_acquire );
+	}
+
+	bool DatagramReceiveQueue::TryPeek( ReceivedDatagram& datagram ) const
+	{
+		const uint32 head = _head.load( std::memory_order_relaxed );
+		if ( head == _tail.load( std::memory_order_acquire ) )
+		{
+			return false;
+		}
+
+		const uint32 slotIndex = GetSlotIndex( head );
+		datagram.data = _data + ( slotIndex * _datagramMaxSize );
+		datagram.size = _sizes[ slotIndex ];
+		datagram.address = &_addresses[ slotIndex ];
+		datagram.isConnectionReset = ( _connectionResets[ slotIndex ] != 0 );
+		return true;
+	}
+
+	void DatagramReceiveQueue::Pop()
+	{
+		const uint32 head = _head.load( std::memory_order_relaxed );
+		ASSERT( head != _tail.load( std::memory_order_acquire ), "[DatagramReceiveQueue.%s] The queue is empty",
+		        THIS_FUNCTION_NAME );
+
+		// Hand the slot back to the producer once its data has been used
+		_head.store( head + 1, std::memory_order_release );
+	}
+
+	void DatagramReceiveQueue::Clear()
+	{
+		_head.store( _tail.load( std::memory_order_acquire ), std::memory_order_release );
+		_numberOfDroppedDatagrams.store( 0, std::memory_order_relaxed );
+	}
+} // namespace NetLib
@@ -0,0 +1,119 @@
+#pragma once
+#include "numeric_types.h"
+
+#include <atomic>
+#include <vector>
+
+#include "core/address.h"
+
+namespace NetLib
+{
+	/// <summary>
+	/// A datagram popped from a DatagramReceiveQueue. If isConnectionReset is true there is no data and it notifies
+	/// that the remote socket at address got closed.
+	/// </summary>
+	struct ReceivedDatagram
+	{
+			uint8* data;
+			uint32 size;
+			const Address* address;
+			bool isConnectionReset;
+	};
+
+	/// <summary>
+	/// Lock-free single producer single consumer ring of received datagrams, backed by a single contiguous allocation
+	/// of capacity * datagram_max_size bytes. The receive thread writes datagrams in place (get the next free slot,
+	/// copy into it and commit it) and the game thread peeks and pops them. If the ring is full incoming datagrams are
+	/// dropped, as the OS would do with a full socket buffer, and counted.
+	/// </summary>
+	class DatagramReceiveQueue
+	{
+		public:
+			/// <summary>
+			/// The capacity must be a power of two.
+			/// </summary>
+			DatagramReceiveQueue( uint32 capacity, uint32 datagram_max_size );
+			DatagramReceiveQueue( const DatagramReceiveQueue& ) = delete;
+			DatagramReceiveQueue( DatagramReceiveQueue&& ) = delete;
+
+			DatagramReceiveQueue& operator=( const DatagramReceiveQueue& ) = delete;
+			DatagramReceiveQueue& operator=( DatagramReceiveQueue&& ) = delete;
+
+			~DatagramReceiveQueue();
+
+			uint32 GetCapacity() const { return _capacity; }
+			uint32 GetDatagramMaxSize() const { return _datagramMaxSize; }
+
+			// Producer side
+
+			/// <summary>
+			/// Returns the next free slot, of GetDatagramMaxSize bytes, or nullptr if the ring is full. The slot is not
+			/// visible to the consumer until CommitNextFreeSlot is called.
+			/// </summary>
+			uint8* GetNextFreeSlot();
+
+			/// <summary>
+			/// Publishes the datagram written into the slot returned by GetNextFreeSlot. Returns false if the ring is
+			/// full or if the size is bigger than the slot size.
+			/// </summary>
+			bool CommitNextFreeSlot( uint32 size, const Address& address );
+
+			/// <summary>
+			/// Publishes a notification that the remote socket at address got closed. Returns false if the ring is
+			/// full.
+			/// </summary>
+			bool PushConnectionReset( const Address& address );
+
+			/// <summary>
+			/// Counts a datagram that had to be dropped because the ring was full.
+			/// </summary>
+			void AddDroppedDatagram() { _numberOfDroppedDatagrams.fetch_add( 1, std::memory_order_relaxed ); }
+
+			// Consumer side
+
+			bool IsEmpty() const;
+
+			/// <summary>
+			/// Gets the oldest datagram without removing it. Its data remains valid until Pop is called. Returns false
+			/// if the ring is empty.
+			/// </summary>
+			bool TryPeek( ReceivedDatagram& datagram ) const;
+			void Pop();
+
+			/// <summary>
+			/// Returns the number of datagrams dropped since the last call and resets it.
+			/// </summary>
+			uint32 ConsumeNumberOfDroppedDatagrams()
+			{
+				return _numberOfDroppedDatagrams.exchange( 0, std::memory_order_relaxed );
+			}
+
+			/// <summary>
+			/// Discards every queued datagram. It must only be called when there is no producer running.
+			/// </summary>
+			void Clear();
+
+		private:
+			// Keep the indices used by each thread in different cache lines
+			static constexpr uint32 CACHE_LINE_SIZE = 64;
+
+			uint32 GetSlotIndex( uint32 position ) const { return position & ( _capacity - 1 ); }
+			uint8* GetSlotData( uint32 position ) { return _data + ( GetSlotIndex( position ) * _datagramMaxSize ); }
+			bool Publish( uint32 size, const Address& address, bool is_connection_reset );
+
+			const uint32 _capacity;
+			const uint32 _datagramMaxSize;
+
+			uint8* _data;
+			std::vector< uint32 > _sizes;
+			std::vector< Address > _addresses;
+			// Not a vector of bools so each slot flag is a different memory location
+			std::vector< uint8 > _connectionResets;
+
+			// Next position to read. Only written by the consumer
+			alignas( CACHE_LINE_SIZE ) std::atomic< uint32 > _head;
+			// Next position to write. Only written by the producer
+			alignas( CACHE_LINE_SIZE ) std::atomic< uint32 > _tail;
+			alignas( CACHE_LINE_SIZE ) std::atomic< uint32 > _numberOfDroppedDatagrams;
+	};
+} // namespace NetLib
@@ -0,0 +1,65 @@
+#include "datagram_send_queue.h"
+
+#include "logger.h"
+
+#include "core/socket.h"
+#include "core/address.h"
+
+#include "metrics/metrics_handler.h"
+
+namespace NetLib
+{
+	DatagramSendQueue::DatagramSendQueue( const Socket& socket, uint32 capacity, uint32 datagram_max_size )
+	    : _socket( socket )
+	    , _batch( capacity, datagram_max_size )
+	    , _outgoingPacket()
+	    , _metricsHandler( nullptr )
+	{
+	}
+
+	uint8* DatagramSendQueue::AcquireDatagramBuffer( uint32 size )
+	{
+		if ( size > _batch.GetDatagramMaxSize() )
+		{
+			LOG_ERROR( "[DatagramSendQueue.%s] Datagram of %u bytes doesn't fit in the send queue. Max size: %u",
+			           THIS_FUNCTION_NAME, size, _batch.GetDatagramMaxSize() );
+			return nullptr;
+		}
+
+		if ( _batch.IsFull() )
+		{
+			Flush();
+		}
+
+		return _batch.GetNextFreeSlot();
+	}
+
+	bool DatagramSendQueue::CommitDatagram( uint32 size, const Address& address )
+	{
+		return _batch.CommitNextFreeSlot( size, address );
+	}
+
+	uint32 DatagramSendQueue::Flush()
+	{
+		if ( _batch.IsEmpty() )
+		{
+			return 0;
+		}
+
+		uint32 numberOfDatagramsSent = 0;
+		const SocketResult result = _socket.SendBatchTo( _batch, numberOfDatagramsSent );
+		if ( result != SocketResult::SOKT_SUCCESS )
+		{
+			LOG_WARNING( "[DatagramSendQueue.%s] Only %u out of %u datagrams could be sent", THIS_FUNCTION_NAME,
+			             numberOfDatagramsSent, _batch.GetCount() );
+		}
+
+		if ( _metricsHandler != nullptr && _metricsHandler->HasMetric( Metrics::MetricType::SEND_BATCH_SIZE ) )
+		{
+			_metricsHandler->AddValue( Metrics::MetricType::SEND_BATCH_SIZE, _batch.GetCount() );
+		}
+
+		_batch.Clear();
+		return numberOfDatagramsSent;
+	}
+} // namespace NetLib
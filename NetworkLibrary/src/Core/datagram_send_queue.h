@@ -0,0 +1,80 @@
+#pragma once
+#include "numeric_types.h"
+
+#include "core/datagram_batch.h"
+
+#include "communication/network_packet.h"
+
+namespace NetLib
+{
+	class Socket;
+	class Address;
+
+	namespace Metrics
+	{
+		class MetricsHandler;
+	}
+
+	/// <summary>
+	/// Per tick send arena and queue of outgoing datagrams. Transmission channels serialize their packets directly into
+	/// the queue's preallocated MTU sized slots instead of calling the socket, and the local peer flushes the whole
+	/// queue with a single batched socket call at the end of the tick. If the queue gets full before that, it is
+	/// flushed automatically. Together with the reusable outgoing packet, the send path doesn't touch the heap once
+	/// it has warmed up.
+	/// </summary>
+	class DatagramSendQueue
+	{
+		public:
+			DatagramSendQueue( const Socket& socket, uint32 capacity, uint32 datagram_max_size );
+			DatagramSendQueue( const DatagramSendQueue& ) = delete;
+
+			DatagramSendQueue& operator=( const DatagramSendQueue& ) = delete;
+
+			/// <summary>
+			/// Sets the metrics handler where the size of each flushed batch will be reported. It can be nullptr.
+			/// </summary>
+			void SetMetricsHandler( Metrics::MetricsHandler* metrics_handler ) { _metricsHandler = metrics_handler; }
+
+			/// <summary>
+			/// Returns a reusable packet to build outgoing datagrams with. Its messages vector keeps its capacity
+			/// between uses so it must be left empty after serializing it.
+			/// </summary>
+			NetworkPacket& GetOutgoingPacket() { return _outgoingPacket; }
+
+			/// <summary>
+			/// Returns a buffer where a datagram of up to size bytes can be serialized in place. Once written, it
+			/// must be queued with CommitDatagram. Returns nullptr if size is bigger than the queue's datagram max
+			/// size.
+			/// </summary>
+			uint8* AcquireDatagramBuffer( uint32 size );
+
+			/// <summary>
+			/// Queues the datagram serialized into the buffer returned by the last AcquireDatagramBuffer call.
+			/// </summary>
+			bool CommitDatagram( uint32 size, const Address& address );
+
+			/// <summary>
+			/// Sends all the queued datagrams and clears the queue. Returns the number of datagrams sent.
+			/// </summary>
+			uint32 Flush();
+
+			uint32 GetCount() const { return _batch.GetCount(); }
+
+			/// <summary>
+			/// Returns the datagrams queued since the last flush. Useful to inspect the outgoing traffic without
+			/// going through the socket.
+			/// </summary>
+			const DatagramBatch& GetQueuedDatagrams() const { return _batch; }
+
+			/// <summary>
+			/// Drops all the queued datagrams without sending them.
+			/// </summary>
+			void Discard() { _batch.Clear(); }
+
+		private:
+			const Socket& _socket;
+			DatagramBatch _batch;
+			NetworkPacket _outgoingPacket;
+			Metrics::MetricsHandler* _metricsHandler;
+	};
+} // namespace NetLib
@@ -0,0 +1,120 @@
+#include "receive_thread.h"
+
+#include <cstring>
+
+#include "logger.h"
+#include "asserts.h"
+
+#include "core/socket.h"
+
+namespace NetLib
+{
+	ReceiveThread::ReceiveThread( uint32 queue_capacity, uint32 batch_capacity, uint32 datagram_max_size )
+	    : _socket( nullptr )
+	    , _receiveBatch( batch_capacity, datagram_max_size )
+	    , _queue( queue_capacity, datagram_max_size )
+	    , _thread()
+	    , _isStopRequested( false )
+	{
+	}
+
+	ReceiveThread::~ReceiveThread()
+	{
+		Stop();
+	}
+
+	bool ReceiveThread::Start( const Socket& socket )
+	{
+		if ( IsRunning() )
+		{
+			LOG_WARNING( "[ReceiveThread.%s] The receive thread is already running", THIS_FUNCTION_NAME );
+			return false;
+		}
+
+		_socket = &socket;
+		_queue.Clear();
+		_isStopRequested.store( false, std::memory_order_relaxed );
+		_thread = std::thread( &ReceiveThread::Run, this );
+		return true;
+	}
+
+	void ReceiveThread::Stop()
+	{
+		if ( !IsRunning() )
+		{
+			return;
+		}
+
+		_isStopRequested.store( true, std::memory_order_relaxed );
+		_thread.join();
+
+		_queue.Clear();
+		_socket = nullptr;
+	}
+
+	void ReceiveThread::Run()
+	{
+		Address resetRemoteAddress = Address::GetInvalid();
+
+		while ( !_isStopRequested.load( std::memory_order_relaxed ) )
+		{
+			const SocketResult waitResult = _socket->WaitForIncomingData( RECEIVE_THREAD_WAIT_TIMEOUT_MS );
+			if ( waitResult == SocketResult::SOKT_ERR )
+			{
+				LOG_ERROR( "[ReceiveThread.%s] Error while waiting for incoming data. Stopping receive thread",
+				           THIS_FUNCTION_NAME );
+				break;
+			}
+
+			if ( waitResult != SocketResult::SOKT_SUCCESS )
+			{
+				continue;
+			}
+
+			bool arePendingDatagramsToRead = true;
+			do
+			{
+				_receiveBatch.Clear();
+				const SocketResult result = _socket->ReceiveBatchFrom( _receiveBatch, resetRemoteAddress );
+
+				// Enqueue whatever was read, even if the batch stopped early due to an error
+				EnqueueReceivedDatagrams();
+
+				if ( result == SocketResult::SOKT_SUCCESS )
+				{
+					// A partially filled batch means that the socket has been drained
+					arePendingDatagramsToRead = _receiveBatch.IsFull();
+				}
+				else if ( result == SocketResult::SOKT_CONNRESET )
+				{
+					if ( !_queue.PushConnectionReset( resetRemoteAddress ) )
+					{
+						_queue.AddDroppedDatagram();
+					}
+				}
+				else
+				{
+					arePendingDatagramsToRead = false;
+				}
+			} while ( arePendingDatagramsToRead && !_isStopRequested.load( std::memory_order_relaxed ) );
+		}
+	}
+
+	void ReceiveThread::EnqueueReceivedDatagrams()
+	{
+		const uint32 numberOfDatagrams = _receiveBatch.GetCount();
+		for ( uint32 i = 0; i < numberOfDatagrams; ++i )
+		{
+			uint8* slot = _queue.GetNextFreeSlot();
+			if ( slot == nullptr )
+			{
+				_queue.AddDroppedDatagram();
+				continue;
+			}
+
+			const uint32 size = _receiveBatch.GetDatagramSize( i );
+			std::memcpy( slot, _receiveBatch.GetDatagramData( i ), size );
+			_queue.CommitNextFreeSlot( size, _receiveBatch.GetDatagramAddress( i ) );
+		}
+	}
+} // namespace NetLib
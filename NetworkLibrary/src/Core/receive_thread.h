@@ -0,0 +1,68 @@
+#pragma once
+#include "numeric_types.h"
+
+#include <atomic>
+#include <thread>
+
+#include "core/datagram_batch.h"
+#include "core/datagram_receive_queue.h"
+
+namespace NetLib
+{
+	class Socket;
+
+	// Max time the receive thread blocks waiting for incoming data before checking whether it has to stop
+	constexpr uint32 RECEIVE_THREAD_WAIT_TIMEOUT_MS = 10;
+
+	/// <summary>
+	/// Optional I/O thread that owns the reading side of a socket. It blocks until there is incoming data, reads it in
+	/// batches and copies every datagram into a lock-free SPSC queue that the game thread drains once per tick, so
+	/// bursts of packets are read off the socket while the simulation runs instead of when it is already late.
+	/// </summary>
+	class ReceiveThread
+	{
+		public:
+			ReceiveThread( uint32 queue_capacity, uint32 batch_capacity, uint32 datagram_max_size );
+			ReceiveThread( const ReceiveThread& ) = delete;
+			ReceiveThread( ReceiveThread&& ) = delete;
+
+			ReceiveThread& operator=( const ReceiveThread& ) = delete;
+			ReceiveThread& operator=( ReceiveThread&& ) = delete;
+
+			~ReceiveThread();
+
+			/// <summary>
+			/// Starts reading from the socket in a new thread. The socket must stay open until Stop is called. From
+			/// now on, the socket must not be read from any other thread.
+			/// </summary>
+			bool Start( const Socket& socket );
+
+			/// <summary>
+			/// Stops and joins the thread and discards any datagram that was not processed yet.
+			/// </summary>
+			void Stop();
+
+			bool IsRunning() const { return _thread.joinable(); }
+
+			/// <summary>
+			/// Queue where the received datagrams are stored. Only the game thread can consume from it.
+			/// </summary>
+			DatagramReceiveQueue& GetQueue() { return _queue; }
+
+		private:
+			void Run();
+
+			/// <summary>
+			/// Copies the datagrams of the receive batch into the queue. The ones that don't fit are dropped.
+			/// </summary>
+			void EnqueueReceivedDatagrams();
+
+			const Socket* _socket;
+			// Only used from the receive thread
+			DatagramBatch _receiveBatch;
+			DatagramReceiveQueue _queue;
+
+			std::thread _thread;
+			std::atomic< bool > _isStopRequested;
+	};
+} // namespace NetLib
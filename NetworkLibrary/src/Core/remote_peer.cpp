@@ -12,7 +12,7 @@
 
 #include "metrics/metric_types.h"
 
-#include "core/Socket.h"
+#include "core/datagram_send_queue.h"
 
 namespace NetLib
 {
@@ -65,6 +65,7 @@ namespace NetLib
 	    , _serverSalt( 0 )
 	    , _maxInactivityTime( 0 )
 	    , _inactivityTimeLeft( 0 )
+	    , _socketShardIndex( 0 )
 	    , _nextPacketSequenceNumber( 0 )
 	    , _currentState( RemotePeerState::Disconnected )
 	    , _transmissionChannels()
@@ -78,6 +79,7 @@ namespace NetLib
 	    , _serverSalt( 0 )
 	    , _maxInactivityTime( 0 )
 	    , _inactivityTimeLeft( 0 )
+	    , _socketShardIndex( 0 )
 	    , _nextPacketSequenceNumber( 0 )
 	    , _currentState( RemotePeerState::Disconnected )
 	    , _transmissionChannels()
@@ -88,6 +90,7 @@ namespace NetLib
 	RemotePeer::RemotePeer( const Address& address, uint16 id, float32 maxInactivityTime, uint64 clientSalt,
 	                        uint64 serverSalt, MessageFactory* message_factory )
 	    : _address( Address::GetInvalid() )
+	    , _socketShardIndex( 0 )
 	    , _nextPacketSequenceNumber( 0 )
 	    , _currentState( RemotePeerState::Disconnected )
 	{
@@ -120,6 +123,7 @@ namespace NetLib
 		_inactivityTimeLeft = _maxInactivityTime;
 		_clientSalt = clientSalt;
 		_serverSalt = serverSalt;
+		_socketShardIndex = 0;
 		_currentState = RemotePeerState::Connected;
 
 		// TODO Add here the list of metrics or metrics data we can to enable for this remote peer
@@ -187,13 +191,13 @@ namespace NetLib
 		return result;
 	}
 
-	void RemotePeer::SendData( Socket& socket )
+	void RemotePeer::SendData( DatagramSendQueue& send_queue )
 	{
 		std::vector< TransmissionChannel* >::iterator it = _transmissionChannels.begin();
 		for ( ; it < _transmissionChannels.end(); ++it )
 		{
 			TransmissionChannel* channel = *it;
-			channel->CreateAndSendPacket( socket, _address, _metricsHandler );
+			channel->CreateAndSendPacket( send_queue, _address, _metricsHandler );
 		}
 	}
 
@@ -210,7 +214,7 @@ namespace NetLib
 		const uint32 packet_size = packet.Size();
 
 		// Process packet ACKs
-		const uint32 acks = packet.GetHeader().ackBits;
+		const AckBitfield& acks = packet.GetHeader().ackBits;
 		const uint16 lastAckedMessageSequenceNumber = packet.GetHeader().lastAckedSequenceNumber;
 		const TransmissionChannelType channelType =
 		    static_cast< TransmissionChannelType >( packet.GetHeader().channelType );
@@ -229,7 +233,7 @@ namespace NetLib
 		}
 	}
 
-	void RemotePeer::ProcessACKs( uint32 acks, uint16 lastAckedMessageSequenceNumber,
+	void RemotePeer::ProcessACKs( const AckBitfield& acks, uint16 lastAckedMessageSequenceNumber,
 	                              TransmissionChannelType channelType )
 	{
 		TransmissionChannel* transmissionChannel = GetTransmissionChannelFromType( channelType );
@@ -239,6 +243,18 @@ namespace NetLib
 		}
 	}
 
+	bool RemotePeer::SetAckWindowSize( uint32 ack_window_size )
+	{
+		TransmissionChannel* transmissionChannel =
+		    GetTransmissionChannelFromType( TransmissionChannelType::ReliableOrdered );
+		if ( transmissionChannel == nullptr )
+		{
+			return false;
+		}
+
+		return static_cast< ReliableOrderedChannel* >( transmissionChannel )->SetAckWindowSize( ack_window_size );
+	}
+
 	bool RemotePeer::AddReceivedMessage( std::unique_ptr< Message > message )
 	{
 		bool result = false;
@@ -19,7 +19,7 @@ namespace NetLib
 {
 	class Message;
 	struct MessageHeader;
-	class Socket;
+	class DatagramSendQueue;
 	class MessageFactory;
 
 	enum class RemotePeerState : uint8
@@ -39,6 +39,8 @@ namespace NetLib
 			float32 _inactivityTimeLeft;
 			uint64 _clientSalt;
 			uint64 _serverSalt;
+			// Index of the socket shard the traffic of this remote peer arrives on
+			uint32 _socketShardIndex;
 
 			// TODO Unused variable. Remove it
 			uint16 _nextPacketSequenceNumber;
@@ -81,7 +83,7 @@ namespace NetLib
 
 			void Tick( float32 elapsedTime, MessageFactory& message_factory );
 
-			void SendData( Socket& socket );
+			void SendData( DatagramSendQueue& send_queue );
 
 			const Address& GetAddress() const { return _address; }
 			uint16 GetClientIndex() const { return _id; }
@@ -95,14 +97,28 @@ namespace NetLib
 
 			const TransmissionChannel* GetTransmissionChannelFromType( TransmissionChannelType channelType ) const;
 
+			/// <summary>
+			/// Sets the ACK window negotiated with this remote peer during the connection pipeline. It is used by the
+			/// reliable transmission channel. Returns false if the size is not valid.
+			/// </summary>
+			bool SetAckWindowSize( uint32 ack_window_size );
+
 			void SetServerSalt( uint64 newValue ) { _serverSalt = newValue; }
 
+			/// <summary>
+			/// Socket shard the data of this remote peer is sent from. It is the one its traffic arrives on, so the
+			/// remote peer is handled by a single shard in both directions.
+			/// </summary>
+			uint32 GetSocketShardIndex() const { return _socketShardIndex; }
+			void SetSocketShardIndex( uint32 socket_shard_index ) { _socketShardIndex = socket_shard_index; }
+
 			bool IsAddressEqual( const Address& other ) const { return other == _address; }
 			bool IsInactive() const { return _inactivityTimeLeft == 0.f; }
 			bool AddMessage( std::unique_ptr< Message > message );
 			void FreeProcessedMessages();
 			void ProcessPacket( NetworkPacket& packet );
-			void ProcessACKs( uint32 acks, uint16 lastAckedMessageSequenceNumber, TransmissionChannelType channelType );
+			void ProcessACKs( const AckBitfield& acks, uint16 lastAckedMessageSequenceNumber,
+			                  TransmissionChannelType channelType );
 			bool AddReceivedMessage( std::unique_ptr< Message > message );
 
 			bool ArePendingReadyToProcessMessages() const;
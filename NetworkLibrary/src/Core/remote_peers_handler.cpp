@@ -19,14 +19,19 @@ namespace NetLib
 		ASSERT( max_connections > 0, "The maximum number of connections has to be greater than zero." );
 
 		_maxConnections = max_connections;
-		_remotePeerSlots.reserve( _maxConnections );
 		_remotePeers.reserve( _maxConnections );
+		_freeSlots.reserve( _maxConnections );
 		_validRemotePeers.reserve( _maxConnections );
+		_validRemotePeerIndices.assign( _maxConnections, INVALID_INDEX );
+		_slotsByAddress.reserve( _maxConnections );
+		_slotsById.reserve( _maxConnections );
 
 		for ( uint32 i = 0; i < _maxConnections; ++i )
 		{
-			_remotePeerSlots.push_back( false ); // You could use vector.resize in these ones.
 			_remotePeers.emplace_back( message_factory );
+
+			// Pushed in reverse order so lower slots are used first
+			_freeSlots.push_back( _maxConnections - 1 - i );
 		}
 
 		_isInitialized = true;
@@ -36,17 +41,14 @@ namespace NetLib
 	{
 		ASSERT( _isInitialized, "Remote peers handler is not initialized." );
 
-		for ( uint32 i = 0; i < _maxConnections; ++i )
+		for ( auto it = _validRemotePeers.begin(); it != _validRemotePeers.end(); ++it )
 		{
-			if ( _remotePeerSlots[ i ] )
-			{
-				_remotePeers[ i ].Tick( elapsedTime, message_factory );
+			( *it )->Tick( elapsedTime, message_factory );
 
-				// Start the disconnection process for those ones who are inactive
-				if ( _remotePeers[ i ].IsInactive() )
-				{
-					// StartDisconnectingRemotePeer(i, true, ConnectionFailedReasonType::CFR_TIMEOUT);
-				}
+			// Start the disconnection process for those ones who are inactive
+			if ( ( *it )->IsInactive() )
+			{
+				// StartDisconnectingRemotePeer(i, true, ConnectionFailedReasonType::CFR_TIMEOUT);
 			}
 		}
 	}
@@ -64,11 +66,18 @@ namespace NetLib
 			return false;
 		}
 
-		_remotePeerSlots[ slotIndex ] = true;
+		if ( IsRemotePeerAlreadyConnected( addressInfo ) || DoesRemotePeerIdExist( id ) )
+		{
+			return false;
+		}
+
+		_freeSlots.pop_back();
 		_remotePeers[ slotIndex ].Connect( addressInfo, id, REMOTE_PEER_INACTIVITY_TIME, clientSalt, serverSalt );
 
-		auto it = _validRemotePeers.insert( &( _remotePeers[ slotIndex ] ) );
-		assert( it.second ); // If the element was already there it means that we are trying to add it again. ERROR!!
+		_validRemotePeerIndices[ slotIndex ] = static_cast< uint32 >( _validRemotePeers.size() );
+		_validRemotePeers.push_back( &( _remotePeers[ slotIndex ] ) );
+		_slotsByAddress.emplace( addressInfo, slotIndex );
+		_slotsById.emplace( id, slotIndex );
 		return true;
 	}
 
@@ -93,121 +102,65 @@ namespace NetLib
 	{
 		ASSERT( _isInitialized, "Remote peers handler is not initialized." );
 
-		int32 freeIndex = -1;
-		for ( uint32 i = 0; i < _maxConnections; ++i )
+		if ( _freeSlots.empty() )
 		{
-			if ( !_remotePeerSlots[ i ] )
-			{
-				freeIndex = i;
-				break;
-			}
+			return -1;
 		}
 
-		return freeIndex;
+		return static_cast< int32 >( _freeSlots.back() );
 	}
 
 	uint32 RemotePeersHandler::GetNumberOfAvailableRemotePeerSlots() const
 	{
 		ASSERT( _isInitialized, "Remote peers handler is not initialized." );
 
-		uint32 availableIndex = 0;
-		for ( uint32 i = 0; i < _maxConnections; ++i )
-		{
-			if ( !_remotePeerSlots[ i ] )
-			{
-				++availableIndex;
-			}
-		}
-
-		return availableIndex;
+		return static_cast< uint32 >( _freeSlots.size() );
 	}
 
 	RemotePeer* RemotePeersHandler::GetRemotePeerFromAddress( const Address& address )
 	{
 		ASSERT( _isInitialized, "Remote peers handler is not initialized." );
 
-		RemotePeer* result = nullptr;
-		for ( uint32 i = 0; i < _maxConnections; ++i )
+		auto it = _slotsByAddress.find( address );
+		if ( it == _slotsByAddress.end() )
 		{
-			if ( !_remotePeerSlots[ i ] )
-			{
-				continue;
-			}
-
-			if ( _remotePeers[ i ].GetAddress() == address )
-			{
-				result = &_remotePeers[ i ];
-				break;
-			}
+			return nullptr;
 		}
 
-		return result;
+		return &_remotePeers[ it->second ];
 	}
 
 	RemotePeer* RemotePeersHandler::GetRemotePeerFromId( uint32 id )
 	{
 		ASSERT( _isInitialized, "Remote peers handler is not initialized." );
 
-		RemotePeer* result = nullptr;
-		for ( uint32 i = 0; i < _maxConnections; ++i )
+		const int32 index = GetIndexFromId( id );
+		if ( index == -1 )
 		{
-			if ( !_remotePeerSlots[ i ] )
-			{
-				continue;
-			}
-
-			if ( _remotePeers[ i ].GetClientIndex() == id )
-			{
-				result = &_remotePeers[ i ];
-				break;
-			}
+			return nullptr;
 		}
 
-		return result;
+		return &_remotePeers[ index ];
 	}
 
 	const RemotePeer* RemotePeersHandler::GetRemotePeerFromId( uint32 id ) const
 	{
 		ASSERT( _isInitialized, "Remote peers handler is not initialized." );
 
-		const RemotePeer* result = nullptr;
-		for ( uint32 i = 0; i < _maxConnections; ++i )
+		const int32 index = GetIndexFromId( id );
+		if ( index == -1 )
 		{
-			if ( !_remotePeerSlots[ i ] )
-			{
-				continue;
-			}
-
-			if ( _remotePeers[ i ].GetClientIndex() == id )
-			{
-				result = &_remotePeers[ i ];
-				break;
-			}
+			return nullptr;
 		}
 
-		return result;
+		return &_remotePeers[ index ];
 	}
 
 	bool RemotePeersHandler::IsRemotePeerAlreadyConnected( const Address& address ) const
 	{
 		ASSERT( _isInitialized, "Remote peers handler is not initialized." );
 
-		bool found = false;
-		for ( uint32 i = 0; i < _maxConnections; ++i )
-		{
-			if ( !_remotePeerSlots[ i ] )
-			{
-				continue;
-			}
-
-			if ( _remotePeers[ i ].GetAddress() == address )
-			{
-				found = true;
-				break;
-			}
-		}
-
-		return found;
+		return _slotsByAddress.find( address ) != _slotsByAddress.end();
 	}
 
 	bool RemotePeersHandler::DoesRemotePeerIdExist( uint32 id ) const
@@ -224,14 +177,14 @@ namespace NetLib
 		return result;
 	}
 
-	std::unordered_set< RemotePeer* >::iterator RemotePeersHandler::GetValidRemotePeersIterator()
+	std::vector< RemotePeer* >::iterator RemotePeersHandler::GetValidRemotePeersIterator()
 	{
 		ASSERT( _isInitialized, "Remote peers handler is not initialized." );
 
 		return _validRemotePeers.begin();
 	}
 
-	std::unordered_set< RemotePeer* >::iterator RemotePeersHandler::GetValidRemotePeersPastTheEndIterator()
+	std::vector< RemotePeer* >::iterator RemotePeersHandler::GetValidRemotePeersPastTheEndIterator()
 	{
 		ASSERT( _isInitialized, "Remote peers handler is not initialized." );
 
@@ -242,12 +195,10 @@ namespace NetLib
 	{
 		ASSERT( _isInitialized, "Remote peers handler is not initialized." );
 
-		for ( uint32 i = 0; i < _maxConnections; ++i )
+		// Remove from the back so the dense array does not need to move any remote peer
+		while ( !_validRemotePeers.empty() )
 		{
-			if ( _remotePeerSlots[ i ] )
-			{
-				RemoveRemotePeer( _remotePeers[ i ].GetClientIndex() );
-			}
+			RemoveRemotePeer( _validRemotePeers.back()->GetClientIndex() );
 		}
 	}
 
@@ -258,14 +209,20 @@ namespace NetLib
 		int32 id = GetIndexFromId( remotePeerId );
 		if ( id != -1 )
 		{
-			_remotePeerSlots[ id ] = false;
+			_slotsByAddress.erase( _remotePeers[ id ].GetAddress() );
+			_slotsById.erase( remotePeerId );
 			_remotePeers[ id ].Disconnect();
 
-			auto it = _validRemotePeers.find( &( _remotePeers[ id ] ) );
-			assert( it != _validRemotePeers.end() ); // If it does not exist in the valid peers and we are trying to
-			                                         // delete it, that is an ERROR!!
-			_validRemotePeers.erase( it );
+			// Move the last valid remote peer into the removed one's position to keep the array packed
+			const uint32 validIndex = _validRemotePeerIndices[ id ];
+			ASSERT( validIndex < _validRemotePeers.size(), "A connected remote peer must be within the valid ones" );
+			RemotePeer* lastValidRemotePeer = _validRemotePeers.back();
+			_validRemotePeers[ validIndex ] = lastValidRemotePeer;
+			_validRemotePeerIndices[ lastValidRemotePeer - _remotePeers.data() ] = validIndex;
+			_validRemotePeers.pop_back();
+			_validRemotePeerIndices[ id ] = INVALID_INDEX;
 
+			_freeSlots.push_back( static_cast< uint32 >( id ) );
 			return true;
 		}
 
@@ -274,19 +231,12 @@ namespace NetLib
 
 	int32 RemotePeersHandler::GetIndexFromId( uint32 id ) const
 	{
-		int32 index = -1;
-		for ( uint32 i = 0; i < _maxConnections; ++i )
+		auto it = _slotsById.find( id );
+		if ( it == _slotsById.end() )
 		{
-			if ( _remotePeerSlots[ i ] )
-			{
-				if ( _remotePeers[ i ].GetClientIndex() == id )
-				{
-					index = i;
-					break;
-				}
-			}
+			return -1;
 		}
 
-		return index;
+		return static_cast< int32 >( it->second );
 	}
 } // namespace NetLib
@@ -1,15 +1,15 @@
 #pragma once
 #include <vector>
 #include <queue>
-#include <unordered_set>
+#include <unordered_map>
 
 #include "numeric_types.h"
 
+#include "core/address.h"
 #include "core/remote_peer.h"
 
 namespace NetLib
 {
-	class Address;
 	class MessageFactory;
 
 	enum RemotePeersHandlerResult : uint8
@@ -24,6 +24,11 @@ namespace NetLib
 	// will be considered inactive and it will be disconnected with ConnectionFailedReasonType::CFR_TIMEOUT reason
 	const float32 REMOTE_PEER_INACTIVITY_TIME = 5.0f;
 
+	/// <summary>
+	/// Owns the remote peer slots of a peer. Lookups by address and by id are O(1) thanks to hashed indices, free slots
+	/// are kept in a stack and connected remote peers are kept packed in a dense array so iterating them does not
+	/// depend on the maximum number of connections.
+	/// </summary>
 	class RemotePeersHandler
 	{
 		public:
@@ -43,20 +48,31 @@ namespace NetLib
 			bool DoesRemotePeerIdExist( uint32 id ) const;
 			RemotePeersHandlerResult IsRemotePeerAbleToConnect( const Address& address ) const;
 
-			std::unordered_set< RemotePeer* >::iterator GetValidRemotePeersIterator();
-			std::unordered_set< RemotePeer* >::iterator GetValidRemotePeersPastTheEndIterator();
+			/// <summary>
+			/// Iterators over the connected remote peers. They are invalidated when a remote peer is added or removed.
+			/// </summary>
+			std::vector< RemotePeer* >::iterator GetValidRemotePeersIterator();
+			std::vector< RemotePeer* >::iterator GetValidRemotePeersPastTheEndIterator();
 
 			void RemoveAllRemotePeers();
 			bool RemoveRemotePeer( uint32 remotePeerId );
 			uint32 GetMaxConnections() const { return _maxConnections; }
 
 		private:
+			static constexpr uint32 INVALID_INDEX = 0xFFFFFFFF;
+
 			int32 GetIndexFromId( uint32 id ) const;
 
 			uint32 _maxConnections;
-			std::vector< bool > _remotePeerSlots;
 			std::vector< RemotePeer > _remotePeers;
-			std::unordered_set< RemotePeer* > _validRemotePeers;
+			// Stack of free slot indices. The top one is the next slot to use
+			std::vector< uint32 > _freeSlots;
+			// Connected remote peers packed together. Removing one moves the last one into its place
+			std::vector< RemotePeer* > _validRemotePeers;
+			// Position within _validRemotePeers of each slot. INVALID_INDEX if the slot is free
+			std::vector< uint32 > _validRemotePeerIndices;
+			std::unordered_map< Address, uint32, AddressHasher > _slotsByAddress;
+			std::unordered_map< uint32, uint32 > _slotsById;
 			bool _isInitialized;
 	};
 } // namespace NetLib
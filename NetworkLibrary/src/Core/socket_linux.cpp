@@ -0,0 +1,434 @@
+#include "socket.h"
+
+// Linux (BSD sockets + epoll) backend. The Windows backend lives in Socket.cpp
+#if defined( __linux__ )
+
+	#include "core/address.h"
+	#include "core/datagram_batch.h"
+
+	#include "logger.h"
+
+	#include <cstring>
+
+namespace NetLib
+{
+	Socket::Socket()
+	    : _listenSocket( INVALID_SOCKET_HANDLE )
+	    , _epollHandle( INVALID_SOCKET_HANDLE )
+	{
+	}
+
+	SocketResult Socket::InitializeSocketsLibrary()
+	{
+		// BSD sockets don't need any library initialization
+		return SocketResult::SOKT_SUCCESS;
+	}
+
+	int32 Socket::GetLastError() const
+	{
+		return GetLastSocketError();
+	}
+
+	bool Socket::IsValid() const
+	{
+		return !( _listenSocket == INVALID_SOCKET_HANDLE );
+	}
+
+	SocketResult Socket::SetBlockingMode( bool status )
+	{
+		if ( !IsValid() )
+		{
+			return SocketResult::SOKT_ERR;
+		}
+
+		const int32 flags = fcntl( _listenSocket, F_GETFL, 0 );
+		if ( flags == -1 )
+		{
+			LOG_ERROR( "Socket error. Error while getting the socket flags. Error code %d", GetLastError() );
+			return SocketResult::SOKT_ERR;
+		}
+
+		const int32 newFlags = status ? ( flags & ~O_NONBLOCK ) : ( flags | O_NONBLOCK );
+		const int32 iResult = fcntl( _listenSocket, F_SETFL, newFlags );
+		if ( iResult == -1 )
+		{
+			LOG_ERROR( "Socket error. Error while setting blocking mode, to %d. Error code %d", status ? 1 : 0,
+			           GetLastError() );
+			return SocketResult::SOKT_ERR;
+		}
+
+		return SocketResult::SOKT_SUCCESS;
+	}
+
+	SocketResult Socket::Create()
+	{
+		_listenSocket = socket( AF_INET, SOCK_DGRAM, IPPROTO_UDP );
+		if ( !IsValid() )
+		{
+			LOG_ERROR( "Socket error. Error while creating the socket. Error code %d", GetLastError() );
+			return SocketResult::SOKT_ERR;
+		}
+
+		_epollHandle = epoll_create1( EPOLL_CLOEXEC );
+		if ( _epollHandle == INVALID_SOCKET_HANDLE )
+		{
+			LOG_ERROR( "Socket error. Error while creating the epoll instance. Error code %d", GetLastError() );
+			return SocketResult::SOKT_ERR;
+		}
+
+		// Level triggered so the socket keeps being reported as readable while there are datagrams left in its queue
+		epoll_event event;
+		std::memset( &event, 0, sizeof( event ) );
+		event.events = EPOLLIN;
+		event.data.fd = _listenSocket;
+		const int32 iResult = epoll_ctl( _epollHandle, EPOLL_CTL_ADD, _listenSocket, &event );
+		if ( iResult == -1 )
+		{
+			LOG_ERROR( "Socket error. Error while registering the socket in the epoll instance. Error code %d",
+			           GetLastError() );
+			return SocketResult::SOKT_ERR;
+		}
+
+		return SocketResult::SOKT_SUCCESS;
+	}
+
+	SocketResult Socket::Bind( const Address& address ) const
+	{
+		if ( !IsValid() )
+		{
+			return SocketResult::SOKT_ERR;
+		}
+
+		// If address port is 0 this function will pick up a random port number
+		const int32 iResult =
+		    bind( _listenSocket, ( sockaddr* ) &address.GetSockAddr(), sizeof( address.GetSockAddr() ) );
+		if ( iResult == -1 )
+		{
+			LOG_ERROR( "Socket error. Error while binding the listen socket. Error code %d", GetLastError() );
+			return SocketResult::SOKT_ERR;
+		}
+
+		return SocketResult::SOKT_SUCCESS;
+	}
+
+	SocketResult Socket::EnableReusePort()
+	{
+		if ( !IsValid() )
+		{
+			return SocketResult::SOKT_ERR;
+		}
+
+		const int32 enable = 1;
+		const int32 iResult = setsockopt( _listenSocket, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof( enable ) );
+		if ( iResult == -1 )
+		{
+			LOG_ERROR( "Socket error. Error while enabling SO_REUSEPORT. Error code %d", GetLastError() );
+			return SocketResult::SOKT_ERR;
+		}
+
+		return SocketResult::SOKT_SUCCESS;
+	}
+
+	SocketResult Socket::Close()
+	{
+		if ( !IsValid() )
+		{
+			return SocketResult::SOKT_ERR;
+		}
+
+		if ( _epollHandle != INVALID_SOCKET_HANDLE )
+		{
+			close( _epollHandle );
+			_epollHandle = INVALID_SOCKET_HANDLE;
+		}
+
+		const int32 iResult = close( _listenSocket );
+		if ( iResult == -1 )
+		{
+			LOG_ERROR( "Socket error. Error while closing the socket. Error code %d", GetLastError() );
+			return SocketResult::SOKT_ERR;
+		}
+
+		_listenSocket = INVALID_SOCKET_HANDLE;
+
+		LOG_INFO( "Socket succesfully closed" );
+		return SocketResult::SOKT_SUCCESS;
+	}
+
+	SocketResult Socket::Start()
+	{
+		SocketResult result = SocketResult::SOKT_SUCCESS;
+
+		result = InitializeSocketsLibrary();
+		if ( result != SocketResult::SOKT_SUCCESS )
+		{
+			LOG_ERROR( "Error while starting the sockets library, aborting operation..." );
+			return result;
+		}
+
+		result = Create();
+		if ( result != SocketResult::SOKT_SUCCESS )
+		{
+			return result;
+		}
+
+		result = SetBlockingMode( false );
+		if ( result != SocketResult::SOKT_SUCCESS )
+		{
+			return result;
+		}
+
+		return SocketResult::SOKT_SUCCESS;
+	}
+
+	SocketResult Socket::ReceiveFrom( uint8* incomingDataBuffer, uint32 incomingDataBufferSize, Address& remoteAddress,
+	                                  uint32& numberOfBytesRead ) const
+	{
+		if ( incomingDataBuffer == nullptr || !IsValid() )
+		{
+			return SocketResult::SOKT_ERR;
+		}
+
+		struct sockaddr_in incomingAddress;
+		SocketAddressLength incomingAddressSize = sizeof( incomingAddress );
+		std::memset( &incomingAddress, 0, incomingAddressSize );
+
+		// If recvfrom doesn't find any data, incomingAddress will be invalid. This means that
+		// incomingAddress.sin_family will be AF_UNSPEC, IP will be 0.0.0.0 and port will be 0.
+		// MSG_TRUNC makes recvfrom return the real datagram size so truncated messages can be detected.
+		const ssize_t bytesIn = recvfrom( _listenSocket, incomingDataBuffer, incomingDataBufferSize, MSG_TRUNC,
+		                                  ( sockaddr* ) &incomingAddress, &incomingAddressSize );
+
+		remoteAddress.SetFromSockAddr( incomingAddress );
+
+		if ( bytesIn == -1 )
+		{
+			const int32 error = GetLastError();
+
+			if ( error == EAGAIN || error == EWOULDBLOCK )
+			{
+				return SocketResult::SOKT_WOULDBLOCK;
+			}
+			else if ( error == ECONNREFUSED )
+			{
+				LOG_WARNING( "Socket warning. The remote socket has been closed unexpectly." );
+				return SocketResult::SOKT_CONNRESET;
+			}
+			else
+			{
+				LOG_ERROR( "Socket error. Error while receiving a message. Error code: %d", error );
+				return SocketResult::SOKT_ERR;
+			}
+		}
+
+		if ( static_cast< uint32 >( bytesIn ) > incomingDataBufferSize )
+		{
+			LOG_ERROR( "Socket error. The message received does not fit inside the buffer." );
+			return SocketResult::SOKT_ERR;
+		}
+
+		numberOfBytesRead = static_cast< uint32 >( bytesIn );
+
+		std::string ip_and_port;
+		remoteAddress.GetFull( ip_and_port );
+		LOG_INFO( "Socket info. Data received from %s", ip_and_port.c_str() );
+
+		return SocketResult::SOKT_SUCCESS;
+	}
+
+	SocketResult Socket::SendTo( const uint8* dataBuffer, uint32 dataBufferSize, const Address& remoteAddress ) const
+	{
+		if ( dataBuffer == nullptr || !IsValid() )
+		{
+			return SocketResult::SOKT_ERR;
+		}
+
+		if ( dataBufferSize > MTU_SIZE_BYTES )
+		{
+			LOG_WARNING( "Socket warning. Trying to send a packet bigger than the MTU size theshold. This could result "
+			             "in Packet Fragmentation and as a consequence worse network conditions. Packet size: %u, MTU "
+			             "size threshold: %u",
+			             dataBufferSize, MTU_SIZE_BYTES );
+		}
+
+		const ssize_t bytesSent =
+		    sendto( _listenSocket, dataBuffer, dataBufferSize, 0, ( sockaddr* ) &remoteAddress.GetSockAddr(),
+		            sizeof( remoteAddress.GetSockAddr() ) );
+		if ( bytesSent == -1 )
+		{
+			LOG_ERROR( "Socket error. Error while sending data. Error code %d", GetLastError() );
+			return SocketResult::SOKT_ERR;
+		}
+
+		std::string ip_and_port;
+		remoteAddress.GetFull( ip_and_port );
+		LOG_INFO( "Socket info. Data sent to %s", ip_and_port.c_str() );
+
+		return SocketResult::SOKT_SUCCESS;
+	}
+
+	SocketResult Socket::ReceiveBatchFrom( DatagramBatch& batch, Address& resetRemoteAddress ) const
+	{
+		if ( !IsValid() )
+		{
+			return SocketResult::SOKT_ERR;
+		}
+
+		const uint32 freeSlots = batch._capacity - batch._count;
+		const uint32 numberOfSlots =
+		    ( freeSlots < MAX_DATAGRAMS_PER_BATCH_CALL ) ? freeSlots : MAX_DATAGRAMS_PER_BATCH_CALL;
+		if ( numberOfSlots == 0 )
+		{
+			return SocketResult::SOKT_SUCCESS;
+		}
+
+		mmsghdr messages[ MAX_DATAGRAMS_PER_BATCH_CALL ];
+		iovec ioVectors[ MAX_DATAGRAMS_PER_BATCH_CALL ];
+		sockaddr_in incomingAddresses[ MAX_DATAGRAMS_PER_BATCH_CALL ];
+		std::memset( messages, 0, sizeof( mmsghdr ) * numberOfSlots );
+		std::memset( incomingAddresses, 0, sizeof( sockaddr_in ) * numberOfSlots );
+
+		for ( uint32 i = 0; i < numberOfSlots; ++i )
+		{
+			ioVectors[ i ].iov_base = batch.GetSlotData( batch._count + i );
+			ioVectors[ i ].iov_len = batch._datagramMaxSize;
+
+			messages[ i ].msg_hdr.msg_name = &incomingAddresses[ i ];
+			messages[ i ].msg_hdr.msg_namelen = sizeof( sockaddr_in );
+			messages[ i ].msg_hdr.msg_iov = &ioVectors[ i ];
+			messages[ i ].msg_hdr.msg_iovlen = 1;
+		}
+
+		const int32 numberOfMessagesRead = recvmmsg( _listenSocket, messages, numberOfSlots, MSG_DONTWAIT, nullptr );
+		if ( numberOfMessagesRead == -1 )
+		{
+			const int32 error = GetLastError();
+
+			if ( error == EAGAIN || error == EWOULDBLOCK )
+			{
+				return SocketResult::SOKT_WOULDBLOCK;
+			}
+			else if ( error == ECONNREFUSED )
+			{
+				// Unconnected UDP sockets don't report which remote socket caused the error
+				resetRemoteAddress = Address::GetInvalid();
+				LOG_WARNING( "Socket warning. The remote socket has been closed unexpectly." );
+				return SocketResult::SOKT_CONNRESET;
+			}
+			else
+			{
+				LOG_ERROR( "Socket error. Error while receiving a batch of messages. Error code: %d", error );
+				return SocketResult::SOKT_ERR;
+			}
+		}
+
+		const uint32 firstSlotIndex = batch._count;
+		for ( int32 i = 0; i < numberOfMessagesRead; ++i )
+		{
+			if ( ( messages[ i ].msg_hdr.msg_flags & MSG_TRUNC ) != 0 )
+			{
+				LOG_ERROR( "Socket error. The message received does not fit inside the buffer. Discarding it." );
+				continue;
+			}
+
+			// Compact the batch in case a previous datagram was discarded
+			const uint32 slotIndex = batch._count;
+			if ( slotIndex != firstSlotIndex + i )
+			{
+				std::memmove( batch.GetSlotData( slotIndex ), batch.GetSlotData( firstSlotIndex + i ),
+				              messages[ i ].msg_len );
+			}
+
+			batch._sizes[ slotIndex ] = messages[ i ].msg_len;
+			batch._addresses[ slotIndex ].SetFromSockAddr( incomingAddresses[ i ] );
+			++batch._count;
+		}
+
+		LOG_INFO( "Socket info. Received a batch of %d datagrams", numberOfMessagesRead );
+		return SocketResult::SOKT_SUCCESS;
+	}
+
+	SocketResult Socket::SendBatchTo( const DatagramBatch& batch, uint32& numberOfDatagramsSent ) const
+	{
+		numberOfDatagramsSent = 0;
+
+		if ( !IsValid() )
+		{
+			return SocketResult::SOKT_ERR;
+		}
+
+		mmsghdr messages[ MAX_DATAGRAMS_PER_BATCH_CALL ];
+		iovec ioVectors[ MAX_DATAGRAMS_PER_BATCH_CALL ];
+
+		uint32 nextDatagramIndex = 0;
+		const uint32 numberOfDatagrams = batch.GetCount();
+		while ( nextDatagramIndex < numberOfDatagrams )
+		{
+			const uint32 pendingDatagrams = numberOfDatagrams - nextDatagramIndex;
+			const uint32 numberOfSlots =
+			    ( pendingDatagrams < MAX_DATAGRAMS_PER_BATCH_CALL ) ? pendingDatagrams : MAX_DATAGRAMS_PER_BATCH_CALL;
+			std::memset( messages, 0, sizeof( mmsghdr ) * numberOfSlots );
+
+			for ( uint32 i = 0; i < numberOfSlots; ++i )
+			{
+				const uint32 datagramIndex = nextDatagramIndex + i;
+				ioVectors[ i ].iov_base = const_cast< uint8* >( batch.GetDatagramData( datagramIndex ) );
+				ioVectors[ i ].iov_len = batch.GetDatagramSize( datagramIndex );
+
+				const sockaddr_in& remoteAddress = batch.GetDatagramAddress( datagramIndex ).GetSockAddr();
+				messages[ i ].msg_hdr.msg_name = const_cast< sockaddr_in* >( &remoteAddress );
+				messages[ i ].msg_hdr.msg_namelen = sizeof( sockaddr_in );
+				messages[ i ].msg_hdr.msg_iov = &ioVectors[ i ];
+				messages[ i ].msg_hdr.msg_iovlen = 1;
+			}
+
+			const int32 numberOfMessagesSent = sendmmsg( _listenSocket, messages, numberOfSlots, 0 );
+			if ( numberOfMessagesSent == -1 )
+			{
+				// The first datagram of this call failed. Skip it so a single bad datagram doesn't block the rest
+				LOG_ERROR( "Socket error. Error while sending data. Error code %d", GetLastError() );
+				++nextDatagramIndex;
+			}
+			else
+			{
+				numberOfDatagramsSent += static_cast< uint32 >( numberOfMessagesSent );
+				nextDatagramIndex += static_cast< uint32 >( numberOfMessagesSent );
+			}
+		}
+
+		LOG_INFO( "Socket info. Sent a batch of %u datagrams", numberOfDatagramsSent );
+		return ( numberOfDatagramsSent == numberOfDatagrams ) ? SocketResult::SOKT_SUCCESS : SocketResult::SOKT_ERR;
+	}
+
+	SocketResult Socket::WaitForIncomingData( uint32 timeoutMilliseconds ) const
+	{
+		if ( !IsValid() || _epollHandle == INVALID_SOCKET_HANDLE )
+		{
+			return SocketResult::SOKT_ERR;
+		}
+
+		epoll_event event;
+		const int32 numberOfReadyEvents =
+		    epoll_wait( _epollHandle, &event, 1, static_cast< int32 >( timeoutMilliseconds ) );
+		if ( numberOfReadyEvents == -1 )
+		{
+			const int32 error = GetLastError();
+			if ( error == EINTR )
+			{
+				return SocketResult::SOKT_WOULDBLOCK;
+			}
+
+			LOG_ERROR( "Socket error. Error while waiting for incoming data. Error code %d", error );
+			return SocketResult::SOKT_ERR;
+		}
+
+		return ( numberOfReadyEvents > 0 ) ? SocketResult::SOKT_SUCCESS : SocketResult::SOKT_WOULDBLOCK;
+	}
+
+	Socket::~Socket()
+	{
+		Close();
+	}
+} // namespace NetLib
+
+#endif
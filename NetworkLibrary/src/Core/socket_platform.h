@@ -0,0 +1,43 @@
+#pragma once
+#include "numeric_types.h"
+
+// Platform specific sockets headers and types. The socket backend is selected at compile time based on the target
+// platform: winsock2 on Windows and BSD sockets + epoll on Linux.
+#if defined( _WIN32 )
+	#include <winsock2.h>
+	#include <ws2tcpip.h>
+#elif defined( __linux__ )
+	#include <sys/types.h>
+	#include <sys/socket.h>
+	#include <sys/epoll.h>
+	#include <netinet/in.h>
+	#include <arpa/inet.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <errno.h>
+#else
+	#error "Unsupported platform. The network library only supports Windows and Linux sockets backends."
+#endif
+
+namespace NetLib
+{
+#if defined( _WIN32 )
+	typedef SOCKET SocketHandle;
+	constexpr SocketHandle INVALID_SOCKET_HANDLE = INVALID_SOCKET;
+	typedef int32 SocketAddressLength;
+
+	inline int32 GetLastSocketError()
+	{
+		return WSAGetLastError();
+	}
+#elif defined( __linux__ )
+	typedef int32 SocketHandle;
+	constexpr SocketHandle INVALID_SOCKET_HANDLE = -1;
+	typedef socklen_t SocketAddressLength;
+
+	inline int32 GetLastSocketError()
+	{
+		return errno;
+	}
+#endif
+} // namespace NetLib
@@ -0,0 +1,113 @@
+#include "ack_bitfield.h"
+
+#include "logger.h"
+#include "asserts.h"
+
+#include "core/buffer.h"
+
+#include "utils/bitwise_utils.h"
+
+namespace NetLib
+{
+	AckBitfield::AckBitfield()
+	    : _numberOfWords( 0 )
+	{
+		Clear();
+	}
+
+	void AckBitfield::Clear()
+	{
+		for ( uint32 i = 0; i < MAX_NUMBER_OF_WORDS; ++i )
+		{
+			_words[ i ] = 0;
+		}
+
+		_numberOfWords = 0;
+	}
+
+	void AckBitfield::SetBit( uint32 index )
+	{
+		ASSERT( index < MAX_ACK_WINDOW_SIZE, "[AckBitfield.%s] Bit index %u is out of range", THIS_FUNCTION_NAME,
+		        index );
+
+		const uint32 wordIndex = index / BITS_PER_WORD;
+		BitwiseUtils::SetBitAtIndex( _words[ wordIndex ], index % BITS_PER_WORD );
+		if ( wordIndex >= _numberOfWords )
+		{
+			_numberOfWords = static_cast< uint8 >( wordIndex + 1 );
+		}
+	}
+
+	bool AckBitfield::GetBit( uint32 index ) const
+	{
+		const uint32 wordIndex = index / BITS_PER_WORD;
+		if ( wordIndex >= _numberOfWords )
+		{
+			return false;
+		}
+
+		return BitwiseUtils::GetBitAtIndex( _words[ wordIndex ], index % BITS_PER_WORD );
+	}
+
+	void AckBitfield::Write( Buffer& buffer ) const
+	{
+		buffer.WriteByte( _numberOfWords );
+		for ( uint32 i = 0; i < _numberOfWords; ++i )
+		{
+			buffer.WriteInteger( _words[ i ] );
+		}
+	}
+
+	bool AckBitfield::Read( Buffer& buffer )
+	{
+		Clear();
+
+		uint8 numberOfWords = 0;
+		if ( !buffer.ReadByte( numberOfWords ) )
+		{
+			return false;
+		}
+
+		if ( numberOfWords > MAX_NUMBER_OF_WORDS )
+		{
+			LOG_ERROR( "[AckBitfield.%s] Invalid number of ACK words %hhu. Max: %u", THIS_FUNCTION_NAME, numberOfWords,
+			           MAX_NUMBER_OF_WORDS );
+			return false;
+		}
+
+		for ( uint32 i = 0; i < numberOfWords; ++i )
+		{
+			if ( !buffer.ReadInteger( _words[ i ] ) )
+			{
+				Clear();
+				return false;
+			}
+		}
+
+		_numberOfWords = numberOfWords;
+		return true;
+	}
+
+	uint32 AckBitfield::Size() const
+	{
+		return sizeof( uint8 ) + ( _numberOfWords * sizeof( uint32 ) );
+	}
+
+	bool AckBitfield::IsValidWindowSize( uint32 window_size )
+	{
+		const bool isPowerOfTwo = ( window_size & ( window_size - 1 ) ) == 0;
+		return isPowerOfTwo && window_size >= MIN_ACK_WINDOW_SIZE && window_size <= MAX_ACK_WINDOW_SIZE;
+	}
+
+	uint32 AckBitfield::NegotiateWindowSize( uint32 local_max_window_size, uint32 remote_max_window_size )
+	{
+		if ( !IsValidWindowSize( local_max_window_size ) || !IsValidWindowSize( remote_max_window_size ) )
+		{
+			LOG_WARNING( "[AckBitfield.%s] Invalid ACK window sizes (local: %u, remote: %u). Using %u",
+			             THIS_FUNCTION_NAME, local_max_window_size, remote_max_window_size, MIN_ACK_WINDOW_SIZE );
+			return MIN_ACK_WINDOW_SIZE;
+		}
+
+		return ( local_max_window_size < remote_max_window_size ) ? local_max_window_size : remote_max_window_size;
+	}
+} // namespace NetLib
@@ -0,0 +1,56 @@
+#pragma once
+#include "numeric_types.h"
+
+namespace NetLib
+{
+	class Buffer;
+
+	// Number of sequence numbers, older than the last acked one, that can be acked by a single packet. The window used
+	// by a connection is negotiated during the connection pipeline and it can be any power of two within this range
+	constexpr uint32 MIN_ACK_WINDOW_SIZE = 32;
+	constexpr uint32 MAX_ACK_WINDOW_SIZE = 256;
+
+	/// <summary>
+	/// ACK bits of a network packet header. Bit i acks the sequence number (last acked - 1 - i). It is serialized as
+	/// a word count followed by 32 bit words, and trailing empty words are not sent, so a wide ACK window only costs
+	/// bandwidth when there is something old to ack.
+	/// </summary>
+	class AckBitfield
+	{
+		public:
+			static constexpr uint32 BITS_PER_WORD = 32;
+			static constexpr uint32 MAX_NUMBER_OF_WORDS = MAX_ACK_WINDOW_SIZE / BITS_PER_WORD;
+
+			AckBitfield();
+
+			void Clear();
+
+			void SetBit( uint32 index );
+			bool GetBit( uint32 index ) const;
+
+			/// <summary>
+			/// Returns the number of bits that might be set. Bits beyond this number are always unset.
+			/// </summary>
+			uint32 GetNumberOfBits() const { return _numberOfWords * BITS_PER_WORD; }
+
+			void Write( Buffer& buffer ) const;
+			bool Read( Buffer& buffer );
+			uint32 Size() const;
+
+			/// <summary>
+			/// Returns true if the ACK window size is a power of two within [MIN_ACK_WINDOW_SIZE,
+			/// MAX_ACK_WINDOW_SIZE].
+			/// </summary>
+			static bool IsValidWindowSize( uint32 window_size );
+
+			/// <summary>
+			/// Returns the ACK window both peers can use given their maximums. Invalid values fall back to
+			/// MIN_ACK_WINDOW_SIZE.
+			/// </summary>
+			static uint32 NegotiateWindowSize( uint32 local_max_window_size, uint32 remote_max_window_size );
+
+		private:
+			uint32 _words[ MAX_NUMBER_OF_WORDS ];
+			uint8 _numberOfWords;
+	};
+} // namespace NetLib
@@ -1,26 +1,55 @@
 #include "message.h"
 
+#include <cstring>
+
 #include "logger.h"
 
 #include "core/buffer.h"
+#include "core/bit_writer.h"
+#include "core/bit_reader.h"
+
+#include "replication/replication_action_type.h"
 
 namespace NetLib
 {
+	constexpr uint32 REPLICATION_PACKED_FIELDS_SIZE = 2;
+
+	uint8* MessageDataStorage::Acquire( uint32 size )
+	{
+		Release();
+		if ( size <= MESSAGE_INLINE_DATA_SIZE )
+		{
+			return _inlineData;
+		}
+
+		_heapData = new uint8[ size ];
+		return _heapData;
+	}
+
+	void MessageDataStorage::Release()
+	{
+		if ( _heapData != nullptr )
+		{
+			delete[] _heapData;
+			_heapData = nullptr;
+		}
+	}
+
 	void ConnectionRequestMessage::Write( Buffer& buffer ) const
 	{
 		_header.Write( buffer );
 		buffer.WriteLong( clientSalt );
+		buffer.WriteShort( maxAckWindowSize );
 	}
 
 	bool ConnectionRequestMessage::Read( Buffer& buffer )
 	{
-		_header.type = MessageType::ConnectionRequest;
-		if ( !_header.ReadWithoutHeader( buffer ) )
+		if ( !buffer.ReadLong( clientSalt ) )
 		{
 			return false;
 		}
 
-		if ( !buffer.ReadLong( clientSalt ) )
+		if ( !buffer.ReadShort( maxAckWindowSize ) )
 		{
 			return false;
 		}
@@ -30,7 +59,7 @@ namespace NetLib
 
 	uint32 ConnectionRequestMessage::Size() const
 	{
-		return MessageHeader::Size() + sizeof( uint64 );
+		return MessageHeader::Size() + sizeof( uint64 ) + sizeof( uint16 );
 	}
 
 	void ConnectionChallengeMessage::Write( Buffer& buffer ) const
@@ -41,12 +70,6 @@ namespace NetLib
 
 	bool ConnectionChallengeMessage::Read( Buffer& buffer )
 	{
-		_header.type = MessageType::ConnectionChallenge;
-		if ( !_header.ReadWithoutHeader( buffer ) )
-		{
-			return false;
-		}
-
 		if ( !buffer.ReadLong( serverSalt ) )
 		{
 			return false;
@@ -68,12 +91,6 @@ namespace NetLib
 
 	bool ConnectionChallengeResponseMessage::Read( Buffer& buffer )
 	{
-		_header.type = MessageType::ConnectionChallengeResponse;
-		if ( !_header.ReadWithoutHeader( buffer ) )
-		{
-			return false;
-		}
-
 		if ( !buffer.ReadLong( prefix ) )
 		{
 			return false;
@@ -92,22 +109,22 @@ namespace NetLib
 		_header.Write( buffer );
 		buffer.WriteLong( prefix );
 		buffer.WriteShort( clientIndexAssigned );
+		buffer.WriteShort( ackWindowSize );
 	}
 
 	bool ConnectionAcceptedMessage::Read( Buffer& buffer )
 	{
-		_header.type = MessageType::ConnectionAccepted;
-		if ( !_header.ReadWithoutHeader( buffer ) )
+		if ( !buffer.ReadLong( prefix ) )
 		{
 			return false;
 		}
 
-		if ( !buffer.ReadLong( prefix ) )
+		if ( !buffer.ReadShort( clientIndexAssigned ) )
 		{
 			return false;
 		}
 
-		if ( !buffer.ReadShort( clientIndexAssigned ) )
+		if ( !buffer.ReadShort( ackWindowSize ) )
 		{
 			return false;
 		}
@@ -117,7 +134,7 @@ namespace NetLib
 
 	uint32 ConnectionAcceptedMessage::Size() const
 	{
-		return MessageHeader::Size() + sizeof( uint64 ) + sizeof( uint16 );
+		return MessageHeader::Size() + sizeof( uint64 ) + sizeof( uint16 ) + sizeof( uint16 );
 	}
 
 	void ConnectionDeniedMessage::Write( Buffer& buffer ) const
@@ -128,12 +145,6 @@ namespace NetLib
 
 	bool ConnectionDeniedMessage::Read( Buffer& buffer )
 	{
-		_header.type = MessageType::ConnectionDenied;
-		if ( !_header.ReadWithoutHeader( buffer ) )
-		{
-			return false;
-		}
-
 		if ( !buffer.ReadByte( reason ) )
 		{
 			return false;
@@ -156,12 +167,6 @@ namespace NetLib
 
 	bool DisconnectionMessage::Read( Buffer& buffer )
 	{
-		_header.type = MessageType::Disconnection;
-		if ( !_header.ReadWithoutHeader( buffer ) )
-		{
-			return false;
-		}
-
 		if ( !buffer.ReadLong( prefix ) )
 		{
 			return false;
@@ -188,12 +193,6 @@ namespace NetLib
 
 	bool TimeRequestMessage::Read( Buffer& buffer )
 	{
-		_header.type = MessageType::TimeRequest;
-		if ( !_header.ReadWithoutHeader( buffer ) )
-		{
-			return false;
-		}
-
 		if ( !buffer.ReadInteger( remoteTime ) )
 		{
 			return false;
@@ -216,12 +215,6 @@ namespace NetLib
 
 	bool TimeResponseMessage::Read( Buffer& buffer )
 	{
-		_header.type = MessageType::TimeResponse;
-		if ( !_header.ReadWithoutHeader( buffer ) )
-		{
-			return false;
-		}
-
 		if ( !buffer.ReadInteger( remoteTime ) )
 		{
 			return false;
@@ -243,11 +236,26 @@ namespace NetLib
 	void ReplicationMessage::Write( Buffer& buffer ) const
 	{
 		_header.Write( buffer );
-		buffer.WriteByte( replicationAction );
+
+		BitWriter writer( buffer );
+		writer.WriteRangedInteger( replicationAction, static_cast< int32 >( ReplicationActionType::CREATE ),
+		                           static_cast< int32 >( ReplicationActionType::DESTROY ) );
+		writer.WriteBool( isDeltaEncoded );
+		writer.WriteBits( dataSize, REPLICATION_DATA_SIZE_NUMBER_OF_BITS );
+		writer.Flush();
+
+		if ( replicationAction == static_cast< uint8 >( ReplicationActionType::UPDATE ) )
+		{
+			buffer.WriteShort( snapshotSequenceNumber );
+			if ( isDeltaEncoded )
+			{
+				buffer.WriteShort( baselineSnapshotSequenceNumber );
+			}
+		}
+
 		buffer.WriteInteger( networkEntityId );
 		buffer.WriteInteger( controlledByPeerId );
 		buffer.WriteInteger( replicatedClassId );
-		buffer.WriteShort( dataSize );
 		if ( dataSize > 0 )
 		{
 			buffer.WriteData( data, dataSize );
@@ -256,40 +264,65 @@ namespace NetLib
 
 	bool ReplicationMessage::Read( Buffer& buffer )
 	{
-		_header.type = MessageType::Replication;
-		if ( !_header.ReadWithoutHeader( buffer ) )
+		BitReader reader( buffer );
+		int32 action;
+		if ( !reader.ReadRangedInteger( action, static_cast< int32 >( ReplicationActionType::CREATE ),
+		                                static_cast< int32 >( ReplicationActionType::DESTROY ) ) )
 		{
 			return false;
 		}
 
-		if ( !buffer.ReadByte( replicationAction ) )
+		if ( !reader.ReadBool( isDeltaEncoded ) )
 		{
 			return false;
 		}
 
-		if ( !buffer.ReadInteger( networkEntityId ) )
+		uint32 packedDataSize;
+		if ( !reader.ReadBits( packedDataSize, REPLICATION_DATA_SIZE_NUMBER_OF_BITS ) )
 		{
 			return false;
 		}
 
-		if ( !buffer.ReadInteger( controlledByPeerId ) )
+		replicationAction = static_cast< uint8 >( action );
+		dataSize = static_cast< uint16 >( packedDataSize );
+
+		if ( replicationAction == static_cast< uint8 >( ReplicationActionType::UPDATE ) )
+		{
+			if ( !buffer.ReadShort( snapshotSequenceNumber ) )
+			{
+				return false;
+			}
+
+			if ( isDeltaEncoded && !buffer.ReadShort( baselineSnapshotSequenceNumber ) )
+			{
+				return false;
+			}
+		}
+
+		if ( !buffer.ReadInteger( networkEntityId ) )
 		{
 			return false;
 		}
 
-		if ( !buffer.ReadInteger( replicatedClassId ) )
+		if ( !buffer.ReadInteger( controlledByPeerId ) )
 		{
 			return false;
 		}
 
-		if ( !buffer.ReadShort( dataSize ) )
+		if ( !buffer.ReadInteger( replicatedClassId ) )
 		{
 			return false;
 		}
 
 		if ( dataSize > 0 )
 		{
-			data = new uint8[ dataSize ];
+			if ( dataSize > buffer.GetRemainingSize() )
+			{
+				return false;
+			}
+
+			// Received data is only referenced by this message, so it doesn't need a shared payload
+			data = _dataStorage.Acquire( dataSize );
 			if ( !buffer.ReadData( data, dataSize ) )
 			{
 				return false;
@@ -301,26 +334,69 @@ namespace NetLib
 
 	uint32 ReplicationMessage::Size() const
 	{
-		return MessageHeader::Size() + sizeof( uint8 ) + ( 3 * sizeof( uint32 ) ) + sizeof( uint16 ) +
-		       ( dataSize * sizeof( uint8 ) );
+		uint32 snapshotFieldsSize = 0;
+		if ( replicationAction == static_cast< uint8 >( ReplicationActionType::UPDATE ) )
+		{
+			snapshotFieldsSize = isDeltaEncoded ? ( 2 * sizeof( uint16 ) ) : sizeof( uint16 );
+		}
+
+		return MessageHeader::Size() + REPLICATION_PACKED_FIELDS_SIZE + snapshotFieldsSize +
+		       ( 3 * sizeof( uint32 ) ) + ( dataSize * sizeof( uint8 ) );
 	}
 
 	void ReplicationMessage::Reset()
 	{
-		if ( data != nullptr )
+		SetPayload( nullptr );
+		_dataStorage.Release();
+		snapshotSequenceNumber = 0;
+		isDeltaEncoded = false;
+		baselineSnapshotSequenceNumber = 0;
+	}
+
+	ReplicationMessage::~ReplicationMessage()
+	{
+	}
+
+	void ReplicationMessage::SetPayload( const SharedReplicationPayload& payload )
+	{
+		_payload = payload;
+		if ( _payload != nullptr )
+		{
+			data = _payload->GetData();
+			dataSize = static_cast< uint16 >( _payload->GetSize() );
+		}
+		else
 		{
-			delete[] data;
 			data = nullptr;
+			dataSize = 0;
 		}
 	}
 
-	ReplicationMessage::~ReplicationMessage()
+	void ReplicationAckMessage::Write( Buffer& buffer ) const
 	{
-		if ( data != nullptr )
+		_header.Write( buffer );
+		buffer.WriteShort( snapshotSequenceNumber );
+		buffer.WriteShort( numberOfUpdatesReceived );
+	}
+
+	bool ReplicationAckMessage::Read( Buffer& buffer )
+	{
+		if ( !buffer.ReadShort( snapshotSequenceNumber ) )
 		{
-			delete[] data;
-			data = nullptr;
+			return false;
 		}
+
+		if ( !buffer.ReadShort( numberOfUpdatesReceived ) )
+		{
+			return false;
+		}
+
+		return true;
+	}
+
+	uint32 ReplicationAckMessage::Size() const
+	{
+		return MessageHeader::Size() + ( 2 * sizeof( uint16 ) );
 	}
 
 	void InputStateMessage::Write( Buffer& buffer ) const
@@ -333,22 +409,17 @@ namespace NetLib
 
 	bool InputStateMessage::Read( Buffer& buffer )
 	{
-		_header.type = MessageType::Inputs;
-		if ( !_header.ReadWithoutHeader( buffer ) )
-		{
-			return false;
-		}
-
 		if ( !buffer.ReadShort( dataSize ) )
 		{
 			return false;
 		}
 
-		if ( dataSize > 0 )
+		if ( dataSize > buffer.GetRemainingSize() )
 		{
-			data = new uint8[ dataSize ];
+			return false;
 		}
 
+		AllocateData( dataSize );
 		if ( !buffer.ReadData( data, dataSize ) )
 		{
 			return false;
@@ -362,13 +433,96 @@ namespace NetLib
 		return MessageHeader::Size() + sizeof( uint16 ) + ( dataSize * sizeof( uint8 ) );
 	}
 
+	uint8* InputStateMessage::AllocateData( uint16 size )
+	{
+		data = _dataStorage.Acquire( size );
+		dataSize = size;
+		return data;
+	}
+
 	void InputStateMessage::Reset()
+	{
+		_dataStorage.Release();
+		data = nullptr;
+		dataSize = 0;
+	}
+
+	void FragmentMessage::Write( Buffer& buffer ) const
+	{
+		_header.Write( buffer );
+		buffer.WriteByte( fragmentIndex );
+		buffer.WriteByte( numberOfFragments );
+		buffer.WriteShort( dataSize );
+		buffer.WriteData( data, dataSize );
+	}
+
+	bool FragmentMessage::Read( Buffer& buffer )
+	{
+		if ( !buffer.ReadByte( fragmentIndex ) )
+		{
+			return false;
+		}
+
+		if ( !buffer.ReadByte( numberOfFragments ) )
+		{
+			return false;
+		}
+
+		if ( numberOfFragments == 0 || numberOfFragments > MAX_NUMBER_OF_FRAGMENTS ||
+		     fragmentIndex >= numberOfFragments )
+		{
+			LOG_ERROR( "[FragmentMessage.%s] Invalid fragment %hhu of %hhu", THIS_FUNCTION_NAME, fragmentIndex,
+			           numberOfFragments );
+			return false;
+		}
+
+		uint16 size = 0;
+		if ( !buffer.ReadShort( size ) )
+		{
+			return false;
+		}
+
+		if ( size == 0 || size > MAX_FRAGMENT_DATA_SIZE || size > buffer.GetRemainingSize() )
+		{
+			LOG_ERROR( "[FragmentMessage.%s] Invalid fragment data size %hu", THIS_FUNCTION_NAME, size );
+			return false;
+		}
+
+		delete[] data;
+		data = new uint8[ size ];
+		dataSize = size;
+		return buffer.ReadData( data, dataSize );
+	}
+
+	uint32 FragmentMessage::Size() const
+	{
+		return MessageHeader::Size() + ( 2 * sizeof( uint8 ) ) + sizeof( uint16 ) + ( dataSize * sizeof( uint8 ) );
+	}
+
+	void FragmentMessage::SetData( const uint8* fragment_data, uint16 size )
+	{
+		delete[] data;
+		data = new uint8[ size ];
+		std::memcpy( data, fragment_data, size );
+		dataSize = size;
+	}
+
+	void FragmentMessage::Reset()
 	{
 		if ( data != nullptr )
 		{
 			delete[] data;
 			data = nullptr;
 		}
+
+		dataSize = 0;
+		fragmentIndex = 0;
+		numberOfFragments = 0;
+	}
+
+	FragmentMessage::~FragmentMessage()
+	{
+		Reset();
 	}
 
 	void PingPongMessage::Write( Buffer& buffer ) const
@@ -378,12 +532,6 @@ namespace NetLib
 
 	bool PingPongMessage::Read( Buffer& buffer )
 	{
-		_header.type = MessageType::PingPong;
-		if ( !_header.ReadWithoutHeader( buffer ) )
-		{
-			return false;
-		}
-
 		return true;
 	}
 
@@ -3,8 +3,53 @@
 
 #include "communication/message_header.h"
 
+#include "replication/replication_payload.h"
+
 namespace NetLib
 {
+	// Bytes of the serialized message carried by each fragment. Reliable messages bigger than this are split into
+	// fragments, since they might not fit in a single packet
+	constexpr uint32 MAX_FRAGMENT_DATA_SIZE = 1024;
+	// Maximum number of fragments of a message. It bounds the memory needed to reassemble it
+	constexpr uint32 MAX_NUMBER_OF_FRAGMENTS = 64;
+	// Payloads up to this size are stored inside the message instead of in a heap buffer
+	constexpr uint32 MESSAGE_INLINE_DATA_SIZE = 64;
+	// Replication action, delta flag and data size are bit packed together into 2 bytes. Replication messages bigger
+	// than a packet are fragmented by the reliable channel, so the data size uses all the bits left
+	constexpr uint32 REPLICATION_DATA_SIZE_NUMBER_OF_BITS = 13;
+	// Maximum size in bytes of a replicated entity state, set by its data size field. Bigger states can't be
+	// replicated. Updates are unreliable and can't be fragmented, so the update of a state is only delivered if it also
+	// fits in a single packet together with the packet and message headers
+	constexpr uint32 MAX_REPLICATION_DATA_SIZE = ( 1 << REPLICATION_DATA_SIZE_NUMBER_OF_BITS ) - 1;
+
+	/// <summary>
+	/// Payload storage of a message. Small payloads are stored inline, so pooled messages carry them without
+	/// allocating. Bigger ones spill to a heap buffer that is freed on Release.
+	/// </summary>
+	class MessageDataStorage
+	{
+		public:
+			MessageDataStorage()
+			    : _heapData( nullptr )
+			{
+			}
+
+			MessageDataStorage( const MessageDataStorage& ) = delete;
+			MessageDataStorage& operator=( const MessageDataStorage& ) = delete;
+
+			~MessageDataStorage() { Release(); }
+
+			/// <summary>
+			/// Returns a buffer of at least size bytes. The previous content is lost.
+			/// </summary>
+			uint8* Acquire( uint32 size );
+			void Release();
+
+		private:
+			uint8 _inlineData[ MESSAGE_INLINE_DATA_SIZE ];
+			uint8* _heapData;
+	};
+
 	class Message
 	{
 		public:
@@ -15,9 +60,10 @@ namespace NetLib
 			}
 			void SetReliability( bool isReliable ) { _header.isReliable = isReliable; };
 			void SetOrdered( bool isOrdered ) { _header.isOrdered = isOrdered; }
+			void SetHeader( const MessageHeader& header ) { _header = header; }
 
 			virtual void Write( Buffer& buffer ) const = 0;
-			// Read it without the message header type
+			// Read it without the message header. The header is read by MessageUtils::ReadMessage
 			virtual bool Read( Buffer& buffer ) = 0;
 			virtual uint32 Size() const = 0;
 
@@ -28,9 +74,16 @@ namespace NetLib
 
 		protected:
 			Message( MessageType messageType )
-			    : _header( messageType, 0, false, false ) {};
+			    : _header( messageType, 0, false, false )
+			    , _nextFreeMessage( nullptr ) {};
 
 			MessageHeader _header;
+
+		private:
+			friend class MessageFactory;
+
+			// Next message in the MessageFactory free list. Only used while the message is not lent
+			Message* _nextFreeMessage;
 	};
 
 	class ConnectionRequestMessage : public Message
@@ -38,6 +91,7 @@ namespace NetLib
 		public:
 			ConnectionRequestMessage()
 			    : clientSalt( 0 )
+			    , maxAckWindowSize( 0 )
 			    , Message( MessageType::ConnectionRequest )
 			{
 			}
@@ -49,6 +103,8 @@ namespace NetLib
 			~ConnectionRequestMessage() override {};
 
 			uint64 clientSalt;
+			// Biggest reliable ACK window the client supports. See AckBitfield
+			uint16 maxAckWindowSize;
 	};
 
 	class ConnectionChallengeMessage : public Message
@@ -93,6 +149,7 @@ namespace NetLib
 			ConnectionAcceptedMessage()
 			    : prefix( 0 )
 			    , clientIndexAssigned( 0 )
+			    , ackWindowSize( 0 )
 			    , Message( MessageType::ConnectionAccepted )
 			{
 			}
@@ -105,6 +162,8 @@ namespace NetLib
 
 			uint64 prefix;
 			uint16 clientIndexAssigned;
+			// Reliable ACK window negotiated by the server. See AckBitfield
+			uint16 ackWindowSize;
 	};
 
 	class ConnectionDeniedMessage : public Message
@@ -191,8 +250,13 @@ namespace NetLib
 			    , networkEntityId( 0 )
 			    , controlledByPeerId( 0 )
 			    , replicatedClassId( 0 )
+			    , snapshotSequenceNumber( 0 )
+			    , isDeltaEncoded( false )
+			    , baselineSnapshotSequenceNumber( 0 )
 			    , dataSize( 0 )
 			    , data( nullptr )
+			    , _payload()
+			    , _dataStorage()
 			    , Message( MessageType::Replication )
 			{
 			}
@@ -210,8 +274,49 @@ namespace NetLib
 			uint32 networkEntityId;
 			uint32 controlledByPeerId;
 			uint32 replicatedClassId; // TODO If replication action is update or destroy, we don't care about this one
+			// Only serialized for update actions
+			uint16 snapshotSequenceNumber;
+			// If true, data is a delta against the entity state of the baseline snapshot instead of the full state
+			bool isDeltaEncoded;
+			uint16 baselineSnapshotSequenceNumber;
 			uint16 dataSize;          // TODO If replication action is destroy, we don't care about this one
-			uint8* data; // TODO Free this memory when calling MessageFactory::Release in order to avoid memory leaks
+			// Points to the payload data. It might be shared with other messages, so don't modify it. Received
+			// messages keep it in their own storage instead
+			uint8* data;
+
+			/// <summary>
+			/// Makes the message reference the payload instead of owning a copy of it. Pass nullptr to clear it.
+			/// </summary>
+			void SetPayload( const SharedReplicationPayload& payload );
+			const SharedReplicationPayload& GetPayload() const { return _payload; }
+
+		private:
+			SharedReplicationPayload _payload;
+			MessageDataStorage _dataStorage;
+	};
+
+	/// <summary>
+	/// Sent by the client to confirm how many update messages of a snapshot it has received. The server only uses a
+	/// snapshot as delta baseline once all of its update messages have been received.
+	/// </summary>
+	class ReplicationAckMessage : public Message
+	{
+		public:
+			ReplicationAckMessage()
+			    : snapshotSequenceNumber( 0 )
+			    , numberOfUpdatesReceived( 0 )
+			    , Message( MessageType::ReplicationAck )
+			{
+			}
+
+			void Write( Buffer& buffer ) const override;
+			bool Read( Buffer& buffer ) override;
+			uint32 Size() const override;
+
+			~ReplicationAckMessage() override {};
+
+			uint16 snapshotSequenceNumber;
+			uint16 numberOfUpdatesReceived;
 	};
 
 	class InputStateMessage : public Message
@@ -220,6 +325,7 @@ namespace NetLib
 			InputStateMessage()
 			    : dataSize( 0 )
 			    , data( nullptr )
+			    , _dataStorage()
 			    , Message( MessageType::Inputs )
 			{
 			}
@@ -228,8 +334,53 @@ namespace NetLib
 			bool Read( Buffer& buffer ) override;
 			uint32 Size() const override;
 
+			/// <summary>
+			/// Makes room for size bytes of input data and returns where to write them. Inputs up to
+			/// MESSAGE_INLINE_DATA_SIZE bytes don't allocate.
+			/// </summary>
+			uint8* AllocateData( uint16 size );
+
+			void Reset() override;
+
+			uint16 dataSize;
+			// Points to the message data storage. Use AllocateData to set it
+			uint8* data;
+
+		private:
+			MessageDataStorage _dataStorage;
+	};
+
+	/// <summary>
+	/// Piece of a reliable message too big to fit in a single packet. The reliable ordered channel splits the
+	/// serialized message into consecutive fragments and reads it back once the last one has been received.
+	/// </summary>
+	class FragmentMessage : public Message
+	{
+		public:
+			FragmentMessage()
+			    : fragmentIndex( 0 )
+			    , numberOfFragments( 0 )
+			    , dataSize( 0 )
+			    , data( nullptr )
+			    , Message( MessageType::Fragment )
+			{
+			}
+
+			void Write( Buffer& buffer ) const override;
+			bool Read( Buffer& buffer ) override;
+			uint32 Size() const override;
+
+			/// <summary>
+			/// Copies a piece of the serialized message into the fragment.
+			/// </summary>
+			void SetData( const uint8* fragment_data, uint16 size );
+
 			void Reset() override;
 
+			~FragmentMessage() override;
+
+			uint8 fragmentIndex;
+			uint8 numberOfFragments;
 			uint16 dataSize;
 			uint8* data;
 	};
@@ -6,8 +6,10 @@
 namespace NetLib
 {
 	MessageFactory::MessageFactory( uint32 size )
+	    : _isInitialized( false )
+	    , _initialSize( size )
+	    , _messagePools()
 	{
-		_initialSize = size;
 		InitializePools();
 		_isInitialized = true;
 	}
@@ -16,29 +18,37 @@ namespace NetLib
 	{
 		ASSERT( _isInitialized, "MessageFactory is not initialized." );
 
-		std::unique_ptr< Message > message = nullptr;
-
-		std::queue< std::unique_ptr< Message > >* pool = GetPoolFromType( messageType );
-		if ( pool == nullptr )
+		if ( messageType >= NUMBER_OF_MESSAGE_TYPES )
 		{
+			LOG_ERROR( "[MessageFactory.%s] Invalid message type %hhu", THIS_FUNCTION_NAME, messageType );
 			return nullptr;
 		}
 
-		if ( !pool->empty() )
+		MessagePool& pool = _messagePools[ messageType ];
+		if ( pool.firstFreeMessage == nullptr )
 		{
-			message = std::move( pool->front() );
-			pool->pop();
+			// Grow by a chunk instead of one message at a time, so a burst only grows the pool once
+			const uint32 growthSize =
+			    ( pool.stats.numberOfMessages / 2 > MIN_POOL_GROWTH_SIZE ) ? pool.stats.numberOfMessages / 2
+			                                                               : MIN_POOL_GROWTH_SIZE;
+			LOG_WARNING( "[MessageFactory.%s] The message pool of type %hhu is empty. Creating %u new messages... "
+			             "Consider increasing pool size. Current init size: %u",
+			             THIS_FUNCTION_NAME, messageType, growthSize, _initialSize );
+			GrowPool( pool, messageType, growthSize );
 		}
-		else
-		{
-			LOG_WARNING( "The message pool of type %hhu is empty. Creating a new message... Consider increasing pool "
-			             "size. Current init size: %u",
-			             messageType, _initialSize );
 
-			message = CreateMessage( messageType );
+		Message* message = pool.firstFreeMessage;
+		pool.firstFreeMessage = message->_nextFreeMessage;
+		message->_nextFreeMessage = nullptr;
+
+		--pool.stats.numberOfFreeMessages;
+		++pool.stats.numberOfLentMessages;
+		if ( pool.stats.numberOfLentMessages > pool.stats.maxNumberOfLentMessages )
+		{
+			pool.stats.maxNumberOfLentMessages = pool.stats.numberOfLentMessages;
 		}
 
-		return std::move( message );
+		return std::unique_ptr< Message >( message );
 	}
 
 	void MessageFactory::ReleaseMessage( std::unique_ptr< Message > message )
@@ -48,84 +58,66 @@ namespace NetLib
 
 		message->Reset();
 
-		MessageType messageType = message->GetHeader().type;
-		std::queue< std::unique_ptr< Message > >* pool = GetPoolFromType( messageType );
-		if ( pool != nullptr )
+		const MessageType messageType = message->GetHeader().type;
+		if ( messageType >= NUMBER_OF_MESSAGE_TYPES )
+		{
+			LOG_ERROR( "[MessageFactory.%s] Invalid message type %hhu. Deleting the message...", THIS_FUNCTION_NAME,
+			           messageType );
+			return;
+		}
+
+		MessagePool& pool = _messagePools[ messageType ];
+		Message* freeMessage = message.release();
+		freeMessage->_nextFreeMessage = pool.firstFreeMessage;
+		pool.firstFreeMessage = freeMessage;
+
+		++pool.stats.numberOfFreeMessages;
+		if ( pool.stats.numberOfLentMessages > 0 )
 		{
-			pool->push( std::move( message ) );
+			--pool.stats.numberOfLentMessages;
 		}
 	}
 
-	MessageFactory::~MessageFactory()
+	MessagePoolStats MessageFactory::GetPoolStats( MessageType messageType ) const
 	{
-		for ( std::unordered_map< MessageType, std::queue< std::unique_ptr< Message > > >::iterator it =
-		          _messagePools.begin();
-		      it != _messagePools.end(); ++it )
+		if ( messageType >= NUMBER_OF_MESSAGE_TYPES )
 		{
-			ReleasePool( ( *it ).second );
+			LOG_ERROR( "[MessageFactory.%s] Invalid message type %hhu", THIS_FUNCTION_NAME, messageType );
+			return MessagePoolStats();
 		}
 
-		_messagePools.clear();
+		return _messagePools[ messageType ].stats;
 	}
 
-	void MessageFactory::InitializePools()
+	MessageFactory::~MessageFactory()
 	{
-		_messagePools[ MessageType::ConnectionRequest ] = std::queue< std::unique_ptr< Message > >();
-		InitializePool( _messagePools[ MessageType::ConnectionRequest ], MessageType::ConnectionRequest );
-
-		_messagePools[ MessageType::ConnectionChallenge ] = std::queue< std::unique_ptr< Message > >();
-		InitializePool( _messagePools[ MessageType::ConnectionChallenge ], MessageType::ConnectionChallenge );
-
-		_messagePools[ MessageType::ConnectionChallengeResponse ] = std::queue< std::unique_ptr< Message > >();
-		InitializePool( _messagePools[ MessageType::ConnectionChallengeResponse ],
-		                MessageType::ConnectionChallengeResponse );
-
-		_messagePools[ MessageType::ConnectionAccepted ] = std::queue< std::unique_ptr< Message > >();
-		InitializePool( _messagePools[ MessageType::ConnectionAccepted ], MessageType::ConnectionAccepted );
-
-		_messagePools[ MessageType::ConnectionDenied ] = std::queue< std::unique_ptr< Message > >();
-		InitializePool( _messagePools[ MessageType::ConnectionDenied ], MessageType::ConnectionDenied );
-
-		_messagePools[ MessageType::Disconnection ] = std::queue< std::unique_ptr< Message > >();
-		InitializePool( _messagePools[ MessageType::Disconnection ], MessageType::Disconnection );
-
-		_messagePools[ MessageType::TimeRequest ] = std::queue< std::unique_ptr< Message > >();
-		InitializePool( _messagePools[ MessageType::TimeRequest ], MessageType::TimeRequest );
-
-		_messagePools[ MessageType::TimeResponse ] = std::queue< std::unique_ptr< Message > >();
-		InitializePool( _messagePools[ MessageType::TimeResponse ], MessageType::TimeResponse );
-
-		_messagePools[ MessageType::Replication ] = std::queue< std::unique_ptr< Message > >();
-		InitializePool( _messagePools[ MessageType::Replication ], MessageType::Replication );
-
-		_messagePools[ MessageType::Inputs ] = std::queue< std::unique_ptr< Message > >();
-		InitializePool( _messagePools[ MessageType::Inputs ], MessageType::Inputs );
-
-		_messagePools[ MessageType::PingPong ] = std::queue< std::unique_ptr< Message > >();
-		InitializePool( _messagePools[ MessageType::PingPong ], MessageType::PingPong );
+		for ( auto it = _messagePools.begin(); it != _messagePools.end(); ++it )
+		{
+			ReleasePool( *it );
+		}
 	}
 
-	void MessageFactory::InitializePool( std::queue< std::unique_ptr< Message > >& pool, MessageType messageType )
+	void MessageFactory::InitializePools()
 	{
-		for ( uint32 i = 0; i < _initialSize; ++i )
+		for ( uint32 i = 0; i < NUMBER_OF_MESSAGE_TYPES; ++i )
 		{
-			std::unique_ptr< Message > message = CreateMessage( messageType );
-			pool.push( std::move( message ) );
+			GrowPool( _messagePools[ i ], static_cast< MessageType >( i ), _initialSize );
 		}
 	}
 
-	std::queue< std::unique_ptr< Message > >* MessageFactory::GetPoolFromType( MessageType messageType )
+	void MessageFactory::GrowPool( MessagePool& pool, MessageType messageType, uint32 number_of_messages )
 	{
-		std::queue< std::unique_ptr< Message > >* resultPool = nullptr;
-
-		std::unordered_map< MessageType, std::queue< std::unique_ptr< Message > > >::iterator it =
-		    _messagePools.find( messageType );
-		if ( it != _messagePools.end() )
+		// Messages are handed out as std::unique_ptr< Message > with the default deleter, so each one must be
+		// allocated on its own. Otherwise, deleting a message instead of releasing it would corrupt the heap
+		for ( uint32 i = 0; i < number_of_messages; ++i )
 		{
-			resultPool = &( *it ).second;
+			Message* message = CreateMessage( messageType ).release();
+			message->_nextFreeMessage = pool.firstFreeMessage;
+			pool.firstFreeMessage = message;
 		}
 
-		return resultPool;
+		pool.stats.numberOfMessages += number_of_messages;
+		pool.stats.numberOfFreeMessages += number_of_messages;
 	}
 
 	std::unique_ptr< Message > MessageFactory::CreateMessage( MessageType messageType )
@@ -167,6 +159,12 @@ namespace NetLib
 			case MessageType::PingPong:
 				resultMessage = std::make_unique< PingPongMessage >();
 				break;
+			case MessageType::ReplicationAck:
+				resultMessage = std::make_unique< ReplicationAckMessage >();
+				break;
+			case MessageType::Fragment:
+				resultMessage = std::make_unique< FragmentMessage >();
+				break;
 			default:
 				LOG_ERROR( "Can't create a new message. Invalid message type" );
 				break;
@@ -177,11 +175,16 @@ namespace NetLib
 		return std::move( resultMessage );
 	}
 
-	void MessageFactory::ReleasePool( std::queue< std::unique_ptr< Message > >& pool )
+	void MessageFactory::ReleasePool( MessagePool& pool )
 	{
-		while ( !pool.empty() )
+		// Lent messages are owned by whoever holds them, so only the free ones are deleted
+		while ( pool.firstFreeMessage != nullptr )
 		{
-			pool.pop();
+			Message* message = pool.firstFreeMessage;
+			pool.firstFreeMessage = message->_nextFreeMessage;
+			delete message;
 		}
+
+		pool.stats.numberOfFreeMessages = 0;
 	}
 } // namespace NetLib
@@ -1,18 +1,32 @@
 #pragma once
-#include <queue>
-#include <unordered_map>
+#include <array>
 #include <memory>
 
 #include "communication/message.h"
 
 namespace NetLib
 {
+	/// <summary>
+	/// Usage statistics of the pool of a message type.
+	/// </summary>
+	struct MessagePoolStats
+	{
+			// Messages created by the pool so far, both lent and free
+			uint32 numberOfMessages;
+			uint32 numberOfFreeMessages;
+			uint32 numberOfLentMessages;
+			// High-water mark of messages lent at the same time. Use it to tune the initial size of the pools
+			uint32 maxNumberOfLentMessages;
+	};
+
 	class MessageFactory
 	{
 		public:
 			std::unique_ptr< Message > LendMessage( MessageType messageType );
 			void ReleaseMessage( std::unique_ptr< Message > message );
 
+			MessagePoolStats GetPoolStats( MessageType messageType ) const;
+
 			MessageFactory( uint32 size );
 			MessageFactory( const MessageFactory& ) = delete;
 
@@ -21,15 +35,36 @@ namespace NetLib
 			MessageFactory& operator=( const MessageFactory& ) = delete;
 
 		private:
+			/// <summary>
+			/// Intrusive free list of the messages of a type, linked through Message::_nextFreeMessage, so lending and
+			/// releasing a message never allocates.
+			/// </summary>
+			struct MessagePool
+			{
+					MessagePool()
+					    : firstFreeMessage( nullptr )
+					    , stats()
+					{
+					}
+
+					Message* firstFreeMessage;
+					MessagePoolStats stats;
+			};
+
+			/// <summary>
+			/// Minimum number of messages created at once when a pool runs out of messages
+			/// </summary>
+			const uint32 MIN_POOL_GROWTH_SIZE = 16;
+
 			void InitializePools();
-			void InitializePool( std::queue< std::unique_ptr< Message > >& pool, MessageType messageType );
-			std::queue< std::unique_ptr< Message > >* GetPoolFromType( MessageType messageType );
+			void GrowPool( MessagePool& pool, MessageType messageType, uint32 number_of_messages );
 			std::unique_ptr< Message > CreateMessage( MessageType messageType );
-			void ReleasePool( std::queue< std::unique_ptr< Message > >& pool );
+			void ReleasePool( MessagePool& pool );
 
 			bool _isInitialized;
 			uint32 _initialSize;
 
-			std::unordered_map< MessageType, std::queue< std::unique_ptr< Message > > > _messagePools;
+			// Pools indexed by message type
+			std::array< MessagePool, NUMBER_OF_MESSAGE_TYPES > _messagePools;
 	};
 } // namespace NetLib
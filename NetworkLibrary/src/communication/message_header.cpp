@@ -1,52 +1,49 @@
 #include "message_header.h"
 
 #include "core/buffer.h"
-
-#include "utils/bitwise_utils.h"
+#include "core/bit_writer.h"
+#include "core/bit_reader.h"
 
 namespace NetLib
 {
 	void MessageHeader::Write( Buffer& buffer ) const
 	{
-		buffer.WriteByte( type );
-		buffer.WriteShort( messageSequenceNumber );
+		BitWriter writer( buffer );
+		writer.WriteBits( type, MESSAGE_TYPE_NUMBER_OF_BITS );
+		writer.WriteBool( isReliable );
+		writer.WriteBool( isOrdered );
+		writer.WriteBits( messageSequenceNumber, 16 );
+		writer.Flush();
+	}
+
+	bool MessageHeader::Read( Buffer& buffer )
+	{
+		BitReader reader( buffer );
 
-		uint8 flags = 0;
-		if ( isReliable )
+		uint32 messageType;
+		if ( !reader.ReadBits( messageType, MESSAGE_TYPE_NUMBER_OF_BITS ) )
 		{
-			BitwiseUtils::SetBitAtIndex( flags, 0 );
+			return false;
 		}
 
-		if ( isOrdered )
+		if ( !reader.ReadBool( isReliable ) )
 		{
-			BitwiseUtils::SetBitAtIndex( flags, 1 );
+			return false;
 		}
 
-		buffer.WriteByte( flags );
-	}
-
-	void MessageHeader::Read( Buffer& buffer )
-	{
-		type = static_cast< MessageType >( buffer.ReadByte() );
-		ReadWithoutHeader( buffer );
-	}
-
-	bool MessageHeader::ReadWithoutHeader( Buffer& buffer )
-	{
-		if ( !buffer.ReadShort( messageSequenceNumber ) )
+		if ( !reader.ReadBool( isOrdered ) )
 		{
 			return false;
 		}
 
-		uint8 flags;
-		if ( !buffer.ReadByte( flags ) )
+		uint32 sequenceNumber;
+		if ( !reader.ReadBits( sequenceNumber, 16 ) )
 		{
 			return false;
 		}
 
-		isReliable = BitwiseUtils::GetBitAtIndex( flags, 0 );
-		isOrdered = BitwiseUtils::GetBitAtIndex( flags, 1 );
-
+		type = static_cast< MessageType >( messageType );
+		messageSequenceNumber = static_cast< uint16 >( sequenceNumber );
 		return true;
 	}
 } // namespace NetLib
@@ -5,6 +5,11 @@ namespace NetLib
 {
 	class Buffer;
 
+	/// <summary>
+	/// Number of bits used to encode the message type in the header. It supports up to 64 message types.
+	/// </summary>
+	constexpr uint32 MESSAGE_TYPE_NUMBER_OF_BITS = 6;
+
 	enum MessageType : uint8
 	{
 		ConnectionRequest = 0,
@@ -17,9 +22,14 @@ namespace NetLib
 		TimeResponse = 7,
 		Replication = 8,
 		Inputs = 9,
-		PingPong = 10
+		PingPong = 10,
+		ReplicationAck = 11,
+		Fragment = 12
 	};
 
+	// Number of message types. Keep it in sync with the last MessageType
+	constexpr uint32 NUMBER_OF_MESSAGE_TYPES = MessageType::Fragment + 1;
+
 	struct MessageHeader
 	{
 			MessageHeader( MessageType messageType, uint16 packetSequenceNumber, bool isReliable, bool isOrdered )
@@ -38,10 +48,12 @@ namespace NetLib
 			{
 			}
 
+			/// <summary>
+			/// Bit packs the type, the reliability flags and the sequence number into 3 bytes.
+			/// </summary>
 			void Write( Buffer& buffer ) const;
-			void Read( Buffer& buffer );
-			bool ReadWithoutHeader( Buffer& buffer );
-			static uint32 Size() { return sizeof( MessageType ) + sizeof( uint16 ) + sizeof( uint8 ); }
+			bool Read( Buffer& buffer );
+			static uint32 Size() { return 3; }
 
 			~MessageHeader() {}
 
@@ -10,13 +10,13 @@ namespace NetLib
 {
 	std::unique_ptr< Message > MessageUtils::ReadMessage( MessageFactory& message_factory, Buffer& buffer )
 	{
-		uint8 messageType;
-		if ( !buffer.ReadByte( messageType ) )
+		MessageHeader header( MessageType::ConnectionRequest, 0, false, false );
+		if ( !header.Read( buffer ) )
 		{
 			return nullptr;
 		}
 
-		const MessageType type = static_cast< MessageType >( messageType );
+		const MessageType type = header.type;
 		std::unique_ptr< Message > message = nullptr;
 
 		switch ( type )
@@ -54,12 +54,19 @@ namespace NetLib
 			case MessageType::PingPong:
 				message = message_factory.LendMessage( MessageType::PingPong );
 				break;
+			case MessageType::ReplicationAck:
+				message = message_factory.LendMessage( MessageType::ReplicationAck );
+				break;
+			case MessageType::Fragment:
+				message = message_factory.LendMessage( MessageType::Fragment );
+				break;
 			default:
 				LOG_WARNING( "Can't read message of type MessageType = %hhu. Ignoring it...", type );
 		}
 
 		if ( message != nullptr )
 		{
+			message->SetHeader( header );
 			if ( !message->Read( buffer ) )
 			{
 				return nullptr;
@@ -20,12 +20,12 @@ namespace NetLib
 	void NetworkPacketHeader::Write( Buffer& buffer ) const
 	{
 		buffer.WriteShort( lastAckedSequenceNumber );
-		buffer.WriteInteger( ackBits );
+		ackBits.Write( buffer );
 		buffer.WriteByte( channelType );
 	}
 
 	NetworkPacket::NetworkPacket()
-	    : _header( 0, 0, 0 )
+	    : _header()
 	    , _defaultMTUSizeInBytes( 1500 )
 	{
 	}
@@ -80,7 +80,7 @@ namespace NetLib
 
 	uint32 NetworkPacket::Size() const
 	{
-		uint32 packetSize = NetworkPacketHeader::SIZE;
+		uint32 packetSize = _header.Size();
 		packetSize += 1; // We store in 1 byte the number of messages that this packet contains
 
 		auto iterator = _messages.cbegin();
@@ -4,6 +4,8 @@
 #include <vector>
 #include <memory>
 
+#include "communication/ack_bitfield.h"
+
 namespace NetLib
 {
 	class Buffer;
@@ -13,29 +15,24 @@ namespace NetLib
 	{
 			NetworkPacketHeader()
 			    : lastAckedSequenceNumber( 0 )
-			    , ackBits( 0 )
+			    , ackBits()
 			    , channelType( 0 )
 			{
 			}
 
-			NetworkPacketHeader( uint16 ack, uint32 ack_bits, uint8 channel_type )
-			    : lastAckedSequenceNumber( ack )
-			    , ackBits( ack_bits )
-			    , channelType( channel_type )
-			{
-			}
-
 			void Write( Buffer& buffer ) const;
+			uint32 Size() const { return sizeof( uint16 ) + ackBits.Size() + sizeof( uint8 ); }
 
-			void SetACKs( uint32 acks ) { ackBits = acks; };
+			void SetACKs( const AckBitfield& acks ) { ackBits = acks; };
 			void SetHeaderLastAcked( uint16 lastAckedMessage ) { lastAckedSequenceNumber = lastAckedMessage; };
 			void SetChannelType( uint8 type ) { channelType = type; };
 
 			uint16 lastAckedSequenceNumber;
-			uint32 ackBits;
+			AckBitfield ackBits;
 			uint8 channelType;
 
-			static constexpr uint32 SIZE = sizeof( uint16 ) + sizeof( uint32 ) + sizeof( uint8 );
+			// Size of a header without ACK words
+			static constexpr uint32 MIN_SIZE = sizeof( uint16 ) + sizeof( uint8 ) + sizeof( uint8 );
 	};
 
 	class NetworkPacket
@@ -66,7 +63,7 @@ namespace NetLib
 			bool CanMessageFit( uint32 sizeOfMessagesInBytes ) const;
 
 			void SetHeader( const NetworkPacketHeader& header ) { _header = header; };
-			void SetHeaderACKs( uint32 acks ) { _header.SetACKs( acks ); };
+			void SetHeaderACKs( const AckBitfield& acks ) { _header.SetACKs( acks ); };
 			void SetHeaderLastAcked( uint16 lastAckedMessage ) { _header.SetHeaderLastAcked( lastAckedMessage ); };
 			void SetHeaderChannelType( uint8 channelType ) { _header.SetChannelType( channelType ); };
 
@@ -16,7 +16,7 @@ namespace NetLib
 {
 	static bool ReadNetworkPacketHeader( Buffer& buffer, NetworkPacketHeader& out_header )
 	{
-		if ( buffer.GetRemainingSize() < NetworkPacketHeader::SIZE )
+		if ( buffer.GetRemainingSize() < NetworkPacketHeader::MIN_SIZE )
 		{
 			LOG_ERROR( "Not enough data in buffer to read Network Packet header." );
 			return false;
@@ -27,7 +27,7 @@ namespace NetLib
 			return false;
 		}
 
-		if ( !buffer.ReadInteger( out_header.ackBits ) )
+		if ( !out_header.ackBits.Read( buffer ) )
 		{
 			return false;
 		}
@@ -106,7 +106,7 @@ namespace NetLib
 
 		// Configure output packet
 		out_packet.SetHeader( header );
-		out_packet.AddMessages( std::move( messages ) );
+		out_packet.AddMessages( messages );
 		return true;
 	}
 
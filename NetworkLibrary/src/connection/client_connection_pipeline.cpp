@@ -3,6 +3,7 @@
 #include "connection/pending_connection.h"
 #include "communication/message.h"
 #include "communication/message_factory.h"
+#include "communication/ack_bitfield.h"
 
 #include "logger.h"
 
@@ -81,6 +82,17 @@ namespace NetLib
 			pending_connection.SetCurrentState( PendingConnectionState::Completed );
 			pending_connection.SetId( 0 );
 			pending_connection.SetClientSideId( message.clientIndexAssigned );
+
+			if ( AckBitfield::IsValidWindowSize( message.ackWindowSize ) )
+			{
+				pending_connection.SetAckWindowSize( message.ackWindowSize );
+			}
+			else
+			{
+				LOG_WARNING( "%s Invalid ACK window size %hu received. Using %u", THIS_FUNCTION_NAME,
+				             message.ackWindowSize, MIN_ACK_WINDOW_SIZE );
+				pending_connection.SetAckWindowSize( MIN_ACK_WINDOW_SIZE );
+			}
 		}
 
 		static void ProcessConnectionDenied( PendingConnection& pending_connection,
@@ -126,7 +138,8 @@ namespace NetLib
 		}
 
 		static std::unique_ptr< Message > CreateConnectionRequestMessage( MessageFactory& message_factory,
-		                                                                  uint64 client_salt )
+		                                                                  uint64 client_salt,
+		                                                                  uint32 max_ack_window_size )
 		{
 			// Get a connection challenge message
 			std::unique_ptr< Message > message = message_factory.LendMessage( MessageType::ConnectionRequest );
@@ -143,6 +156,7 @@ namespace NetLib
 
 			// Set connection request fields
 			connectionRequestMessage->clientSalt = client_salt;
+			connectionRequestMessage->maxAckWindowSize = static_cast< uint16 >( max_ack_window_size );
 
 			return connectionRequestMessage;
 		}
@@ -168,8 +182,8 @@ namespace NetLib
 			}
 
 			// Create connection request
-			std::unique_ptr< Message > connectionRequestMessage =
-			    CreateConnectionRequestMessage( message_factory, pending_connection.GetClientSalt() );
+			std::unique_ptr< Message > connectionRequestMessage = CreateConnectionRequestMessage(
+			    message_factory, pending_connection.GetClientSalt(), pending_connection.GetAckWindowSize() );
 
 			// Add message to pending connection
 			pending_connection.AddMessage( std::move( connectionRequestMessage ) );
@@ -21,6 +21,7 @@ namespace NetLib
 		    , _connectionTimeoutSeconds( 0.f )
 		    , _canStartConnections( false )
 		    , _sendDenialOnTimeout( false )
+		    , _maxAckWindowSize( MIN_ACK_WINDOW_SIZE )
 		{
 		}
 
@@ -48,6 +49,7 @@ namespace NetLib
 				_canStartConnections = configuration.canStartConnections;
 				_connectionTimeoutSeconds = configuration.connectionTimeoutSeconds;
 				_sendDenialOnTimeout = configuration.sendDenialOnTimeout;
+				_maxAckWindowSize = configuration.maxAckWindowSize;
 
 				_isStartedUp = true;
 			}
@@ -70,7 +72,7 @@ namespace NetLib
 			}
 
 			// Shut down all pending connections
-			for ( auto& it = _pendingConnections.begin(); it != _pendingConnections.end(); ++it )
+			for ( auto it = _pendingConnections.begin(); it != _pendingConnections.end(); ++it )
 			{
 				if ( !it->second.ShutDown() )
 				{
@@ -103,7 +105,7 @@ namespace NetLib
 				return;
 			}
 
-			for ( auto& it = _pendingConnections.begin(); it != _pendingConnections.end(); ++it )
+			for ( auto it = _pendingConnections.begin(); it != _pendingConnections.end(); ++it )
 			{
 				PendingConnection& pc = it->second;
 				_connectionPipeline->ProcessConnection( pc, *_messageFactory, elapsed_time );
@@ -173,7 +175,11 @@ namespace NetLib
 					// Create and start up
 					_pendingConnections.try_emplace( address, _messageFactory );
 					success = _pendingConnections[ address ].StartUp( address, started_locally );
-					if ( !success )
+					if ( success )
+					{
+						_pendingConnections[ address ].SetAckWindowSize( _maxAckWindowSize );
+					}
+					else
 					{
 						_pendingConnections.erase( address );
 
@@ -248,13 +254,14 @@ namespace NetLib
 				return;
 			}
 
-			for ( auto& cit = _pendingConnections.cbegin(); cit != _pendingConnections.cend(); ++cit )
+			for ( auto cit = _pendingConnections.cbegin(); cit != _pendingConnections.cend(); ++cit )
 			{
 				const PendingConnection& pc = cit->second;
 				if ( pc.GetCurrentState() == PendingConnectionState::Completed )
 				{
 					out_success_connections.emplace_back( pc.GetAddress(), pc.WasStartedLocally(), pc.GetId(),
-					                                      pc.GetClientSideId(), pc.GetDataPrefix() );
+					                                      pc.GetClientSideId(), pc.GetDataPrefix(),
+					                                      pc.GetAckWindowSize() );
 				}
 			}
 		}
@@ -290,7 +297,7 @@ namespace NetLib
 				return;
 			}
 
-			for ( auto& cit = _pendingConnections.cbegin(); cit != _pendingConnections.cend(); ++cit )
+			for ( auto cit = _pendingConnections.cbegin(); cit != _pendingConnections.cend(); ++cit )
 			{
 				const PendingConnection& pc = cit->second;
 				if ( pc.GetCurrentState() == PendingConnectionState::Failed )
@@ -322,11 +329,11 @@ namespace NetLib
 			}
 		}
 
-		void ConnectionManager::SendData( Socket& socket )
+		void ConnectionManager::SendData( DatagramSendQueue& send_queue )
 		{
 			for ( auto it = _pendingConnections.begin(); it != _pendingConnections.end(); ++it )
 			{
-				it->second.SendData( socket );
+				it->second.SendData( send_queue );
 			}
 		}
 
@@ -21,7 +21,7 @@
 */
 namespace NetLib
 {
-	class Socket;
+	class DatagramSendQueue;
 	class NetworkPacket;
 	class RemotePeersHandler;
 	class MessageFactory;
@@ -40,17 +40,21 @@ namespace NetLib
 				bool sendDenialOnTimeout;
 				// The connection pipeline to use for processing connection states and messages.
 				IConnectionPipeline* connectionPipeline;
+				// Biggest reliable ACK window supported. The one used by each connection is negotiated with the remote
+				// peer. See AckBitfield::IsValidWindowSize.
+				uint32 maxAckWindowSize;
 		};
 
 		struct SuccessConnectionData
 		{
 				SuccessConnectionData( const Address& address, bool started_locally, uint16 id, uint16 client_side_id,
-				                       uint64 data_prefix )
+				                       uint64 data_prefix, uint32 ack_window_size )
 				    : address( address )
 				    , startedLocally( started_locally )
 				    , id( id )
 				    , clientSideId( client_side_id )
 				    , dataPrefix( data_prefix )
+				    , ackWindowSize( ack_window_size )
 				{
 				}
 
@@ -62,6 +66,8 @@ namespace NetLib
 				// server and the server assigns an ID to this client's local peer)
 				uint16 clientSideId;
 				uint64 dataPrefix;
+				// The reliable ACK window negotiated during the connection pipeline
+				uint32 ackWindowSize;
 		};
 
 		struct FailedConnectionData
@@ -133,9 +139,9 @@ namespace NetLib
 				/*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 				/	brief: Sends the pending connection-related messages, if any, to the remote connections.
 				/
-				/	param socket: The socket used to transmit the data through
+				/	param send_queue: The queue of outgoing datagrams used to transmit the data through
 				>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
-				void SendData( Socket& socket );
+				void SendData( DatagramSendQueue& send_queue );
 
 				/*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 				/	brief: Gets all the success connections that hasn't been removed yet.
@@ -215,6 +221,7 @@ namespace NetLib
 				float32 _connectionTimeoutSeconds;
 				bool _canStartConnections;
 				bool _sendDenialOnTimeout;
+				uint32 _maxAckWindowSize;
 		};
 	} // namespace Connection
 } // namespace NetLib
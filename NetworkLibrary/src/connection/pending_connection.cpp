@@ -4,6 +4,7 @@
 #include "asserts.h"
 
 #include "communication/network_packet.h"
+#include "communication/ack_bitfield.h"
 
 namespace NetLib
 {
@@ -25,6 +26,7 @@ namespace NetLib
 		    , _id( 0 )
 		    , _clientSideId( 0 )
 		    , _connectionDeniedReason( ConnectionFailedReasonType::UNKNOWN )
+		    , _ackWindowSize( MIN_ACK_WINDOW_SIZE )
 
 		{
 		}
@@ -45,6 +47,7 @@ namespace NetLib
 		    , _id( 0 )
 		    , _clientSideId( 0 )
 		    , _connectionDeniedReason( ConnectionFailedReasonType::UNKNOWN )
+		    , _ackWindowSize( MIN_ACK_WINDOW_SIZE )
 		{
 		}
 
@@ -84,7 +87,7 @@ namespace NetLib
 		void PendingConnection::ProcessPacket( NetworkPacket& packet )
 		{
 			// Process packet ACKs
-			const uint32 acks = packet.GetHeader().ackBits;
+			const AckBitfield& acks = packet.GetHeader().ackBits;
 			const uint16 lastAckedMessageSequenceNumber = packet.GetHeader().lastAckedSequenceNumber;
 			_transmissionChannel.ProcessACKs( acks, lastAckedMessageSequenceNumber, _metricsHandler );
 
@@ -159,9 +162,9 @@ namespace NetLib
 			return result;
 		}
 
-		void PendingConnection::SendData( Socket& socket )
+		void PendingConnection::SendData( DatagramSendQueue& send_queue )
 		{
-			_transmissionChannel.CreateAndSendPacket( socket, _address, _metricsHandler );
+			_transmissionChannel.CreateAndSendPacket( send_queue, _address, _metricsHandler );
 		}
 
 		void PendingConnection::UpdateConnectionElapsedTime( float32 elapsed_time )
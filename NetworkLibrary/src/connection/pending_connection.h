@@ -9,7 +9,7 @@
 namespace NetLib
 {
 	class MessageFactory;
-	class Socket;
+	class DatagramSendQueue;
 	class NetworkPacket;
 
 	namespace Connection
@@ -39,7 +39,7 @@ namespace NetLib
 				const Message* GetPendingReadyToProcessMessage();
 				bool AddMessage( std::unique_ptr< Message > message );
 
-				void SendData( Socket& socket );
+				void SendData( DatagramSendQueue& send_queue );
 
 				void UpdateConnectionElapsedTime( float32 elapsed_time );
 
@@ -61,6 +61,8 @@ namespace NetLib
 				bool HasClientSaltAssigned() const { return _hasClientSaltAssigned; };
 				bool HasServerSaltAssigned() const { return _hasServerSaltAssigned; };
 				ConnectionFailedReasonType GetConnectionDeniedReason() const { return _connectionDeniedReason; }
+				uint32 GetAckWindowSize() const { return _ackWindowSize; };
+				void SetAckWindowSize( uint32 ack_window_size ) { _ackWindowSize = ack_window_size; };
 				void SetConnectionDeniedReason( ConnectionFailedReasonType reason )
 				{
 					_connectionDeniedReason = reason;
@@ -86,6 +88,9 @@ namespace NetLib
 				bool _startedLocally;
 				float32 _currentConnectionElapsedTimeSeconds;
 				ConnectionFailedReasonType _connectionDeniedReason;
+				// Before the connection is completed it is the maximum ACK window supported by this peer. Once it is
+				// completed it is the ACK window negotiated with the remote peer
+				uint32 _ackWindowSize;
 		};
 	} // namespace Connection
 } // namespace NetLib
@@ -4,6 +4,7 @@
 #include "asserts.h"
 
 #include "communication/message.h"
+#include "communication/ack_bitfield.h"
 #include "communication/message_factory.h"
 #include "connection/pending_connection.h"
 #include "core/peer.h"
@@ -63,7 +64,8 @@ namespace NetLib
 		}
 
 		static std::unique_ptr< Message > CreateConnectionAcceptedMessage( MessageFactory& message_factory,
-		                                                                   uint64 data_prefix, uint16 id )
+		                                                                   uint64 data_prefix, uint16 id,
+		                                                                   uint32 ack_window_size )
 		{
 			LOG_INFO( "%s Creating connection accepted message for pending connection", THIS_FUNCTION_NAME );
 
@@ -81,6 +83,7 @@ namespace NetLib
 			    static_cast< ConnectionAcceptedMessage* >( message.release() ) );
 			connectionAcceptedMessage->prefix = data_prefix;
 			connectionAcceptedMessage->clientIndexAssigned = id;
+			connectionAcceptedMessage->ackWindowSize = static_cast< uint16 >( ack_window_size );
 
 			return connectionAcceptedMessage;
 		}
@@ -101,6 +104,8 @@ namespace NetLib
 					pending_connection.SetClientSalt( message.clientSalt );
 					pending_connection.SetServerSalt( GenerateServerSalt() );
 					pending_connection.GenerateDataPrefix();
+					pending_connection.SetAckWindowSize( AckBitfield::NegotiateWindowSize(
+					    pending_connection.GetAckWindowSize(), message.maxAckWindowSize ) );
 					pending_connection.SetCurrentState( PendingConnectionState::ConnectionChallenge );
 				}
 
@@ -111,7 +116,8 @@ namespace NetLib
 			else if ( pending_connection.GetCurrentState() == PendingConnectionState::Completed )
 			{
 				outcomeMessage = CreateConnectionAcceptedMessage( message_factory, pending_connection.GetDataPrefix(),
-				                                                  pending_connection.GetId() );
+				                                                  pending_connection.GetId(),
+				                                                  pending_connection.GetAckWindowSize() );
 			}
 			// If it is in failed state, send denied
 			else if ( pending_connection.GetCurrentState() == PendingConnectionState::Failed )
@@ -202,7 +208,8 @@ namespace NetLib
 					}
 
 					outcomeMessage = CreateConnectionAcceptedMessage(
-					    message_factory, pending_connection.GetDataPrefix(), pending_connection.GetId() );
+					    message_factory, pending_connection.GetDataPrefix(), pending_connection.GetId(),
+					    pending_connection.GetAckWindowSize() );
 				}
 			}
 			else
@@ -0,0 +1,91 @@
+#include "batch_size_metric.h"
+
+#include "logger.h"
+
+namespace NetLib
+{
+	namespace Metrics
+	{
+		BatchSizeMetric::BatchSizeMetric( MetricType type )
+		    : _type( type )
+		    , _timeUntilNextUpdate( 1.0f )
+		    , _updateRate( 1.0f )
+		    , _inProgressDatagrams( 0 )
+		    , _inProgressBatches( 0 )
+		    , _currentValue( 0 )
+		    , _maxValue( 0 )
+		{
+		}
+
+		MetricType BatchSizeMetric::GetType() const
+		{
+			return _type;
+		}
+
+		uint32 BatchSizeMetric::GetValue( ValueType value_type ) const
+		{
+			uint32 result = 0;
+
+			if ( value_type == ValueType::MAX )
+			{
+				result = _maxValue;
+			}
+			else if ( value_type == ValueType::CURRENT )
+			{
+				result = _currentValue;
+			}
+			else
+			{
+				LOG_WARNING( "Unknown value type '%u' for BatchSizeMetric", static_cast< uint8 >( value_type ) );
+			}
+
+			return result;
+		}
+
+		void BatchSizeMetric::SetUpdateRate( float32 update_rate )
+		{
+			_updateRate = update_rate;
+			_timeUntilNextUpdate = _updateRate;
+		}
+
+		void BatchSizeMetric::Update( float32 elapsed_time )
+		{
+			if ( _timeUntilNextUpdate <= elapsed_time )
+			{
+				// Average batch size during the last window. Round up so a window with only small batches doesn't
+				// report 0
+				_currentValue = ( _inProgressBatches > 0 )
+				                    ? ( _inProgressDatagrams + _inProgressBatches - 1 ) / _inProgressBatches
+				                    : 0;
+				_inProgressDatagrams = 0;
+				_inProgressBatches = 0;
+
+				_timeUntilNextUpdate = _updateRate;
+			}
+			else
+			{
+				_timeUntilNextUpdate -= elapsed_time;
+			}
+		}
+
+		void BatchSizeMetric::AddValueSample( uint32 value, const std::string& sample_type )
+		{
+			_inProgressDatagrams += value;
+			++_inProgressBatches;
+
+			if ( value > _maxValue )
+			{
+				_maxValue = value;
+			}
+		}
+
+		void BatchSizeMetric::Reset()
+		{
+			_inProgressDatagrams = 0;
+			_inProgressBatches = 0;
+			_currentValue = 0;
+			_maxValue = 0;
+			_timeUntilNextUpdate = _updateRate;
+		}
+	} // namespace Metrics
+} // namespace NetLib
@@ -0,0 +1,38 @@
+#pragma once
+#include "metrics/i_metric.h"
+
+#include "metrics/metric_types.h"
+
+namespace NetLib
+{
+	namespace Metrics
+	{
+		/// <summary>
+		/// Tracks the number of datagrams moved per batched socket call. CURRENT is the average batch size during the
+		/// last update window and MAX is the biggest batch seen so far.
+		/// </summary>
+		class BatchSizeMetric : public IMetric
+		{
+			public:
+				BatchSizeMetric( MetricType type );
+
+				MetricType GetType() const override;
+				uint32 GetValue( ValueType value_type ) const override;
+				void SetUpdateRate( float32 update_rate ) override;
+				void Update( float32 elapsed_time ) override;
+				void AddValueSample( uint32 value, const std::string& sample_type = "NONE" ) override;
+				void Reset() override;
+
+			private:
+				const MetricType _type;
+
+				float32 _timeUntilNextUpdate;
+				float32 _updateRate;
+
+				uint32 _inProgressDatagrams;
+				uint32 _inProgressBatches;
+				uint32 _currentValue;
+				uint32 _maxValue;
+		};
+	} // namespace Metrics
+} // namespace NetLib
@@ -13,7 +13,13 @@ namespace NetLib
 			DOWNLOAD_BANDWIDTH = 4,
 			RETRANSMISSIONS = 5,
 			OUT_OF_ORDER_MESSAGES = 6,
-			DUPLICATE_MESSAGES = 7
+			DUPLICATE_MESSAGES = 7,
+			// Socket level metrics. They are tracked by the local peer instead of by each remote peer
+			RECEIVE_BATCH_SIZE = 8,
+			SEND_BATCH_SIZE = 9,
+			// Fragments of reliable messages bigger than a packet
+			SENT_FRAGMENTS = 10,
+			RECEIVED_FRAGMENTS = 11
 		};
 
 		enum class ValueType : uint8
@@ -10,6 +10,7 @@
 #include "metrics/upload_bandwidth_metric.h"
 #include "metrics/download_bandwidth_metric.h"
 #include "metrics/increment_metric.h"
+#include "metrics/batch_size_metric.h"
 
 namespace NetLib
 {
@@ -22,7 +23,9 @@ namespace NetLib
 		                                                                MetricType::DOWNLOAD_BANDWIDTH,
 		                                                                MetricType::RETRANSMISSIONS,
 		                                                                MetricType::OUT_OF_ORDER_MESSAGES,
-		                                                                MetricType::DUPLICATE_MESSAGES };
+		                                                                MetricType::DUPLICATE_MESSAGES,
+		                                                                MetricType::SENT_FRAGMENTS,
+		                                                                MetricType::RECEIVED_FRAGMENTS };
 
 		MetricsHandler::MetricsHandler()
 		    : _isStartedUp( false )
@@ -69,8 +72,14 @@ namespace NetLib
 					case MetricType::RETRANSMISSIONS:
 					case MetricType::OUT_OF_ORDER_MESSAGES:
 					case MetricType::DUPLICATE_MESSAGES:
+					case MetricType::SENT_FRAGMENTS:
+					case MetricType::RECEIVED_FRAGMENTS:
 						result &= AddEntry( new IncrementMetric( *cit ) );
 						break;
+					case MetricType::RECEIVE_BATCH_SIZE:
+					case MetricType::SEND_BATCH_SIZE:
+						result &= AddEntry( new BatchSizeMetric( *cit ) );
+						break;
 					default:
 						LOG_ERROR( "[MetricsHandler.%s] Unknown MetricType %u. Ignoring it.", THIS_FUNCTION_NAME,
 						           static_cast< uint8 >( *cit ) );
@@ -145,23 +154,40 @@ namespace NetLib
 				it->second->Update( elapsed_time );
 			}
 
-			LOG_INFO(
-			    "NETWORK METRICS:\nLATENCY: Average: %u, Max: %u\nJITTER: Average: %u, Max: %u\nPACKET LOSS: Average: "
-			    "%u, Max: %u\nUPLOAD "
-			    "BANDWIDTH: Current: %u, "
-			    "Max: %u\nDOWNLOAD BANDWIDTH: Current: %u, Max: %u\nRETRANSMISSIONS: Current: %u\nOUT OF ORDER: "
-			    "Current: %u\nDUPLICATE: Current: %u",
-			    GetValue( MetricType::LATENCY, ValueType::CURRENT ), GetValue( MetricType::LATENCY, ValueType::MAX ),
-			    GetValue( MetricType::JITTER, ValueType::CURRENT ), GetValue( MetricType::JITTER, ValueType::MAX ),
-			    GetValue( MetricType::PACKET_LOSS, ValueType::CURRENT ),
-			    GetValue( MetricType::PACKET_LOSS, ValueType::MAX ),
-			    GetValue( MetricType::UPLOAD_BANDWIDTH, ValueType::CURRENT ),
-			    GetValue( MetricType::UPLOAD_BANDWIDTH, ValueType::MAX ),
-			    GetValue( MetricType::DOWNLOAD_BANDWIDTH, ValueType::CURRENT ),
-			    GetValue( MetricType::DOWNLOAD_BANDWIDTH, ValueType::MAX ),
-			    GetValue( MetricType::RETRANSMISSIONS, ValueType::CURRENT ),
-			    GetValue( MetricType::OUT_OF_ORDER_MESSAGES, ValueType::CURRENT ),
-			    GetValue( MetricType::DUPLICATE_MESSAGES, ValueType::CURRENT ) );
+			// Socket level metrics live in their own handler, owned by the local peer, so only log the groups present
+			if ( HasMetric( MetricType::LATENCY ) )
+			{
+				LOG_INFO(
+				    "NETWORK METRICS:\nLATENCY: Average: %u, Max: %u\nJITTER: Average: %u, Max: %u\nPACKET LOSS: "
+				    "Average: %u, Max: %u\nUPLOAD "
+				    "BANDWIDTH: Current: %u, "
+				    "Max: %u\nDOWNLOAD BANDWIDTH: Current: %u, Max: %u\nRETRANSMISSIONS: Current: %u\nOUT OF ORDER: "
+				    "Current: %u\nDUPLICATE: Current: %u\nSENT FRAGMENTS: Current: %u\nRECEIVED FRAGMENTS: Current: %u",
+				    GetValue( MetricType::LATENCY, ValueType::CURRENT ),
+				    GetValue( MetricType::LATENCY, ValueType::MAX ),
+				    GetValue( MetricType::JITTER, ValueType::CURRENT ), GetValue( MetricType::JITTER, ValueType::MAX ),
+				    GetValue( MetricType::PACKET_LOSS, ValueType::CURRENT ),
+				    GetValue( MetricType::PACKET_LOSS, ValueType::MAX ),
+				    GetValue( MetricType::UPLOAD_BANDWIDTH, ValueType::CURRENT ),
+				    GetValue( MetricType::UPLOAD_BANDWIDTH, ValueType::MAX ),
+				    GetValue( MetricType::DOWNLOAD_BANDWIDTH, ValueType::CURRENT ),
+				    GetValue( MetricType::DOWNLOAD_BANDWIDTH, ValueType::MAX ),
+				    GetValue( MetricType::RETRANSMISSIONS, ValueType::CURRENT ),
+				    GetValue( MetricType::OUT_OF_ORDER_MESSAGES, ValueType::CURRENT ),
+				    GetValue( MetricType::DUPLICATE_MESSAGES, ValueType::CURRENT ),
+				    GetValue( MetricType::SENT_FRAGMENTS, ValueType::CURRENT ),
+				    GetValue( MetricType::RECEIVED_FRAGMENTS, ValueType::CURRENT ) );
+			}
+
+			if ( HasMetric( MetricType::RECEIVE_BATCH_SIZE ) && HasMetric( MetricType::SEND_BATCH_SIZE ) )
+			{
+				LOG_INFO( "SOCKET METRICS:\nRECEIVE BATCH SIZE: Average: %u, Max: %u\nSEND BATCH SIZE: Average: %u, "
+				          "Max: %u",
+				          GetValue( MetricType::RECEIVE_BATCH_SIZE, ValueType::CURRENT ),
+				          GetValue( MetricType::RECEIVE_BATCH_SIZE, ValueType::MAX ),
+				          GetValue( MetricType::SEND_BATCH_SIZE, ValueType::CURRENT ),
+				          GetValue( MetricType::SEND_BATCH_SIZE, ValueType::MAX ) );
+			}
 		}
 
 		bool MetricsHandler::AddEntry( IMetric* metric )
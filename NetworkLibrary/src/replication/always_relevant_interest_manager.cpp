@@ -0,0 +1,37 @@
+#include "always_relevant_interest_manager.h"
+
+#include "replication/network_entity_storage.h"
+
+namespace NetLib
+{
+	AlwaysRelevantInterestManager::AlwaysRelevantInterestManager( uint32 max_entity_updates_per_tick )
+	    : IInterestManager()
+	    , _maxEntityUpdatesPerTick( max_entity_updates_per_tick )
+	    , _entityIds()
+	{
+	}
+
+	void AlwaysRelevantInterestManager::Update( const NetworkEntityStorage& network_entity_storage )
+	{
+		_entityIds.clear();
+
+		const std::unordered_map< uint32, NetworkEntityData >& networkEntities =
+		    network_entity_storage.GetNetworkEntitiess();
+		auto cit = networkEntities.cbegin();
+		for ( ; cit != networkEntities.cend(); ++cit )
+		{
+			_entityIds.push_back( cit->first );
+		}
+	}
+
+	void AlwaysRelevantInterestManager::GetRelevantEntities( uint32 remote_peer_id,
+	                                                         std::vector< uint32 >& relevant_entity_ids ) const
+	{
+		relevant_entity_ids.insert( relevant_entity_ids.end(), _entityIds.cbegin(), _entityIds.cend() );
+	}
+
+	uint32 AlwaysRelevantInterestManager::GetMaxEntityUpdatesPerTick( uint32 remote_peer_id ) const
+	{
+		return _maxEntityUpdatesPerTick;
+	}
+} // namespace NetLib
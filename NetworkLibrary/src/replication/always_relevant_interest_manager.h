@@ -0,0 +1,27 @@
+#pragma once
+#include "numeric_types.h"
+
+#include "replication/i_interest_manager.h"
+
+namespace NetLib
+{
+	/// <summary>
+	/// Interest manager that makes every network entity relevant to every remote peer. Useful for small sessions where
+	/// all remote peers need to know about the whole world.
+	/// </summary>
+	class AlwaysRelevantInterestManager : public IInterestManager
+	{
+		public:
+			AlwaysRelevantInterestManager( uint32 max_entity_updates_per_tick = 0 );
+
+			void Update( const NetworkEntityStorage& network_entity_storage ) override;
+			void GetRelevantEntities( uint32 remote_peer_id,
+			                          std::vector< uint32 >& relevant_entity_ids ) const override;
+			uint32 GetMaxEntityUpdatesPerTick( uint32 remote_peer_id ) const override;
+			void RemoveRemotePeer( uint32 remote_peer_id ) override {}
+
+		private:
+			uint32 _maxEntityUpdatesPerTick;
+			std::vector< uint32 > _entityIds;
+	};
+} // namespace NetLib
@@ -0,0 +1,101 @@
+#include "client_snapshot_tracker.h"
+
+namespace NetLib
+{
+	static_assert( SNAPSHOT_HISTORY_SIZE <= 32, "EntitySentHistory mask can't hold more than 32 snapshots" );
+
+	ClientSnapshotTracker::ClientSnapshotTracker()
+	    : _sentSnapshots()
+	    , _entitiesSentHistory()
+	{
+	}
+
+	void ClientSnapshotTracker::BeginSnapshot( uint16 snapshot_sequence_number )
+	{
+		SentSnapshot& snapshot = _sentSnapshots[ snapshot_sequence_number % SNAPSHOT_HISTORY_SIZE ];
+		snapshot.sequenceNumber = snapshot_sequence_number;
+		snapshot.numberOfUpdatesSent = 0;
+		snapshot.isValid = true;
+		snapshot.isAcked = false;
+	}
+
+	void ClientSnapshotTracker::OnEntityUpdateSent( uint32 network_entity_id, uint16 snapshot_sequence_number )
+	{
+		SentSnapshot& snapshot = _sentSnapshots[ snapshot_sequence_number % SNAPSHOT_HISTORY_SIZE ];
+		if ( snapshot.isValid && snapshot.sequenceNumber == snapshot_sequence_number )
+		{
+			++snapshot.numberOfUpdatesSent;
+		}
+
+		auto it = _entitiesSentHistory.find( network_entity_id );
+		if ( it == _entitiesSentHistory.end() )
+		{
+			EntitySentHistory history;
+			history.lastSentSequenceNumber = snapshot_sequence_number;
+			history.sentMask = 1;
+			_entitiesSentHistory[ network_entity_id ] = history;
+			return;
+		}
+
+		EntitySentHistory& history = it->second;
+		const uint16 shift = static_cast< uint16 >( snapshot_sequence_number - history.lastSentSequenceNumber );
+		history.sentMask = ( shift >= 32 ) ? 0 : ( history.sentMask << shift );
+		history.sentMask |= 1;
+		history.lastSentSequenceNumber = snapshot_sequence_number;
+	}
+
+	void ClientSnapshotTracker::AcknowledgeSnapshot( uint16 snapshot_sequence_number,
+	                                                 uint16 number_of_updates_received )
+	{
+		SentSnapshot& snapshot = _sentSnapshots[ snapshot_sequence_number % SNAPSHOT_HISTORY_SIZE ];
+		if ( !snapshot.isValid || snapshot.sequenceNumber != snapshot_sequence_number )
+		{
+			return;
+		}
+
+		if ( number_of_updates_received == snapshot.numberOfUpdatesSent )
+		{
+			snapshot.isAcked = true;
+		}
+	}
+
+	bool ClientSnapshotTracker::TryGetBaseline( uint32 network_entity_id, uint16 current_snapshot_sequence_number,
+	                                            uint16& baseline_snapshot_sequence_number ) const
+	{
+		auto cit = _entitiesSentHistory.find( network_entity_id );
+		if ( cit == _entitiesSentHistory.cend() )
+		{
+			return false;
+		}
+
+		const EntitySentHistory& history = cit->second;
+		for ( uint32 age = 1; age < SNAPSHOT_HISTORY_SIZE; ++age )
+		{
+			const uint16 candidate = static_cast< uint16 >( current_snapshot_sequence_number - age );
+			const uint16 distanceToLastSent = static_cast< uint16 >( history.lastSentSequenceNumber - candidate );
+			if ( distanceToLastSent >= 32 || ( ( history.sentMask >> distanceToLastSent ) & 1 ) == 0 )
+			{
+				continue;
+			}
+
+			if ( IsSnapshotAcked( candidate ) )
+			{
+				baseline_snapshot_sequence_number = candidate;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void ClientSnapshotTracker::RemoveEntity( uint32 network_entity_id )
+	{
+		_entitiesSentHistory.erase( network_entity_id );
+	}
+
+	bool ClientSnapshotTracker::IsSnapshotAcked( uint16 snapshot_sequence_number ) const
+	{
+		const SentSnapshot& snapshot = _sentSnapshots[ snapshot_sequence_number % SNAPSHOT_HISTORY_SIZE ];
+		return snapshot.isValid && snapshot.isAcked && snapshot.sequenceNumber == snapshot_sequence_number;
+	}
+} // namespace NetLib
@@ -0,0 +1,75 @@
+#pragma once
+#include "numeric_types.h"
+
+#include <array>
+#include <unordered_map>
+
+#include "replication/entity_state_history.h"
+
+namespace NetLib
+{
+	/// <summary>
+	/// <para>SERVER ONLY</para>
+	/// <para>Tracks, for a single client, which snapshots it has fully received and in which snapshots each entity
+	/// was sent to it. A snapshot is only considered a valid baseline once the client confirms it received all the
+	/// update messages of that snapshot.</para>
+	/// </summary>
+	class ClientSnapshotTracker
+	{
+		public:
+			ClientSnapshotTracker();
+
+			void BeginSnapshot( uint16 snapshot_sequence_number );
+			void OnEntityUpdateSent( uint32 network_entity_id, uint16 snapshot_sequence_number );
+
+			/// <summary>
+			/// Processes a snapshot ack from the client. The snapshot is marked as acked only if the client received
+			/// as many update messages as were sent.
+			/// </summary>
+			void AcknowledgeSnapshot( uint16 snapshot_sequence_number, uint16 number_of_updates_received );
+
+			/// <summary>
+			/// Returns the most recent acked snapshot, older than current_snapshot_sequence_number, in which the entity
+			/// was sent to the client.
+			/// </summary>
+			bool TryGetBaseline( uint32 network_entity_id, uint16 current_snapshot_sequence_number,
+			                     uint16& baseline_snapshot_sequence_number ) const;
+
+			void RemoveEntity( uint32 network_entity_id );
+
+		private:
+			struct SentSnapshot
+			{
+					SentSnapshot()
+					    : sequenceNumber( 0 )
+					    , numberOfUpdatesSent( 0 )
+					    , isValid( false )
+					    , isAcked( false )
+					{
+					}
+
+					uint16 sequenceNumber;
+					uint16 numberOfUpdatesSent;
+					bool isValid;
+					bool isAcked;
+			};
+
+			struct EntitySentHistory
+			{
+					EntitySentHistory()
+					    : lastSentSequenceNumber( 0 )
+					    , sentMask( 0 )
+					{
+					}
+
+					// Bit i is set if the entity was sent in snapshot (lastSentSequenceNumber - i)
+					uint16 lastSentSequenceNumber;
+					uint32 sentMask;
+			};
+
+			bool IsSnapshotAcked( uint16 snapshot_sequence_number ) const;
+
+			std::array< SentSnapshot, SNAPSHOT_HISTORY_SIZE > _sentSnapshots;
+			std::unordered_map< uint32, EntitySentHistory > _entitiesSentHistory;
+	};
+} // namespace NetLib
@@ -0,0 +1,75 @@
+#include "delta_compression_utils.h"
+
+#include "core/buffer.h"
+#include "core/bit_writer.h"
+#include "core/bit_reader.h"
+
+namespace NetLib
+{
+	uint32 DeltaCompressionUtils::EncodeDelta( const uint8* baseline, const uint8* current, uint32 size,
+	                                           uint8* output, uint32 output_capacity )
+	{
+		uint32 numberOfChangedBytes = 0;
+		for ( uint32 i = 0; i < size; ++i )
+		{
+			if ( baseline[ i ] != current[ i ] )
+			{
+				++numberOfChangedBytes;
+			}
+		}
+
+		const uint32 deltaSize = ( size + ( numberOfChangedBytes * 8 ) + 7 ) / 8;
+		if ( deltaSize > output_capacity )
+		{
+			return 0;
+		}
+
+		Buffer buffer( output, output_capacity );
+		BitWriter writer( buffer );
+		for ( uint32 i = 0; i < size; ++i )
+		{
+			const bool hasChanged = baseline[ i ] != current[ i ];
+			writer.WriteBool( hasChanged );
+			if ( hasChanged )
+			{
+				writer.WriteBits( current[ i ], 8 );
+			}
+		}
+		writer.Flush();
+
+		return buffer.GetAccessIndex();
+	}
+
+	bool DeltaCompressionUtils::DecodeDelta( const uint8* baseline, uint32 size, const uint8* delta,
+	                                         uint32 delta_size, uint8* output )
+	{
+		// The buffer is only read, the const_cast is needed because Buffer is shared between reads and writes
+		Buffer buffer( const_cast< uint8* >( delta ), delta_size );
+		BitReader reader( buffer );
+		for ( uint32 i = 0; i < size; ++i )
+		{
+			bool hasChanged;
+			if ( !reader.ReadBool( hasChanged ) )
+			{
+				return false;
+			}
+
+			if ( hasChanged )
+			{
+				uint32 value;
+				if ( !reader.ReadBits( value, 8 ) )
+				{
+					return false;
+				}
+
+				output[ i ] = static_cast< uint8 >( value );
+			}
+			else
+			{
+				output[ i ] = baseline[ i ];
+			}
+		}
+
+		return true;
+	}
+} // namespace NetLib
@@ -0,0 +1,27 @@
+#pragma once
+#include "numeric_types.h"
+
+namespace NetLib
+{
+	/// <summary>
+	/// Delta compression of serialized entity states. Entity states are opaque to the library, so the delta is
+	/// computed byte by byte: for each byte of the state a bit tells whether it changed, followed by the new byte
+	/// value if so. Both states must have the same size.
+	/// </summary>
+	class DeltaCompressionUtils
+	{
+		public:
+			/// <summary>
+			/// Encodes current against baseline into output. Returns the number of bytes written or 0 if the delta
+			/// doesn't fit in output_capacity bytes.
+			/// </summary>
+			static uint32 EncodeDelta( const uint8* baseline, const uint8* current, uint32 size, uint8* output,
+			                           uint32 output_capacity );
+
+			/// <summary>
+			/// Rebuilds the full state of size bytes from baseline and a delta created with EncodeDelta.
+			/// </summary>
+			static bool DecodeDelta( const uint8* baseline, uint32 size, const uint8* delta, uint32 delta_size,
+			                         uint8* output );
+	};
+} // namespace NetLib
@@ -0,0 +1,12 @@
+#include "entity_priority.h"
+
+#include "replication/network_entity_storage.h"
+
+namespace NetLib
+{
+	float32 EntityPriorityUtils::GetDefaultEntityPriority( uint32 remote_peer_id,
+	                                                       const NetworkEntityData& network_entity_data )
+	{
+		return ( network_entity_data.controlledByPeerId == remote_peer_id ) ? DEFAULT_OWNER_ENTITY_PRIORITY : 1.f;
+	}
+} // namespace NetLib
@@ -0,0 +1,34 @@
+#pragma once
+#include "numeric_types.h"
+
+#include <functional>
+
+namespace NetLib
+{
+	struct NetworkEntityData;
+
+	/// <summary>
+	/// <para>SERVER ONLY</para>
+	/// Returns how much the priority of a relevant network entity grows for a remote peer every replication tick. The
+	/// entities with the highest accumulated priority are updated first and their priority is reset once they are
+	/// sent, so the ones left out due to the bandwidth budget get more important over time.
+	/// </summary>
+	typedef std::function< float32( uint32 remote_peer_id, const NetworkEntityData& network_entity_data ) >
+	    EntityPriorityFunction;
+
+	/// <summary>
+	/// Priority growth of the entities controlled by the remote peer when using the default priority function.
+	/// </summary>
+	constexpr float32 DEFAULT_OWNER_ENTITY_PRIORITY = 4.f;
+
+	class EntityPriorityUtils
+	{
+		public:
+			/// <summary>
+			/// Default priority function. Entities controlled by the remote peer grow DEFAULT_OWNER_ENTITY_PRIORITY
+			/// per tick and the rest of them 1.
+			/// </summary>
+			static float32 GetDefaultEntityPriority( uint32 remote_peer_id,
+			                                         const NetworkEntityData& network_entity_data );
+	};
+} // namespace NetLib
@@ -0,0 +1,57 @@
+#include "entity_state_history.h"
+
+#include "logger.h"
+#include "asserts.h"
+
+#include <cstring>
+
+namespace NetLib
+{
+	static_assert( ( SNAPSHOT_HISTORY_SIZE & ( SNAPSHOT_HISTORY_SIZE - 1 ) ) == 0,
+	               "SNAPSHOT_HISTORY_SIZE must be a power of two" );
+
+	EntityStateHistory::EntityStateHistory()
+	    : _snapshots()
+	{
+	}
+
+	bool EntityStateHistory::Store( uint16 snapshot_sequence_number, const uint8* data, uint32 size )
+	{
+		if ( size > MAX_ENTITY_STATE_SIZE )
+		{
+			LOG_WARNING( "[EntityStateHistory.%s] Entity state of %u bytes is too big to be stored. Max size: %u",
+			             THIS_FUNCTION_NAME, size, MAX_ENTITY_STATE_SIZE );
+			return false;
+		}
+
+		EntityStateSnapshot& snapshot = _snapshots[ snapshot_sequence_number % SNAPSHOT_HISTORY_SIZE ];
+		snapshot.snapshotSequenceNumber = snapshot_sequence_number;
+		snapshot.isValid = true;
+		snapshot.size = size;
+		if ( size > 0 )
+		{
+			std::memcpy( snapshot.data.data(), data, size );
+		}
+
+		return true;
+	}
+
+	const EntityStateSnapshot* EntityStateHistory::TryGet( uint16 snapshot_sequence_number ) const
+	{
+		const EntityStateSnapshot& snapshot = _snapshots[ snapshot_sequence_number % SNAPSHOT_HISTORY_SIZE ];
+		if ( !snapshot.isValid || snapshot.snapshotSequenceNumber != snapshot_sequence_number )
+		{
+			return nullptr;
+		}
+
+		return &snapshot;
+	}
+
+	void EntityStateHistory::Clear()
+	{
+		for ( auto it = _snapshots.begin(); it != _snapshots.end(); ++it )
+		{
+			it->isValid = false;
+		}
+	}
+} // namespace NetLib
@@ -0,0 +1,62 @@
+#pragma once
+#include "numeric_types.h"
+
+#include <array>
+
+namespace NetLib
+{
+	/// <summary>
+	/// Number of snapshots kept per entity. A baseline older than this can't be used for delta compression and the full
+	/// entity state is sent instead. It must be a power of two so the ring index doesn't break when the uint16
+	/// snapshot sequence number wraps around.
+	/// </summary>
+	constexpr uint32 SNAPSHOT_HISTORY_SIZE = 32;
+
+	/// <summary>
+	/// Maximum size in bytes of an entity state kept in the history. Bigger states are replicated without delta
+	/// compression.
+	/// </summary>
+	constexpr uint32 MAX_ENTITY_STATE_SIZE = 128;
+
+	struct EntityStateSnapshot
+	{
+			EntityStateSnapshot()
+			    : snapshotSequenceNumber( 0 )
+			    , isValid( false )
+			    , size( 0 )
+			    , data()
+			{
+			}
+
+			uint16 snapshotSequenceNumber;
+			bool isValid;
+			uint32 size;
+			std::array< uint8, MAX_ENTITY_STATE_SIZE > data;
+	};
+
+	/// <summary>
+	/// Ring buffer with the serialized states of a network entity for the last SNAPSHOT_HISTORY_SIZE snapshots. The
+	/// server uses it to find the baseline a delta is computed against and the client to rebuild the full state from
+	/// a received delta.
+	/// </summary>
+	class EntityStateHistory
+	{
+		public:
+			EntityStateHistory();
+
+			/// <summary>
+			/// Returns false, without storing it, if the state is bigger than MAX_ENTITY_STATE_SIZE.
+			/// </summary>
+			bool Store( uint16 snapshot_sequence_number, const uint8* data, uint32 size );
+
+			/// <summary>
+			/// Returns the state stored for the given snapshot or nullptr if it has already been overwritten.
+			/// </summary>
+			const EntityStateSnapshot* TryGet( uint16 snapshot_sequence_number ) const;
+
+			void Clear();
+
+		private:
+			std::array< EntityStateSnapshot, SNAPSHOT_HISTORY_SIZE > _snapshots;
+	};
+} // namespace NetLib
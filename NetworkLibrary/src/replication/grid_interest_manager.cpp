@@ -0,0 +1,113 @@
+#include "grid_interest_manager.h"
+
+#include "logger.h"
+#include "asserts.h"
+
+#include "replication/network_entity_storage.h"
+
+#include <cmath>
+
+namespace NetLib
+{
+	GridInterestManager::GridInterestManager( const GridInterestManagerConfig& config )
+	    : IInterestManager()
+	    , _config( config )
+	    , _cells()
+	    , _viewers()
+	    , _updateIndex( 0 )
+	{
+		ASSERT( _config.cellSize > 0.f, "[GridInterestManager.%s] Cell size must be greater than 0.",
+		        THIS_FUNCTION_NAME );
+	}
+
+	void GridInterestManager::Update( const NetworkEntityStorage& network_entity_storage )
+	{
+		++_updateIndex;
+
+		// Keep the cells used during the last update so their memory is reused and remove the rest
+		auto cell_it = _cells.begin();
+		while ( cell_it != _cells.end() )
+		{
+			if ( cell_it->second.empty() )
+			{
+				cell_it = _cells.erase( cell_it );
+			}
+			else
+			{
+				cell_it->second.clear();
+				++cell_it;
+			}
+		}
+
+		const std::unordered_map< uint32, NetworkEntityData >& networkEntities =
+		    network_entity_storage.GetNetworkEntitiess();
+		auto cit = networkEntities.cbegin();
+		for ( ; cit != networkEntities.cend(); ++cit )
+		{
+			const NetworkEntityData& networkEntityData = cit->second;
+			const GridCell cell = GetCell( networkEntityData.positionX, networkEntityData.positionY );
+			_cells[ GetCellKey( cell.x, cell.y ) ].push_back( networkEntityData.id );
+
+			// Viewers not updated this time keep their previous cells
+			ViewerData& viewer = _viewers[ networkEntityData.controlledByPeerId ];
+			if ( viewer.lastUpdateIndex != _updateIndex )
+			{
+				viewer.cells.clear();
+				viewer.lastUpdateIndex = _updateIndex;
+			}
+
+			viewer.cells.push_back( cell );
+		}
+	}
+
+	void GridInterestManager::GetRelevantEntities( uint32 remote_peer_id,
+	                                               std::vector< uint32 >& relevant_entity_ids ) const
+	{
+		auto viewer_it = _viewers.find( remote_peer_id );
+		if ( viewer_it == _viewers.cend() )
+		{
+			return;
+		}
+
+		const int32 viewDistance = static_cast< int32 >( _config.viewDistanceInCells );
+		auto cell_cit = viewer_it->second.cells.cbegin();
+		for ( ; cell_cit != viewer_it->second.cells.cend(); ++cell_cit )
+		{
+			for ( int32 y = cell_cit->y - viewDistance; y <= cell_cit->y + viewDistance; ++y )
+			{
+				for ( int32 x = cell_cit->x - viewDistance; x <= cell_cit->x + viewDistance; ++x )
+				{
+					auto entities_it = _cells.find( GetCellKey( x, y ) );
+					if ( entities_it != _cells.cend() )
+					{
+						relevant_entity_ids.insert( relevant_entity_ids.end(), entities_it->second.cbegin(),
+						                            entities_it->second.cend() );
+					}
+				}
+			}
+		}
+	}
+
+	uint32 GridInterestManager::GetMaxEntityUpdatesPerTick( uint32 remote_peer_id ) const
+	{
+		return _config.maxEntityUpdatesPerTick;
+	}
+
+	void GridInterestManager::RemoveRemotePeer( uint32 remote_peer_id )
+	{
+		_viewers.erase( remote_peer_id );
+	}
+
+	GridInterestManager::GridCell GridInterestManager::GetCell( float32 position_x, float32 position_y ) const
+	{
+		GridCell cell;
+		cell.x = static_cast< int32 >( std::floor( position_x / _config.cellSize ) );
+		cell.y = static_cast< int32 >( std::floor( position_y / _config.cellSize ) );
+		return cell;
+	}
+
+	uint64 GridInterestManager::GetCellKey( int32 x, int32 y )
+	{
+		return ( static_cast< uint64 >( static_cast< uint32 >( x ) ) << 32 ) | static_cast< uint32 >( y );
+	}
+} // namespace NetLib
@@ -0,0 +1,73 @@
+#pragma once
+#include "numeric_types.h"
+
+#include <unordered_map>
+#include <vector>
+
+#include "replication/i_interest_manager.h"
+
+namespace NetLib
+{
+	struct GridInterestManagerConfig
+	{
+			GridInterestManagerConfig()
+			    : cellSize( 16.f )
+			    , viewDistanceInCells( 2 )
+			    , maxEntityUpdatesPerTick( 0 )
+			{
+			}
+
+			// Side length of a grid cell in world units
+			float32 cellSize;
+			// An entity is relevant to a remote peer if its cell is at this distance or closer from the cell of any
+			// entity controlled by the remote peer
+			uint32 viewDistanceInCells;
+			// 0 means there isn't any limit
+			uint32 maxEntityUpdatesPerTick;
+	};
+
+	/// <summary>
+	/// Default interest manager. Network entities are bucketed into a spatial hash of square cells based on the
+	/// positions set through ReplicationManager::SetNetworkEntityPosition. The entities controlled by a remote peer act
+	/// as its viewers, and all entities within the view distance of a viewer are relevant to it. If a remote peer
+	/// doesn't control any entity, the last known viewers' cells are used.
+	/// </summary>
+	class GridInterestManager : public IInterestManager
+	{
+		public:
+			GridInterestManager( const GridInterestManagerConfig& config = GridInterestManagerConfig() );
+
+			void Update( const NetworkEntityStorage& network_entity_storage ) override;
+			void GetRelevantEntities( uint32 remote_peer_id,
+			                          std::vector< uint32 >& relevant_entity_ids ) const override;
+			uint32 GetMaxEntityUpdatesPerTick( uint32 remote_peer_id ) const override;
+			void RemoveRemotePeer( uint32 remote_peer_id ) override;
+
+		private:
+			struct GridCell
+			{
+					int32 x;
+					int32 y;
+			};
+
+			struct ViewerData
+			{
+					ViewerData()
+					    : cells()
+					    , lastUpdateIndex( 0 )
+					{
+					}
+
+					std::vector< GridCell > cells;
+					uint32 lastUpdateIndex;
+			};
+
+			GridCell GetCell( float32 position_x, float32 position_y ) const;
+			static uint64 GetCellKey( int32 x, int32 y );
+
+			GridInterestManagerConfig _config;
+			std::unordered_map< uint64, std::vector< uint32 > > _cells;
+			std::unordered_map< uint32, ViewerData > _viewers;
+			uint32 _updateIndex;
+	};
+} // namespace NetLib
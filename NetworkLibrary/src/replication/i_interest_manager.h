@@ -0,0 +1,41 @@
+#pragma once
+#include "numeric_types.h"
+
+#include <vector>
+
+namespace NetLib
+{
+	class NetworkEntityStorage;
+
+	/// <summary>
+	/// <para>SERVER ONLY</para>
+	/// Decides which network entities are relevant to each remote peer. Entities that become relevant are created in
+	/// the remote peer and entities that stop being relevant are destroyed in it. Only relevant entities are updated.
+	/// </summary>
+	class IInterestManager
+	{
+		public:
+			IInterestManager() {}
+			virtual ~IInterestManager() {}
+
+			/// <summary>
+			/// Called once per replication tick, before querying the relevant entities of any remote peer.
+			/// </summary>
+			virtual void Update( const NetworkEntityStorage& network_entity_storage ) = 0;
+
+			/// <summary>
+			/// Adds the ids of the network entities relevant to the remote peer. The order doesn't matter and
+			/// duplicates are allowed.
+			/// </summary>
+			virtual void GetRelevantEntities( uint32 remote_peer_id,
+			                                  std::vector< uint32 >& relevant_entity_ids ) const = 0;
+
+			/// <summary>
+			/// Maximum number of entity updates sent to the remote peer per replication tick. If there are more
+			/// relevant entities, they are updated in turns. 0 means there isn't any limit.
+			/// </summary>
+			virtual uint32 GetMaxEntityUpdatesPerTick( uint32 remote_peer_id ) const = 0;
+
+			virtual void RemoveRemotePeer( uint32 remote_peer_id ) = 0;
+	};
+} // namespace NetLib
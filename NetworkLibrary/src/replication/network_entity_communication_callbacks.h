@@ -1,7 +1,8 @@
 #pragma once
 #include "delegate.hpp"
 
-#include "core/buffer.h"
+#include "core/bit_writer.h"
+#include "core/bit_reader.h"
 
 namespace NetLib
 {
@@ -14,27 +15,27 @@ namespace NetLib
 			/// <para>This callback is executed everytime the library requests a full entity state serialization for
 			/// sending it to the owner client.</para>
 			/// </summary>
-			Common::Delegate< Buffer& > OnSerializeEntityStateForOwner;
+			Common::Delegate< BitWriter& > OnSerializeEntityStateForOwner;
 
 			/// <summary>
 			/// <para>SERVER ONLY</para>
 			/// <para>This callback is executed everytime the library requests a partial entity state serialization for
 			/// sending it to a non owner client.</para>
 			/// </summary>
-			Common::Delegate< Buffer& > OnSerializeEntityStateForNonOwner;
+			Common::Delegate< BitWriter& > OnSerializeEntityStateForNonOwner;
 
 			/// <summary>
 			/// <para>CLIENT ONLY</para>
 			/// <para>This callback is executed everytime the library has received a full entity state for unserialize
 			/// and process it within this client (The owner of the entity).</para>
 			/// </summary>
-			Common::Delegate< Buffer& > OnUnserializeEntityStateForOwner;
+			Common::Delegate< BitReader& > OnUnserializeEntityStateForOwner;
 
 			/// <summary>
 			/// <para>CLIENT ONLY</para>
 			/// <para>This callback is executed everytime the library has received a partial entity state for
 			/// unserialize and process it within this client (A non owner of the entity).</para>
 			/// </summary>
-			Common::Delegate< Buffer& > OnUnserializeEntityStateForNonOwner;
+			Common::Delegate< BitReader& > OnUnserializeEntityStateForNonOwner;
 	};
 }
@@ -2,6 +2,8 @@
 #include "numeric_types.h"
 
 #include "replication/network_entity_communication_callbacks.h"
+#include "replication/entity_state_history.h"
+#include "replication/replication_payload.h"
 
 #include <unordered_map>
 
@@ -14,14 +16,30 @@ namespace NetLib
 			    : entityType( entityType )
 			    , id( id )
 			    , controlledByPeerId( controlledByPeerId )
+			    , positionX( 0.f )
+			    , positionY( 0.f )
 			    , communicationCallbacks()
+			    , ownerStateHistory()
+			    , nonOwnerStateHistory()
+			    , ownerPayloadCache()
+			    , nonOwnerPayloadCache()
 			{
 			}
 
 			uint32 entityType;
 			uint32 id;
 			uint32 controlledByPeerId;
+			// SERVER ONLY. Used by the interest manager to decide which remote peers the entity is relevant to
+			float32 positionX;
+			float32 positionY;
 			NetworkEntityCommunicationCallbacks communicationCallbacks;
+			// Serialized states sent to (server) or received by (client) the owner and the non owners, used for delta
+			// compression
+			EntityStateHistory ownerStateHistory;
+			EntityStateHistory nonOwnerStateHistory;
+			// SERVER ONLY. Payloads of the current snapshot shared by the messages of all remote peers
+			ReplicationPayloadCache ownerPayloadCache;
+			ReplicationPayloadCache nonOwnerPayloadCache;
 	};
 
 	/// <summary>
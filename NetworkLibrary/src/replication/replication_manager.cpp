@@ -1,19 +1,34 @@
 #include "replication_manager.h"
 
 #include <cassert>
+#include <algorithm>
 
 #include "logger.h"
 #include "asserts.h"
 
 #include "communication/message_factory.h"
 
+#include "core/bit_writer.h"
+
 #include "replication/replication_action_type.h"
 #include "replication/on_network_entity_create_config.h"
+#include "replication/delta_compression_utils.h"
 
 namespace NetLib
 {
 	ReplicationManager::ReplicationManager()
 	    : _nextNetworkEntityId( 1 )
+	    , _currentSnapshotSequenceNumber( 0 )
+	    , _remotePeersReplicationData()
+	    , _defaultInterestManager()
+	    , _interestManager( &_defaultInterestManager )
+	    , _isInterestManagerUpdated( false )
+	    , _newRelevantEntityIds()
+	    , _newPriorityAccumulators()
+	    , _entitiesToUpdate()
+	    , _entityPriorityFunction( EntityPriorityUtils::GetDefaultEntityPriority )
+	    , _maxReplicationBytesPerTick( DEFAULT_MAX_REPLICATION_BYTES_PER_TICK )
+	    , _serializationBuffer( MAX_REPLICATION_DATA_SIZE )
 	{
 	}
 
@@ -27,6 +42,8 @@ namespace NetLib
 		ASSERT( new_entity_data != nullptr,
 		        "Failed to create new network entity data for entity type %u with network entity id %u",
 		        replicated_class_id, network_entity_id );
+		new_entity_data->positionX = pos_x;
+		new_entity_data->positionY = pos_y;
 
 		// Spawn network entity in world
 		OnNetworkEntityCreateConfig network_entity_create_config;
@@ -42,7 +59,7 @@ namespace NetLib
 
 	std::unique_ptr< ReplicationMessage > ReplicationManager::CreateCreateReplicationMessage(
 	    MessageFactory& message_factory, uint32 entityType, uint32 controlledByPeerId, uint32 networkEntityId,
-	    const Buffer& dataBuffer )
+	    const SharedReplicationPayload& payload )
 	{
 		// Get message from message factory
 		std::unique_ptr< Message > message = message_factory.LendMessage( MessageType::Replication );
@@ -58,16 +75,16 @@ namespace NetLib
 		replicationMessage->networkEntityId = networkEntityId;
 		replicationMessage->controlledByPeerId = controlledByPeerId;
 		replicationMessage->replicatedClassId = entityType;
-		replicationMessage->data = dataBuffer.GetData();
-		replicationMessage->dataSize = dataBuffer.GetSize();
+		replicationMessage->SetPayload( payload );
 
 		return std::move( replicationMessage );
 	}
 
 	// TODO Do we need the entity_type here too in case we need to create the entity from the update?
 	std::unique_ptr< ReplicationMessage > ReplicationManager::CreateUpdateReplicationMessage(
-	    MessageFactory& message_factory, uint32 entityType, uint32 networkEntityId, uint32 controlledByPeerId,
-	    const Buffer& buffer )
+	    MessageFactory& message_factory, const NetworkEntityData& network_entity_data,
+	    const EntityStateHistory& state_history, ReplicationPayloadCache& payload_cache,
+	    const ClientSnapshotTracker& snapshot_tracker )
 	{
 		// Get message from message factory
 		std::unique_ptr< Message > message = message_factory.LendMessage( MessageType::Replication );
@@ -80,17 +97,92 @@ namespace NetLib
 		std::unique_ptr< ReplicationMessage > replicationMessage(
 		    static_cast< ReplicationMessage* >( message.release() ) );
 		replicationMessage->replicationAction = static_cast< uint8 >( ReplicationActionType::UPDATE );
-		replicationMessage->networkEntityId = networkEntityId;
-		replicationMessage->controlledByPeerId = controlledByPeerId;
-		replicationMessage->replicatedClassId = entityType;
-		// TODO Use some write stream here instead of manual buffer
-		replicationMessage->dataSize = buffer.GetAccessIndex();
-		replicationMessage->data = new uint8[ replicationMessage->dataSize ];
-		buffer.CopyUsedData( replicationMessage->data, replicationMessage->dataSize );
+		replicationMessage->networkEntityId = network_entity_data.id;
+		replicationMessage->controlledByPeerId = network_entity_data.controlledByPeerId;
+		replicationMessage->replicatedClassId = network_entity_data.entityType;
+		replicationMessage->snapshotSequenceNumber = _currentSnapshotSequenceNumber;
+
+		// Try to delta compress the state against the last baseline fully acked by the remote peer. Remote peers with
+		// the same baseline share the same delta payload
+		SharedReplicationPayload deltaPayload;
+		uint16 baselineSequenceNumber = 0;
+		if ( snapshot_tracker.TryGetBaseline( network_entity_data.id, _currentSnapshotSequenceNumber,
+		                                      baselineSequenceNumber ) &&
+		     !payload_cache.TryGetDeltaPayload( baselineSequenceNumber, deltaPayload ) )
+		{
+			deltaPayload = CreateDeltaPayload( state_history, baselineSequenceNumber );
+			payload_cache.AddDeltaPayload( baselineSequenceNumber, deltaPayload );
+		}
+
+		if ( deltaPayload != nullptr )
+		{
+			replicationMessage->isDeltaEncoded = true;
+			replicationMessage->baselineSnapshotSequenceNumber = baselineSequenceNumber;
+			replicationMessage->SetPayload( deltaPayload );
+		}
+		else
+		{
+			replicationMessage->isDeltaEncoded = false;
+			replicationMessage->SetPayload( payload_cache.GetFullStatePayload() );
+		}
 
 		return std::move( replicationMessage );
 	}
 
+	SharedReplicationPayload ReplicationManager::CreateDeltaPayload( const EntityStateHistory& state_history,
+	                                                                 uint16 baseline_snapshot_sequence_number ) const
+	{
+		const EntityStateSnapshot* current = state_history.TryGet( _currentSnapshotSequenceNumber );
+		const EntityStateSnapshot* baseline = state_history.TryGet( baseline_snapshot_sequence_number );
+		if ( current == nullptr || baseline == nullptr || baseline->size != current->size )
+		{
+			return nullptr;
+		}
+
+		uint8 deltaData[ MAX_ENTITY_STATE_SIZE ];
+		const uint32 deltaSize = DeltaCompressionUtils::EncodeDelta(
+		    baseline->data.data(), current->data.data(), current->size, deltaData, MAX_ENTITY_STATE_SIZE );
+
+		// The delta also sends the baseline sequence number, so only use it if it is smaller than the full state
+		if ( deltaSize == 0 || ( deltaSize + sizeof( uint16 ) ) >= current->size )
+		{
+			return nullptr;
+		}
+
+		return std::make_shared< ReplicationPayload >( deltaData, deltaSize );
+	}
+
+	void ReplicationManager::SerializeEntityState( NetworkEntityData& network_entity_data, bool for_owner,
+	                                               EntityStateHistory& state_history,
+	                                               ReplicationPayloadCache& payload_cache )
+	{
+		Buffer buffer( _serializationBuffer.data(), static_cast< uint32 >( _serializationBuffer.size() ) );
+		BitWriter writer( buffer );
+		if ( for_owner )
+		{
+			network_entity_data.communicationCallbacks.OnSerializeEntityStateForOwner.Execute( writer );
+		}
+		else
+		{
+			network_entity_data.communicationCallbacks.OnSerializeEntityStateForNonOwner.Execute( writer );
+		}
+		writer.Flush();
+
+		if ( writer.IsOverflowed() )
+		{
+			LOG_ERROR( "[ReplicationManager.%s] The state of network entity %u is bigger than %u bytes. Skipping its "
+			           "update...",
+			           THIS_FUNCTION_NAME, network_entity_data.id, MAX_REPLICATION_DATA_SIZE );
+			payload_cache.Reset( _currentSnapshotSequenceNumber, nullptr );
+			return;
+		}
+
+		// States too big for the history are sent as full states
+		state_history.Store( _currentSnapshotSequenceNumber, buffer.GetData(), buffer.GetAccessIndex() );
+		payload_cache.Reset( _currentSnapshotSequenceNumber,
+		                     std::make_shared< ReplicationPayload >( buffer.GetData(), buffer.GetAccessIndex() ) );
+	}
+
 	std::unique_ptr< ReplicationMessage > ReplicationManager::CreateDestroyReplicationMessage(
 	    MessageFactory& message_factory, uint32 networkEntityId )
 	{
@@ -111,26 +203,15 @@ namespace NetLib
 		return std::move( replicationMessage );
 	}
 
-	void ReplicationManager::CreateNetworkEntity( MessageFactory& message_factory, uint32 entityType,
-	                                              uint32 controlledByPeerId, float32 posX, float32 posY )
+	void ReplicationManager::CreateNetworkEntity( uint32 entityType, uint32 controlledByPeerId, float32 posX,
+	                                              float32 posY )
 	{
+		// Create messages are sent to each remote peer once the entity becomes relevant to it
 		SpawnNewNetworkEntity( entityType, _nextNetworkEntityId, controlledByPeerId, posX, posY );
-
-		// Prepare a Create replication message for interested clients
-		uint8* data = new uint8[ 8 ];
-		Buffer buffer( data, 8 );
-		buffer.WriteFloat( posX );
-		buffer.WriteFloat( posY );
-		std::unique_ptr< ReplicationMessage > createMessage = CreateCreateReplicationMessage(
-		    message_factory, entityType, controlledByPeerId, _nextNetworkEntityId, buffer );
-
-		// Store it into queue before broadcasting it
-		_createDestroyReplicationMessages.push_back( std::move( createMessage ) );
-
 		CalculateNextNetworkEntityId();
 	}
 
-	void ReplicationManager::RemoveNetworkEntity( MessageFactory& message_factory, uint32 networkEntityId )
+	void ReplicationManager::RemoveNetworkEntity( uint32 networkEntityId )
 	{
 		// Get game entity Id from network entity Id
 		const NetworkEntityData* networkEntity = _networkEntitiesStorage.TryGetNetworkEntityFromId( networkEntityId );
@@ -148,90 +229,250 @@ namespace NetLib
 			// Remove network enttiy data
 			_networkEntitiesStorage.RemoveNetworkEntity( networkEntityId );
 
-			// Create destroy entity message for remote peers
-			std::unique_ptr< ReplicationMessage > destroyMessage =
-			    CreateDestroyReplicationMessage( message_factory, networkEntityId );
+			// Destroy messages are sent to the remote peers the entity was relevant to during their next snapshot
+		}
+	}
 
-			// Store it into queue before broadcasting it
-			_createDestroyReplicationMessages.push_back( std::move( destroyMessage ) );
+	bool ReplicationManager::SetNetworkEntityPosition( uint32 network_entity_id, float32 pos_x, float32 pos_y )
+	{
+		NetworkEntityData* networkEntity = _networkEntitiesStorage.TryGetNetworkEntityFromId( network_entity_id );
+		if ( networkEntity == nullptr )
+		{
+			LOG_WARNING( "[ReplicationManager.%s] Network entity %u doesn't exist.", THIS_FUNCTION_NAME,
+			             network_entity_id );
+			return false;
 		}
+
+		networkEntity->positionX = pos_x;
+		networkEntity->positionY = pos_y;
+		return true;
+	}
+
+	void ReplicationManager::SetInterestManager( IInterestManager* interest_manager )
+	{
+		_interestManager = ( interest_manager != nullptr ) ? interest_manager : &_defaultInterestManager;
+		_isInterestManagerUpdated = false;
+	}
+
+	void ReplicationManager::SetEntityPriorityFunction( const EntityPriorityFunction& priority_function )
+	{
+		if ( priority_function )
+		{
+			_entityPriorityFunction = priority_function;
+		}
+		else
+		{
+			_entityPriorityFunction = EntityPriorityUtils::GetDefaultEntityPriority;
+		}
+	}
+
+	void ReplicationManager::SetMaxReplicationBytesPerTick( uint32 max_bytes )
+	{
+		_maxReplicationBytesPerTick = max_bytes;
 	}
 
 	void ReplicationManager::Server_ReplicateWorldState(
 	    MessageFactory& message_factory, uint32 remote_peer_id,
 	    std::vector< std::unique_ptr< ReplicationMessage > >& replication_messages )
 	{
-		auto cit = _createDestroyReplicationMessages.cbegin();
-		for ( ; cit != _createDestroyReplicationMessages.cend(); ++cit )
+		if ( !_isInterestManagerUpdated )
+		{
+			_interestManager->Update( _networkEntitiesStorage );
+			_isInterestManagerUpdated = true;
+		}
+
+		RemotePeerReplicationData& remotePeerData = _remotePeersReplicationData[ remote_peer_id ];
+		const size_t firstMessageIndex = replication_messages.size();
+		UpdateRelevantEntities( message_factory, remote_peer_id, remotePeerData, replication_messages );
+
+		// Create and destroy messages must always be sent, so they take their share of the budget first
+		uint32 budgetInBytes = _maxReplicationBytesPerTick;
+		for ( size_t i = firstMessageIndex; i < replication_messages.size(); ++i )
+		{
+			const uint32 messageSize = replication_messages[ i ]->Size();
+			budgetInBytes = ( messageSize < budgetInBytes ) ? ( budgetInBytes - messageSize ) : 0;
+		}
+
+		CreateUpdateReplicationMessages( message_factory, remote_peer_id, remotePeerData, budgetInBytes,
+		                                 replication_messages );
+	}
+
+	void ReplicationManager::UpdateRelevantEntities(
+	    MessageFactory& message_factory, uint32 remote_peer_id, RemotePeerReplicationData& remote_peer_data,
+	    std::vector< std::unique_ptr< ReplicationMessage > >& replication_messages )
+	{
+		_newRelevantEntityIds.clear();
+		_interestManager->GetRelevantEntities( remote_peer_id, _newRelevantEntityIds );
+		std::sort( _newRelevantEntityIds.begin(), _newRelevantEntityIds.end() );
+		_newRelevantEntityIds.erase( std::unique( _newRelevantEntityIds.begin(), _newRelevantEntityIds.end() ),
+		                             _newRelevantEntityIds.end() );
+
+		// Both lists are sorted, so walk them together to find the entities that left and entered. The entities that
+		// stay relevant keep their accumulated priority
+		const std::vector< uint32 >& oldRelevantEntityIds = remote_peer_data.relevantEntityIds;
+		_newPriorityAccumulators.clear();
+		uint32 oldIndex = 0;
+		uint32 newIndex = 0;
+		while ( oldIndex < oldRelevantEntityIds.size() || newIndex < _newRelevantEntityIds.size() )
 		{
-			const ReplicationMessage* source_replication_message = cit->get();
-
-			std::unique_ptr< Message > message = message_factory.LendMessage( MessageType::Replication );
-			std::unique_ptr< ReplicationMessage > replicationMessage(
-			    static_cast< ReplicationMessage* >( message.release() ) );
-
-			// TODO Create an operator= or something like that to avoid this spaguetti code
-			replicationMessage->SetOrdered( source_replication_message->GetHeader().isOrdered );
-			replicationMessage->SetReliability( source_replication_message->GetHeader().isReliable );
-			replicationMessage->replicationAction = source_replication_message->replicationAction;
-			replicationMessage->networkEntityId = source_replication_message->networkEntityId;
-			replicationMessage->controlledByPeerId = source_replication_message->controlledByPeerId;
-			replicationMessage->replicatedClassId = source_replication_message->replicatedClassId;
-			replicationMessage->dataSize = source_replication_message->dataSize;
-			if ( replicationMessage->dataSize > 0 )
+			const bool hasOld = oldIndex < oldRelevantEntityIds.size();
+			const bool hasNew = newIndex < _newRelevantEntityIds.size();
+			if ( hasOld && hasNew && oldRelevantEntityIds[ oldIndex ] == _newRelevantEntityIds[ newIndex ] )
 			{
-				// TODO Figure out if I can improve this. So far, for large snapshot updates data this can
-				// become heavy and slow. Can I avoid the copy somehow?
-				uint8* data = new uint8[ replicationMessage->dataSize ];
-				std::memcpy( data, source_replication_message->data, replicationMessage->dataSize );
-				replicationMessage->data = data;
+				_newPriorityAccumulators.push_back( remote_peer_data.priorityAccumulators[ oldIndex ] );
+				++oldIndex;
+				++newIndex;
+			}
+			else if ( hasOld && ( !hasNew || oldRelevantEntityIds[ oldIndex ] < _newRelevantEntityIds[ newIndex ] ) )
+			{
+				// The entity left or was removed. Forget its sent history, so a future delta isn't encoded against
+				// a baseline the remote peer no longer has
+				const uint32 networkEntityId = oldRelevantEntityIds[ oldIndex ];
+				remote_peer_data.snapshotTracker.RemoveEntity( networkEntityId );
+				replication_messages.push_back( CreateDestroyReplicationMessage( message_factory, networkEntityId ) );
+				++oldIndex;
+			}
+			else
+			{
+				const NetworkEntityData* networkEntityData =
+				    _networkEntitiesStorage.TryGetNetworkEntityFromId( _newRelevantEntityIds[ newIndex ] );
+				ASSERT( networkEntityData != nullptr,
+				        "[ReplicationManager.%s] The interest manager returned the unknown network entity %u.",
+				        THIS_FUNCTION_NAME, _newRelevantEntityIds[ newIndex ] );
+
+				SharedReplicationPayload payload = std::make_shared< ReplicationPayload >( 8 );
+				Buffer buffer( payload->GetData(), payload->GetSize() );
+				buffer.WriteFloat( networkEntityData->positionX );
+				buffer.WriteFloat( networkEntityData->positionY );
+				replication_messages.push_back( CreateCreateReplicationMessage(
+				    message_factory, networkEntityData->entityType, networkEntityData->controlledByPeerId,
+				    networkEntityData->id, payload ) );
+				_newPriorityAccumulators.push_back( 0.f );
+				++newIndex;
 			}
-
-			replication_messages.push_back( std::move( replicationMessage ) );
 		}
 
-		auto entity_it = _networkEntitiesStorage.GetNetworkEntities();
-		auto itPastToEnd = _networkEntitiesStorage.GetPastToEndNetworkEntities();
+		remote_peer_data.relevantEntityIds.swap( _newRelevantEntityIds );
+		remote_peer_data.priorityAccumulators.swap( _newPriorityAccumulators );
+	}
 
-		// TODO Remove this hardcoded size
-		const uint32 serialization_buffer_size = 128;
-		uint8* data = new uint8[ serialization_buffer_size ];
-		Buffer buffer( data, serialization_buffer_size );
-		for ( ; entity_it != itPastToEnd; ++entity_it )
+	void ReplicationManager::CreateUpdateReplicationMessages(
+	    MessageFactory& message_factory, uint32 remote_peer_id, RemotePeerReplicationData& remote_peer_data,
+	    uint32 budget_in_bytes, std::vector< std::unique_ptr< ReplicationMessage > >& replication_messages )
+	{
+		ClientSnapshotTracker& snapshotTracker = remote_peer_data.snapshotTracker;
+		snapshotTracker.BeginSnapshot( _currentSnapshotSequenceNumber );
+
+		const std::vector< uint32 >& relevantEntityIds = remote_peer_data.relevantEntityIds;
+		std::vector< float32 >& priorityAccumulators = remote_peer_data.priorityAccumulators;
+		const uint32 numberOfRelevantEntities = static_cast< uint32 >( relevantEntityIds.size() );
+
+		_entitiesToUpdate.clear();
+		for ( uint32 i = 0; i < numberOfRelevantEntities; ++i )
 		{
-			NetworkEntityData& networkEntityData = entity_it->second;
+			const NetworkEntityData* networkEntityData =
+			    _networkEntitiesStorage.TryGetNetworkEntityFromId( relevantEntityIds[ i ] );
+			priorityAccumulators[ i ] += _entityPriorityFunction( remote_peer_id, *networkEntityData );
+			_entitiesToUpdate.push_back( i );
+		}
 
-			if ( networkEntityData.controlledByPeerId == remote_peer_id )
+		// Highest accumulated priority first. Ties are broken by entity id so the order is deterministic
+		std::sort( _entitiesToUpdate.begin(), _entitiesToUpdate.end(),
+		           [ &priorityAccumulators ]( uint32 a, uint32 b )
+		           {
+			           if ( priorityAccumulators[ a ] != priorityAccumulators[ b ] )
+			           {
+				           return priorityAccumulators[ a ] > priorityAccumulators[ b ];
+			           }
+
+			           return a < b;
+		           } );
+
+		const uint32 maxEntityUpdates = _interestManager->GetMaxEntityUpdatesPerTick( remote_peer_id );
+		uint32 numberOfUpdates = 0;
+		auto it = _entitiesToUpdate.cbegin();
+		for ( ; it != _entitiesToUpdate.cend(); ++it )
+		{
+			if ( maxEntityUpdates > 0 && numberOfUpdates == maxEntityUpdates )
 			{
-				networkEntityData.communicationCallbacks.OnSerializeEntityStateForOwner.Execute( buffer );
+				break;
 			}
-			else
+
+			const uint32 networkEntityId = relevantEntityIds[ *it ];
+			NetworkEntityData* networkEntityData = _networkEntitiesStorage.TryGetNetworkEntityFromId( networkEntityId );
+			const bool isOwner = networkEntityData->controlledByPeerId == remote_peer_id;
+
+			EntityStateHistory& stateHistory =
+			    isOwner ? networkEntityData->ownerStateHistory : networkEntityData->nonOwnerStateHistory;
+			ReplicationPayloadCache& payloadCache =
+			    isOwner ? networkEntityData->ownerPayloadCache : networkEntityData->nonOwnerPayloadCache;
+
+			// Each entity state is serialized only once per snapshot, the first time a remote peer needs it
+			if ( !payloadCache.IsValid( _currentSnapshotSequenceNumber ) )
+			{
+				SerializeEntityState( *networkEntityData, isOwner, stateHistory, payloadCache );
+			}
+
+			if ( payloadCache.GetFullStatePayload() == nullptr )
+			{
+				continue;
+			}
+
+			std::unique_ptr< ReplicationMessage > message = CreateUpdateReplicationMessage(
+			    message_factory, *networkEntityData, stateHistory, payloadCache, snapshotTracker );
+
+			// A smaller update with less priority might still fit, so keep looking
+			const uint32 messageSize = message->Size();
+			if ( messageSize > budget_in_bytes )
 			{
-				// TODO Here is an error
-				networkEntityData.communicationCallbacks.OnSerializeEntityStateForNonOwner.Execute( buffer );
+				message_factory.ReleaseMessage( std::move( message ) );
+				continue;
 			}
 
-			std::unique_ptr< ReplicationMessage > message = CreateUpdateReplicationMessage(message_factory,
-			    networkEntityData.entityType, networkEntityData.id, networkEntityData.controlledByPeerId, buffer );
+			budget_in_bytes -= messageSize;
+			priorityAccumulators[ *it ] = 0.f;
 			replication_messages.push_back( std::move( message ) );
+			snapshotTracker.OnEntityUpdateSent( networkEntityId, _currentSnapshotSequenceNumber );
+			++numberOfUpdates;
+		}
+	}
 
-			buffer.Clear();
+	void ReplicationManager::Server_IncrementSnapshotSequenceNumber()
+	{
+		// Drop this snapshot's payloads. Messages that still reference them keep them alive until they are released
+		auto entity_it = _networkEntitiesStorage.GetNetworkEntities();
+		auto itPastToEnd = _networkEntitiesStorage.GetPastToEndNetworkEntities();
+		for ( ; entity_it != itPastToEnd; ++entity_it )
+		{
+			entity_it->second.ownerPayloadCache.Clear();
+			entity_it->second.nonOwnerPayloadCache.Clear();
 		}
 
-		delete[] data;
+		_isInterestManagerUpdated = false;
+		++_currentSnapshotSequenceNumber;
 	}
 
-	void ReplicationManager::ClearReplicationMessages( MessageFactory& message_factory )
+	void ReplicationManager::Server_ProcessReplicationAck( uint32 remote_peer_id, uint16 snapshot_sequence_number,
+	                                                       uint16 number_of_updates_received )
 	{
-		auto it = _createDestroyReplicationMessages.begin();
-		for ( ; it != _createDestroyReplicationMessages.end(); ++it )
+		auto it = _remotePeersReplicationData.find( remote_peer_id );
+		if ( it == _remotePeersReplicationData.end() )
 		{
-			message_factory.ReleaseMessage( std::move( *it ) );
+			LOG_WARNING( "[ReplicationManager.%s] Replication ack received from unknown remote peer %u. Ignoring it.",
+			             THIS_FUNCTION_NAME, remote_peer_id );
+			return;
 		}
-		_createDestroyReplicationMessages.clear();
+
+		it->second.snapshotTracker.AcknowledgeSnapshot( snapshot_sequence_number, number_of_updates_received );
+	}
+
+	void ReplicationManager::Server_RemoveRemotePeer( uint32 remote_peer_id )
+	{
+		_remotePeersReplicationData.erase( remote_peer_id );
+		_interestManager->RemoveRemotePeer( remote_peer_id );
 	}
 
-	void ReplicationManager::RemoveNetworkEntitiesControllerByPeer(MessageFactory& message_factory,uint32 id )
+	void ReplicationManager::RemoveNetworkEntitiesControllerByPeer( uint32 id )
 	{
 		std::vector< uint32 > network_entity_ids_to_remove;
 		const std::unordered_map< uint32, NetworkEntityData >& network_entities =
@@ -250,7 +491,7 @@ namespace NetLib
 		auto ids_to_remove_cit = network_entity_ids_to_remove.cbegin();
 		for ( ; ids_to_remove_cit != network_entity_ids_to_remove.cend(); ++ids_to_remove_cit )
 		{
-			RemoveNetworkEntity(message_factory ,*ids_to_remove_cit );
+			RemoveNetworkEntity( *ids_to_remove_cit );
 		}
 	}
 
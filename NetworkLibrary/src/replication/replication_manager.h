@@ -3,12 +3,17 @@
 
 #include <memory>
 #include <functional>
+#include <vector>
 
 #include "core/buffer.h"
 
 #include "communication/message.h"
 
 #include "replication/network_entity_storage.h"
+#include "replication/client_snapshot_tracker.h"
+#include "replication/replication_payload.h"
+#include "replication/grid_interest_manager.h"
+#include "replication/entity_priority.h"
 
 namespace NetLib
 {
@@ -17,22 +22,86 @@ namespace NetLib
 
 	static constexpr uint32 INVALID_NETWORK_ENTITY_ID = 0;
 
+	/// <summary>
+	/// Default number of replication bytes per remote peer and tick. It fits in a single packet, so entity updates
+	/// don't pile up in the transmission channel waiting for the next ticks.
+	/// </summary>
+	static constexpr uint32 DEFAULT_MAX_REPLICATION_BYTES_PER_TICK = 1200;
+
+	/// <summary>
+	/// <para>SERVER ONLY</para>
+	/// Replication state of a remote peer.
+	/// </summary>
+	struct RemotePeerReplicationData
+	{
+			RemotePeerReplicationData()
+			    : snapshotTracker()
+			    , relevantEntityIds()
+			    , priorityAccumulators()
+			{
+			}
+
+			ClientSnapshotTracker snapshotTracker;
+			// Sorted ids of the network entities created in the remote peer
+			std::vector< uint32 > relevantEntityIds;
+			// Accumulated priority of each relevant entity, at the same index as its id in relevantEntityIds
+			std::vector< float32 > priorityAccumulators;
+	};
+
 	class ReplicationManager
 	{
 		public:
 			ReplicationManager();
 
-			void CreateNetworkEntity( MessageFactory& message_factory, uint32 entityType, uint32 controlledByPeerId,
-			                          float32 posX, float32 posY );
-			void RemoveNetworkEntity( MessageFactory& message_factory, uint32 networkEntityId );
-
+			void CreateNetworkEntity( uint32 entityType, uint32 controlledByPeerId, float32 posX, float32 posY );
+			void RemoveNetworkEntity( uint32 networkEntityId );
+
+			/// <summary>
+			/// Updates the position the interest manager uses for the network entity. Call it whenever the entity
+			/// moves, before the replication tick.
+			/// </summary>
+			bool SetNetworkEntityPosition( uint32 network_entity_id, float32 pos_x, float32 pos_y );
+
+			/// <summary>
+			/// Replaces the interest manager. The replication manager doesn't take ownership of it. Pass nullptr to
+			/// restore the default GridInterestManager.
+			/// </summary>
+			void SetInterestManager( IInterestManager* interest_manager );
+
+			/// <summary>
+			/// Replaces the function that decides which entity updates are sent first. Pass nullptr to restore
+			/// EntityPriorityUtils::GetDefaultEntityPriority.
+			/// </summary>
+			void SetEntityPriorityFunction( const EntityPriorityFunction& priority_function );
+
+			/// <summary>
+			/// Sets the maximum number of replication bytes per remote peer and tick. Create and destroy messages are
+			/// always sent but they count against it. Entity updates that don't fit wait for the next ticks.
+			/// </summary>
+			void SetMaxReplicationBytesPerTick( uint32 max_bytes );
+
+			/// <summary>
+			/// Creates the replication messages of the current snapshot for a remote peer. Entities that became
+			/// relevant to it are created and the ones that stopped being relevant or were removed are destroyed.
+			/// Relevant entity updates are sent by accumulated priority until the bandwidth budget is spent. They are
+			/// delta compressed against the most recent snapshot the remote peer has fully acked, falling back to the
+			/// full state if there isn't any baseline available. Entity states are
+			/// serialized once per snapshot and their payloads are shared between the messages of all remote peers.
+			/// </summary>
 			void Server_ReplicateWorldState(
 			    MessageFactory& message_factory, uint32 remote_peer_id,
 			    std::vector< std::unique_ptr< ReplicationMessage > >& replication_messages );
 
-			void ClearReplicationMessages( MessageFactory& message_factory );
+			/// <summary>
+			/// Moves to the next snapshot. Call it once per replication tick, after replicating the world state to all
+			/// remote peers.
+			/// </summary>
+			void Server_IncrementSnapshotSequenceNumber();
+			void Server_ProcessReplicationAck( uint32 remote_peer_id, uint16 snapshot_sequence_number,
+			                                   uint16 number_of_updates_received );
+			void Server_RemoveRemotePeer( uint32 remote_peer_id );
 
-			void RemoveNetworkEntitiesControllerByPeer( MessageFactory& message_factory, uint32 id );
+			void RemoveNetworkEntitiesControllerByPeer( uint32 id );
 
 			template < typename Functor >
 			uint32 SubscribeToOnNetworkEntityCreate( Functor&& functor );
@@ -44,27 +113,62 @@ namespace NetLib
 			void SpawnNewNetworkEntity( uint32 replicated_class_id, uint32 network_entity_id,
 			                            uint32 controlled_by_peer_id, float32 pos_x, float32 pos_y );
 
-			std::unique_ptr< ReplicationMessage > CreateCreateReplicationMessage( MessageFactory& message_factory,
-			                                                                      uint32 entityType,
-			                                                                      uint32 controlledByPeerId,
-			                                                                      uint32 networkEntityId,
-			                                                                      const Buffer& dataBuffer );
-			std::unique_ptr< ReplicationMessage > CreateUpdateReplicationMessage( MessageFactory& message_factory,
-			                                                                      uint32 entityType,
-			                                                                      uint32 networkEntityId,
-			                                                                      uint32 controlledByPeerId,
-			                                                                      const Buffer& buffer );
+			std::unique_ptr< ReplicationMessage > CreateCreateReplicationMessage(
+			    MessageFactory& message_factory, uint32 entityType, uint32 controlledByPeerId, uint32 networkEntityId,
+			    const SharedReplicationPayload& payload );
+			std::unique_ptr< ReplicationMessage > CreateUpdateReplicationMessage(
+			    MessageFactory& message_factory, const NetworkEntityData& network_entity_data,
+			    const EntityStateHistory& state_history, ReplicationPayloadCache& payload_cache,
+			    const ClientSnapshotTracker& snapshot_tracker );
 			std::unique_ptr< ReplicationMessage > CreateDestroyReplicationMessage( MessageFactory& message_factory,
 			                                                                       uint32 networkEntityId );
 
+			/// <summary>
+			/// Creates the create and destroy messages of the entities that entered or left the relevant set of the
+			/// remote peer since the last snapshot.
+			/// </summary>
+			void UpdateRelevantEntities( MessageFactory& message_factory, uint32 remote_peer_id,
+			                             RemotePeerReplicationData& remote_peer_data,
+			                             std::vector< std::unique_ptr< ReplicationMessage > >& replication_messages );
+			void CreateUpdateReplicationMessages(
+			    MessageFactory& message_factory, uint32 remote_peer_id, RemotePeerReplicationData& remote_peer_data,
+			    uint32 budget_in_bytes, std::vector< std::unique_ptr< ReplicationMessage > >& replication_messages );
+
+			/// <summary>
+			/// Serializes the entity state of the current snapshot, stores it in the history and caches its payload.
+			/// The cached payload is nullptr if the state is bigger than MAX_REPLICATION_DATA_SIZE.
+			/// </summary>
+			void SerializeEntityState( NetworkEntityData& network_entity_data, bool for_owner,
+			                           EntityStateHistory& state_history, ReplicationPayloadCache& payload_cache );
+			/// <summary>
+			/// Returns nullptr if the baseline is not available or if the delta is not smaller than the full state.
+			/// </summary>
+			SharedReplicationPayload CreateDeltaPayload( const EntityStateHistory& state_history,
+			                                             uint16 baseline_snapshot_sequence_number ) const;
+
 			void CalculateNextNetworkEntityId();
 
 			NetworkEntityStorage _networkEntitiesStorage;
 
-			std::vector< std::unique_ptr< ReplicationMessage > > _createDestroyReplicationMessages;
-
 			uint32 _nextNetworkEntityId;
 
+			uint16 _currentSnapshotSequenceNumber;
+			std::unordered_map< uint32, RemotePeerReplicationData > _remotePeersReplicationData;
+
+			GridInterestManager _defaultInterestManager;
+			IInterestManager* _interestManager;
+			bool _isInterestManagerUpdated;
+			// Scratch list reused by every remote peer to gather its relevant entities
+			std::vector< uint32 > _newRelevantEntityIds;
+			std::vector< float32 > _newPriorityAccumulators;
+			// Scratch list with the indexes of the relevant entities sorted by priority
+			std::vector< uint32 > _entitiesToUpdate;
+
+			EntityPriorityFunction _entityPriorityFunction;
+			uint32 _maxReplicationBytesPerTick;
+			// Entity states are serialized here before being copied into their payload
+			std::vector< uint8 > _serializationBuffer;
+
 			std::function< void( const OnNetworkEntityCreateConfig& ) > _onNetworkEntityCreate;
 			std::function< void( uint32 ) > _onNetworkEntityDestroy;
 	};
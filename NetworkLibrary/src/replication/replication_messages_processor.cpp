@@ -5,20 +5,25 @@
 #include "asserts.h"
 
 #include "core/buffer.h"
+#include "core/bit_reader.h"
 
 #include "communication/message.h"
 
 #include "replication/replication_action_type.h"
 #include "replication/network_entity_communication_callbacks.h"
 #include "replication/on_network_entity_create_config.h"
+#include "replication/delta_compression_utils.h"
 
 #include <cassert>
+#include <cstring>
 
 namespace NetLib
 {
 	ReplicationMessagesProcessor::ReplicationMessagesProcessor()
 	    : _networkEntitiesStorage()
+	    , _receivedSnapshots()
 	    , _localPeerId( 0 )
+	    , _stateBuffer( MAX_REPLICATION_DATA_SIZE )
 	{
 	}
 
@@ -117,20 +122,88 @@ namespace NetLib
 			NetworkEntityData* entity_data = _networkEntitiesStorage.TryGetNetworkEntityFromId( networkEntityId );
 			assert( entity_data != nullptr );
 
-			// TODO Pass entity state to target entity
-			Buffer buffer( replicationMessage.data, replicationMessage.dataSize );
+			const bool isOwner = entity_data->controlledByPeerId == _localPeerId;
+			EntityStateHistory& stateHistory =
+			    isOwner ? entity_data->ownerStateHistory : entity_data->nonOwnerStateHistory;
+
+			uint8* stateData = _stateBuffer.data();
+			uint32 stateSize = 0;
+			if ( !RebuildEntityState( replicationMessage, stateHistory, stateData, stateSize ) )
+			{
+				LOG_WARNING( "Replication: Can't rebuild the state of entity %u from snapshot %hu. Ignoring message...",
+				             networkEntityId, replicationMessage.snapshotSequenceNumber );
+				return;
+			}
 
-			if ( entity_data->controlledByPeerId == _localPeerId )
+			// States too big for the history are never used as baseline by the server, so they are applied anyway
+			stateHistory.Store( replicationMessage.snapshotSequenceNumber, stateData, stateSize );
+			RegisterReceivedSnapshotUpdate( replicationMessage.snapshotSequenceNumber );
+
+			Buffer buffer( stateData, stateSize );
+			BitReader reader( buffer );
+
+			if ( isOwner )
 			{
-				entity_data->communicationCallbacks.OnUnserializeEntityStateForOwner.Execute( buffer );
+				entity_data->communicationCallbacks.OnUnserializeEntityStateForOwner.Execute( reader );
 			}
 			else
 			{
-				entity_data->communicationCallbacks.OnUnserializeEntityStateForNonOwner.Execute( buffer );
+				entity_data->communicationCallbacks.OnUnserializeEntityStateForNonOwner.Execute( reader );
 			}
 		}
 	}
 
+	bool ReplicationMessagesProcessor::RebuildEntityState( const ReplicationMessage& replicationMessage,
+	                                                       const EntityStateHistory& state_history, uint8* output,
+	                                                       uint32& output_size ) const
+	{
+		if ( !replicationMessage.isDeltaEncoded )
+		{
+			if ( replicationMessage.dataSize > MAX_REPLICATION_DATA_SIZE )
+			{
+				return false;
+			}
+
+			if ( replicationMessage.dataSize > 0 )
+			{
+				std::memcpy( output, replicationMessage.data, replicationMessage.dataSize );
+			}
+
+			output_size = replicationMessage.dataSize;
+			return true;
+		}
+
+		const EntityStateSnapshot* baseline =
+		    state_history.TryGet( replicationMessage.baselineSnapshotSequenceNumber );
+		if ( baseline == nullptr )
+		{
+			return false;
+		}
+
+		if ( !DeltaCompressionUtils::DecodeDelta( baseline->data.data(), baseline->size, replicationMessage.data,
+		                                          replicationMessage.dataSize, output ) )
+		{
+			return false;
+		}
+
+		output_size = baseline->size;
+		return true;
+	}
+
+	void ReplicationMessagesProcessor::RegisterReceivedSnapshotUpdate( uint16 snapshot_sequence_number )
+	{
+		ReceivedSnapshot& snapshot = _receivedSnapshots[ snapshot_sequence_number % SNAPSHOT_HISTORY_SIZE ];
+		if ( !snapshot.isValid || snapshot.sequenceNumber != snapshot_sequence_number )
+		{
+			snapshot.sequenceNumber = snapshot_sequence_number;
+			snapshot.numberOfUpdatesReceived = 0;
+			snapshot.isValid = true;
+		}
+
+		++snapshot.numberOfUpdatesReceived;
+		snapshot.isPendingAck = true;
+	}
+
 	void ReplicationMessagesProcessor::ProcessReceivedDestroyReplicationMessage(
 	    const ReplicationMessage& replicationMessage )
 	{
@@ -152,6 +225,9 @@ namespace NetLib
 		{
 			// Destroy object
 			_onNetworkEntityDestroy( networkEntity->id );
+
+			// Remove network entity data. The server creates it again if it becomes relevant again
+			_networkEntitiesStorage.RemoveNetworkEntity( networkEntityId );
 		}
 	}
 } // namespace NetLib
@@ -1,5 +1,9 @@
 #pragma once
 #include "replication/network_entity_storage.h"
+#include "replication/entity_state_history.h"
+
+#include <array>
+#include <vector>
 
 namespace NetLib
 {
@@ -15,6 +19,13 @@ namespace NetLib
 
 			void SetLocalClientId( uint32 id );
 
+			/// <summary>
+			/// Calls functor( snapshot_sequence_number, number_of_updates_received ) for every snapshot that has
+			/// received updates since the last call. The server needs these acks for delta compressing entity states.
+			/// </summary>
+			template < typename Functor >
+			void Client_ConsumePendingSnapshotAcks( Functor&& functor );
+
 			template < typename Functor >
 			uint32 SubscribeToOnNetworkEntityCreate( Functor&& functor );
 
@@ -28,13 +39,54 @@ namespace NetLib
 
 			void RemoveNetworkEntity( uint32 networkEntityId );
 
+			/// <summary>
+			/// Writes the full entity state carried by an update message into output, decoding it against its
+			/// baseline if it is delta encoded. Output must fit MAX_REPLICATION_DATA_SIZE bytes.
+			/// </summary>
+			bool RebuildEntityState( const ReplicationMessage& replicationMessage,
+			                         const EntityStateHistory& state_history, uint8* output,
+			                         uint32& output_size ) const;
+			void RegisterReceivedSnapshotUpdate( uint16 snapshot_sequence_number );
+
+			struct ReceivedSnapshot
+			{
+					ReceivedSnapshot()
+					    : sequenceNumber( 0 )
+					    , numberOfUpdatesReceived( 0 )
+					    , isValid( false )
+					    , isPendingAck( false )
+					{
+					}
+
+					uint16 sequenceNumber;
+					uint16 numberOfUpdatesReceived;
+					bool isValid;
+					bool isPendingAck;
+			};
+
 			NetworkEntityStorage _networkEntitiesStorage;
+			std::array< ReceivedSnapshot, SNAPSHOT_HISTORY_SIZE > _receivedSnapshots;
 			std::function< void( const OnNetworkEntityCreateConfig& ) > _onNetworkEntityCreate;
 			std::function< void( uint32 ) > _onNetworkEntityDestroy;
 
 			uint32 _localPeerId;
+			// Entity states are rebuilt here before being unserialized
+			std::vector< uint8 > _stateBuffer;
 	};
 
+	template < typename Functor >
+	inline void ReplicationMessagesProcessor::Client_ConsumePendingSnapshotAcks( Functor&& functor )
+	{
+		for ( auto it = _receivedSnapshots.begin(); it != _receivedSnapshots.end(); ++it )
+		{
+			if ( it->isValid && it->isPendingAck )
+			{
+				functor( it->sequenceNumber, it->numberOfUpdatesReceived );
+				it->isPendingAck = false;
+			}
+		}
+	}
+
 	template < typename Functor >
 	inline uint32 ReplicationMessagesProcessor::SubscribeToOnNetworkEntityCreate( Functor&& functor )
 	{
@@ -0,0 +1,78 @@
+#include "replication_payload.h"
+
+namespace NetLib
+{
+	ReplicationPayload::ReplicationPayload( uint32 size )
+	    : _data( size, 0 )
+	{
+	}
+
+	ReplicationPayload::ReplicationPayload( const uint8* data, uint32 size )
+	    : _data( data, data + size )
+	{
+	}
+
+	ReplicationPayloadCache::ReplicationPayloadCache()
+	    : _isValid( false )
+	    , _snapshotSequenceNumber( 0 )
+	    , _fullStatePayload()
+	    , _deltaPayloads()
+	    , _numberOfDeltaPayloads( 0 )
+	{
+	}
+
+	bool ReplicationPayloadCache::IsValid( uint16 snapshot_sequence_number ) const
+	{
+		return _isValid && _snapshotSequenceNumber == snapshot_sequence_number;
+	}
+
+	void ReplicationPayloadCache::Reset( uint16 snapshot_sequence_number,
+	                                     const SharedReplicationPayload& full_state_payload )
+	{
+		Clear();
+		_isValid = true;
+		_snapshotSequenceNumber = snapshot_sequence_number;
+		_fullStatePayload = full_state_payload;
+	}
+
+	void ReplicationPayloadCache::Clear()
+	{
+		for ( uint32 i = 0; i < _numberOfDeltaPayloads; ++i )
+		{
+			_deltaPayloads[ i ].payload.reset();
+		}
+
+		_numberOfDeltaPayloads = 0;
+		_fullStatePayload.reset();
+		_isValid = false;
+	}
+
+	bool ReplicationPayloadCache::TryGetDeltaPayload( uint16 baseline_snapshot_sequence_number,
+	                                                  SharedReplicationPayload& payload ) const
+	{
+		for ( uint32 i = 0; i < _numberOfDeltaPayloads; ++i )
+		{
+			if ( _deltaPayloads[ i ].baselineSnapshotSequenceNumber == baseline_snapshot_sequence_number )
+			{
+				payload = _deltaPayloads[ i ].payload;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void ReplicationPayloadCache::AddDeltaPayload( uint16 baseline_snapshot_sequence_number,
+	                                               const SharedReplicationPayload& payload )
+	{
+		if ( _numberOfDeltaPayloads == MAX_CACHED_DELTA_PAYLOADS )
+		{
+			return;
+		}
+
+		DeltaPayloadEntry& entry = _deltaPayloads[ _numberOfDeltaPayloads ];
+		entry.baselineSnapshotSequenceNumber = baseline_snapshot_sequence_number;
+		entry.payload = payload;
+		++_numberOfDeltaPayloads;
+	}
+} // namespace NetLib
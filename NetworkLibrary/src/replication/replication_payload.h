@@ -0,0 +1,84 @@
+#pragma once
+#include "numeric_types.h"
+
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace NetLib
+{
+	/// <summary>
+	/// Serialized replication data that several replication messages can reference at the same time. The server
+	/// creates one per entity state and snapshot, and the messages of every remote peer point to it instead of owning
+	/// a copy. It is freed once the last message referencing it is released. Don't modify it once it is shared.
+	/// </summary>
+	class ReplicationPayload
+	{
+		public:
+			ReplicationPayload( uint32 size );
+			ReplicationPayload( const uint8* data, uint32 size );
+
+			uint8* GetData() { return _data.data(); }
+			const uint8* GetData() const { return _data.data(); }
+			uint32 GetSize() const { return static_cast< uint32 >( _data.size() ); }
+
+		private:
+			std::vector< uint8 > _data;
+	};
+
+	typedef std::shared_ptr< ReplicationPayload > SharedReplicationPayload;
+
+	/// <summary>
+	/// Maximum number of different baselines whose delta payloads are cached per entity state and snapshot. Remote
+	/// peers with a baseline that doesn't fit get their delta encoded separately.
+	/// </summary>
+	constexpr uint32 MAX_CACHED_DELTA_PAYLOADS = 4;
+
+	/// <summary>
+	/// <para>SERVER ONLY</para>
+	/// Payloads of an entity state created during the current snapshot. The full state payload is shared by all remote
+	/// peers and the delta payloads by those remote peers that have the same baseline.
+	/// </summary>
+	class ReplicationPayloadCache
+	{
+		public:
+			ReplicationPayloadCache();
+
+			bool IsValid( uint16 snapshot_sequence_number ) const;
+
+			/// <summary>
+			/// Drops the payloads of the previous snapshot and stores the full state payload of the given one.
+			/// </summary>
+			void Reset( uint16 snapshot_sequence_number, const SharedReplicationPayload& full_state_payload );
+			void Clear();
+
+			const SharedReplicationPayload& GetFullStatePayload() const { return _fullStatePayload; }
+
+			/// <summary>
+			/// Returns true if a delta against the baseline has already been encoded during this snapshot. The
+			/// payload is nullptr if that delta wasn't worth sending.
+			/// </summary>
+			bool TryGetDeltaPayload( uint16 baseline_snapshot_sequence_number,
+			                         SharedReplicationPayload& payload ) const;
+			void AddDeltaPayload( uint16 baseline_snapshot_sequence_number, const SharedReplicationPayload& payload );
+
+		private:
+			struct DeltaPayloadEntry
+			{
+					DeltaPayloadEntry()
+					    : baselineSnapshotSequenceNumber( 0 )
+					    , payload()
+					{
+					}
+
+					uint16 baselineSnapshotSequenceNumber;
+					SharedReplicationPayload payload;
+			};
+
+			bool _isValid;
+			uint16 _snapshotSequenceNumber;
+			SharedReplicationPayload _fullStatePayload;
+			std::array< DeltaPayloadEntry, MAX_CACHED_DELTA_PAYLOADS > _deltaPayloads;
+			uint32 _numberOfDeltaPayloads;
+	};
+} // namespace NetLib
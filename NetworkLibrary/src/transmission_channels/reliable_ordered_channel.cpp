@@ -6,35 +6,51 @@
 #include "communication/message.h"
 #include "communication/message_factory.h"
 #include "communication/network_packet.h"
-
-#include "utils/bitwise_utils.h"
+#include "communication/message_utils.h"
 
 #include "core/time_clock.h"
 #include "core/Buffer.h"
-#include "core/socket.h"
+#include "core/datagram_send_queue.h"
 #include "core/address.h"
 
 #include "metrics/metrics_handler.h"
 #include "metrics/metric_types.h"
 
 #include "logger.h"
+#include "asserts.h"
 #include "AlgorithmUtils.h"
 
 namespace NetLib
 {
 	ReliableOrderedChannel::ReliableOrderedChannel( MessageFactory* message_factory )
 	    : TransmissionChannel( TransmissionChannelType::ReliableOrdered, message_factory )
+	    , _unackedMessageSlots()
+	    , _oldestUnackedMessageSequenceNumber( GetNextMessageSequenceNumber() )
+	    , _messagesToResend()
+	    , _messagesToResendHead( 0 )
+	    , _messagesToResendCount( 0 )
+	    , _numberOfMessagesPendingToResend( 0 )
 	    , _lastAckedMessageSequenceNumber( 0 )
 	    , _nextOrderedMessageSequenceNumber( 1 )
-	    , _reliableMessageEntriesBufferSize( ACK_BITS_SIZE )
+	    , _reliableMessageEntriesBufferSize( RELIABLE_MESSAGES_WINDOW_SIZE )
+	    , _ackWindowSize( MIN_ACK_WINDOW_SIZE )
 	    , _areUnsentACKs( false )
 	    , _rttMilliseconds( 0 )
+	    , _unorderedMessageSlots()
+	    , _fragmentationBuffer()
+	    , _reassemblyBuffer()
+	    , _numberOfReassembledFragments( 0 )
+	    , _numberOfFragmentsToReassemble( 0 )
 	{
 		_remotePeerReliableMessageEntries.reserve( _reliableMessageEntriesBufferSize );
 		for ( uint32 i = 0; i < _reliableMessageEntriesBufferSize; ++i )
 		{
 			_remotePeerReliableMessageEntries.emplace_back();
 		}
+
+		_unackedMessageSlots.resize( RELIABLE_MESSAGES_WINDOW_SIZE );
+		_messagesToResend.resize( RELIABLE_MESSAGES_WINDOW_SIZE );
+		_unorderedMessageSlots.resize( RELIABLE_MESSAGES_WINDOW_SIZE );
 	}
 
 	ReliableOrderedChannel::ReliableOrderedChannel( ReliableOrderedChannel&& other ) noexcept
@@ -48,12 +64,20 @@ namespace NetLib
 	    _areUnsentACKs( std::move( other._areUnsentACKs ) )
 	    , // unnecessary move, just in case I change that type
 	    _rttMilliseconds( std::move( other._rttMilliseconds ) )
+	    , _ackWindowSize( other._ackWindowSize )
 	    , // unnecessary move, just in case I change that type
-	    _unackedReliableMessages( std::move( other._unackedReliableMessages ) )
-	    , _unackedReliableMessageTimeouts( std::move( other._unackedReliableMessageTimeouts ) )
+	    _unackedMessageSlots( std::move( other._unackedMessageSlots ) )
+	    , _oldestUnackedMessageSequenceNumber( other._oldestUnackedMessageSequenceNumber )
+	    , _messagesToResend( std::move( other._messagesToResend ) )
+	    , _messagesToResendHead( other._messagesToResendHead )
+	    , _messagesToResendCount( other._messagesToResendCount )
+	    , _numberOfMessagesPendingToResend( other._numberOfMessagesPendingToResend )
 	    , _remotePeerReliableMessageEntries( std::move( other._remotePeerReliableMessageEntries ) )
-	    , _unackedMessagesSendTimes( std::move( other._unackedMessagesSendTimes ) )
-	    , _unorderedMessagesWaitingForPrevious( std::move( other._unorderedMessagesWaitingForPrevious ) )
+	    , _unorderedMessageSlots( std::move( other._unorderedMessageSlots ) )
+	    , _fragmentationBuffer( std::move( other._fragmentationBuffer ) )
+	    , _reassemblyBuffer( std::move( other._reassemblyBuffer ) )
+	    , _numberOfReassembledFragments( other._numberOfReassembledFragments )
+	    , _numberOfFragmentsToReassemble( other._numberOfFragmentsToReassemble )
 	{
 	}
 
@@ -71,17 +95,25 @@ namespace NetLib
 		    std::move( other._reliableMessageEntriesBufferSize ); // unnecessary move, just in case I change that type
 		_areUnsentACKs = std::move( other._areUnsentACKs );       // unnecessary move, just in case I change that type
 		_rttMilliseconds = std::move( other._rttMilliseconds );   // unnecessary move, just in case I change that type
-		_unackedReliableMessages = std::move( other._unackedReliableMessages );
-		_unackedReliableMessageTimeouts = std::move( other._unackedReliableMessageTimeouts );
+		_ackWindowSize = other._ackWindowSize;
+		_unackedMessageSlots = std::move( other._unackedMessageSlots );
+		_oldestUnackedMessageSequenceNumber = other._oldestUnackedMessageSequenceNumber;
+		_messagesToResend = std::move( other._messagesToResend );
+		_messagesToResendHead = other._messagesToResendHead;
+		_messagesToResendCount = other._messagesToResendCount;
+		_numberOfMessagesPendingToResend = other._numberOfMessagesPendingToResend;
 		_remotePeerReliableMessageEntries = std::move( other._remotePeerReliableMessageEntries );
-		_unackedMessagesSendTimes = std::move( other._unackedMessagesSendTimes );
-		_unorderedMessagesWaitingForPrevious = std::move( other._unorderedMessagesWaitingForPrevious );
+		_unorderedMessageSlots = std::move( other._unorderedMessageSlots );
+		_fragmentationBuffer = std::move( other._fragmentationBuffer );
+		_reassemblyBuffer = std::move( other._reassemblyBuffer );
+		_numberOfReassembledFragments = other._numberOfReassembledFragments;
+		_numberOfFragmentsToReassemble = other._numberOfFragmentsToReassemble;
 
 		TransmissionChannel::operator=( std::move( other ) );
 		return *this;
 	}
 
-	bool ReliableOrderedChannel::CreateAndSendPacket( Socket& socket, const Address& address,
+	bool ReliableOrderedChannel::CreateAndSendPacket( DatagramSendQueue& send_queue, const Address& address,
 	                                                  Metrics::MetricsHandler& metrics_handler )
 	{
 		bool result = false;
@@ -91,10 +123,16 @@ namespace NetLib
 			return result;
 		}
 
-		NetworkPacket packet;
+		NetworkPacket& packet = send_queue.GetOutgoingPacket();
+		ASSERT( packet.GetNumberOfMessages() == 0, "The outgoing packet must be empty before using it" );
+
+		// Set packet header first. The size of the ACK bits varies, so it must be known before filling the packet
+		AckBitfield acks;
+		GenerateACKs( acks );
+		packet.SetHeaderACKs( acks );
+		packet.SetHeaderLastAcked( _lastAckedMessageSequenceNumber );
+		packet.SetHeaderChannelType( GetType() );
 
-		// TODO Check somewhere if there is a message larger than the maximum packet size. Log a warning saying that the
-		// message will never get sent and delete it.
 		// TODO Include data prefix in packet's header and check if the data prefix is correct when receiving a packet
 
 		// Check if we should include a message to the packet
@@ -119,24 +157,20 @@ namespace NetLib
 			isThereCapacityLeft = packet.CanMessageFit( GetSizeOfNextUnsentMessage() );
 		}
 
-		// Set packet header
-		const uint32 acks = GenerateACKs();
-		packet.SetHeaderACKs( acks );
-		packet.SetHeaderLastAcked( _lastAckedMessageSequenceNumber );
-		packet.SetHeaderChannelType( GetType() );
-
-		// Serialize packet
-		uint8* bufferData = new uint8[ packet.Size() ];
-		Buffer buffer( bufferData, packet.Size() );
-		packet.Write( buffer );
-
-		// Send packet
-		socket.SendTo( buffer.GetData(), buffer.GetSize(), address );
+		// Serialize packet straight into the send queue, no intermediate buffer needed
+		const uint32 packetSize = packet.Size();
+		uint8* bufferData = send_queue.AcquireDatagramBuffer( packetSize );
+		if ( bufferData != nullptr )
+		{
+			Buffer buffer( bufferData, packetSize );
+			packet.Write( buffer );
+			send_queue.CommitDatagram( packetSize, address );
+		}
 
-		// TODO See what happens when the socket couldn't send the packet
+		// TODO See what happens when the send queue couldn't send the packet
 		if ( metrics_handler.HasMetric( Metrics::MetricType::UPLOAD_BANDWIDTH ) )
 		{
-			metrics_handler.AddValue( Metrics::MetricType::UPLOAD_BANDWIDTH, packet.Size() );
+			metrics_handler.AddValue( Metrics::MetricType::UPLOAD_BANDWIDTH, packetSize );
 		}
 
 		_areUnsentACKs = false;
@@ -153,8 +187,6 @@ namespace NetLib
 			}
 		}
 
-		delete[] bufferData;
-
 		result = true;
 		return result;
 	}
@@ -168,19 +200,76 @@ namespace NetLib
 			return false;
 		}
 
+		if ( message->Size() > MAX_FRAGMENT_DATA_SIZE )
+		{
+			return AddFragmentedMessageToSend( std::move( message ) );
+		}
+
 		_unsentMessages.push_back( std::move( message ) );
 		return true;
 	}
 
+	bool ReliableOrderedChannel::AddFragmentedMessageToSend( std::unique_ptr< Message > message )
+	{
+		const uint32 maxMessageSize = message->Size();
+		if ( maxMessageSize > MAX_NUMBER_OF_FRAGMENTS * MAX_FRAGMENT_DATA_SIZE )
+		{
+			LOG_ERROR( "[ReliableOrderedChannel.%s] Message of type %hhu is too big to be sent. Size: %u, Max: %u",
+			           THIS_FUNCTION_NAME, message->GetHeader().type, maxMessageSize,
+			           MAX_NUMBER_OF_FRAGMENTS * MAX_FRAGMENT_DATA_SIZE );
+			_messageFactory->ReleaseMessage( std::move( message ) );
+			return false;
+		}
+
+		// Serialize the whole message, header included, so the remote peer can read it back as any other message
+		_fragmentationBuffer.resize( maxMessageSize );
+		Buffer buffer( _fragmentationBuffer.data(), maxMessageSize );
+		message->Write( buffer );
+		const uint32 messageSize = buffer.GetAccessIndex();
+		const uint32 numberOfFragments = ( messageSize + MAX_FRAGMENT_DATA_SIZE - 1 ) / MAX_FRAGMENT_DATA_SIZE;
+		_messageFactory->ReleaseMessage( std::move( message ) );
+
+		for ( uint32 i = 0; i < numberOfFragments; ++i )
+		{
+			const uint32 offset = i * MAX_FRAGMENT_DATA_SIZE;
+			const uint32 fragmentSize =
+			    ( messageSize - offset < MAX_FRAGMENT_DATA_SIZE ) ? messageSize - offset : MAX_FRAGMENT_DATA_SIZE;
+
+			std::unique_ptr< Message > fragmentMessage = _messageFactory->LendMessage( MessageType::Fragment );
+			fragmentMessage->SetReliability( true );
+			fragmentMessage->SetOrdered( true );
+
+			FragmentMessage& fragment = static_cast< FragmentMessage& >( *fragmentMessage );
+			fragment.fragmentIndex = static_cast< uint8 >( i );
+			fragment.numberOfFragments = static_cast< uint8 >( numberOfFragments );
+			fragment.SetData( _fragmentationBuffer.data() + offset, static_cast< uint16 >( fragmentSize ) );
+
+			_unsentMessages.push_back( std::move( fragmentMessage ) );
+		}
+
+		return true;
+	}
+
 	bool ReliableOrderedChannel::ArePendingMessagesToSend() const
 	{
-		return ( !_unsentMessages.empty() || AreUnackedMessagesToResend() );
+		return ( CanSendNewMessage() || _numberOfMessagesPendingToResend > 0 );
+	}
+
+	bool ReliableOrderedChannel::CanSendNewMessage() const
+	{
+		if ( _unsentMessages.empty() )
+		{
+			return false;
+		}
+
+		const UnackedMessageSlot& slot = _unackedMessageSlots[ GetWindowIndex( GetNextMessageSequenceNumber() ) ];
+		return slot.isAcked && !slot.isPendingToResend;
 	}
 
 	std::unique_ptr< Message > ReliableOrderedChannel::GetMessageToSend( Metrics::MetricsHandler& metrics_handler )
 	{
 		std::unique_ptr< Message > message = nullptr;
-		if ( !_unsentMessages.empty() )
+		if ( CanSendNewMessage() )
 		{
 			message = std::move( _unsentMessages[ 0 ] );
 			_unsentMessages.erase( _unsentMessages.begin() );
@@ -189,7 +278,18 @@ namespace NetLib
 			IncreaseMessageSequenceNumber();
 
 			message->SetHeaderPacketSequenceNumber( sequenceNumber );
-			SetUnackedMessageSendTime( sequenceNumber );
+
+			// Reserve its slot. The message is put back once it has been serialized
+			UnackedMessageSlot& slot = _unackedMessageSlots[ GetWindowIndex( sequenceNumber ) ];
+			slot.sequenceNumber = sequenceNumber;
+			slot.sendTimeMilliseconds = static_cast< uint32 >( TimeClock::GetInstance().GetLocalTimeMilliseconds() );
+			slot.isAcked = false;
+
+			if ( message->GetHeader().type == MessageType::Fragment &&
+			     metrics_handler.HasMetric( Metrics::MetricType::SENT_FRAGMENTS ) )
+			{
+				metrics_handler.AddValue( Metrics::MetricType::SENT_FRAGMENTS, 1 );
+			}
 		}
 		else
 		{
@@ -208,25 +308,14 @@ namespace NetLib
 
 	uint32 ReliableOrderedChannel::GetSizeOfNextUnsentMessage() const
 	{
-		if ( !ArePendingMessagesToSend() )
-		{
-			return 0;
-		}
-
-		if ( !_unsentMessages.empty() )
+		if ( CanSendNewMessage() )
 		{
 			return _unsentMessages.front()->Size();
 		}
-		else
-		{
-			// Get next unacked message's size
-			int32 index = TryGetNextUnackedMessageIndexToResend();
-
-			std::list< std::unique_ptr< Message > >::const_iterator cit = _unackedReliableMessages.cbegin();
-			std::advance( cit, index );
 
-			return ( *cit )->Size();
-		}
+		// Get next unacked message's size
+		const UnackedMessageSlot* slot = TryGetNextUnackedMessageSlotToResend();
+		return ( slot != nullptr ) ? slot->message->Size() : 0;
 	}
 
 	bool ReliableOrderedChannel::IsMessageSuitable( const MessageHeader& header ) const
@@ -264,16 +353,29 @@ namespace NetLib
 				metrics_handler.AddValue( Metrics::MetricType::DUPLICATE_MESSAGES, 1 );
 			}
 
+			// Ack it again. The remote peer resends it because all the ACKs that covered it got lost, and it would
+			// keep resending it forever otherwise
+			AckReliableMessage( messageSequenceNumber );
+
 			// Release duplicate message
 			_messageFactory->ReleaseMessage( std::move( message ) );
 		}
+		else if ( static_cast< uint16 >( messageSequenceNumber - _nextOrderedMessageSequenceNumber ) >=
+		          RELIABLE_MESSAGES_WINDOW_SIZE )
+		{
+			// There is no room to keep it until the previous messages arrive. It isn't acked so the remote peer will
+			// resend it later
+			LOG_WARNING( "The message with ID = %hu is too far ahead of the next expected one (%hu). Ignoring it...",
+			             messageSequenceNumber, _nextOrderedMessageSequenceNumber );
+			_messageFactory->ReleaseMessage( std::move( message ) );
+		}
 		else
 		{
 			LOG_INFO( "New message received" );
 			AckReliableMessage( messageSequenceNumber );
 			if ( messageSequenceNumber == _nextOrderedMessageSequenceNumber )
 			{
-				ProcessOrderedMessage( std::move( message ) );
+				ProcessOrderedMessage( std::move( message ), metrics_handler );
 			}
 			else
 			{
@@ -305,213 +407,235 @@ namespace NetLib
 		return messageToReturn;
 	}
 
-	bool ReliableOrderedChannel::AreUnackedMessagesToResend() const
+	std::unique_ptr< Message > ReliableOrderedChannel::TryGetUnackedMessageToResend()
 	{
-		std::list< float32 >::const_iterator cit = _unackedReliableMessageTimeouts.cbegin();
-		bool found = false;
-		while ( cit != _unackedReliableMessageTimeouts.cend() && !found )
+		while ( _messagesToResendCount > 0 )
 		{
-			const float32 timeout = *cit;
-			if ( timeout <= 0 )
+			const uint16 sequenceNumber = _messagesToResend[ _messagesToResendHead ];
+			_messagesToResendHead = ( _messagesToResendHead + 1 ) % RELIABLE_MESSAGES_WINDOW_SIZE;
+			--_messagesToResendCount;
+
+			// Skip the messages that got acked while waiting
+			UnackedMessageSlot& slot = _unackedMessageSlots[ GetWindowIndex( sequenceNumber ) ];
+			slot.isPendingToResend = false;
+			if ( !slot.isAcked )
 			{
-				found = true;
+				--_numberOfMessagesPendingToResend;
+				return std::move( slot.message );
 			}
-
-			++cit;
 		}
 
-		return found;
+		return nullptr;
 	}
 
-	std::unique_ptr< Message > ReliableOrderedChannel::TryGetUnackedMessageToResend()
+	const UnackedMessageSlot* ReliableOrderedChannel::TryGetNextUnackedMessageSlotToResend() const
 	{
-		const int32 index = TryGetNextUnackedMessageIndexToResend();
-		if ( index == -1 )
+		for ( uint32 i = 0; i < _messagesToResendCount; ++i )
 		{
-			return nullptr;
+			const uint16 sequenceNumber =
+			    _messagesToResend[ ( _messagesToResendHead + i ) % RELIABLE_MESSAGES_WINDOW_SIZE ];
+			const UnackedMessageSlot& slot = _unackedMessageSlots[ GetWindowIndex( sequenceNumber ) ];
+			if ( !slot.isAcked )
+			{
+				return &slot;
+			}
 		}
 
-		std::unique_ptr< Message > message = RemoveUnackedMessageFromBufferAtIndex( index );
+		return nullptr;
+	}
 
-		return std::move( message );
+	void ReliableOrderedChannel::AddUnackedMessage( std::unique_ptr< Message > message )
+	{
+		const uint16 sequenceNumber = message->GetHeader().messageSequenceNumber;
+		UnackedMessageSlot& slot = _unackedMessageSlots[ GetWindowIndex( sequenceNumber ) ];
+		ASSERT( !slot.isAcked && slot.sequenceNumber == sequenceNumber,
+		        "[ReliableOrderedChannel.%s] The slot of the message %hu is not reserved", THIS_FUNCTION_NAME,
+		        sequenceNumber );
+
+		slot.message = std::move( message );
+		slot.timeout = GetRetransmissionTimeout();
+		LOG_INFO( "Retransmission Timeout: %f", slot.timeout );
 	}
 
-	int32 ReliableOrderedChannel::TryGetNextUnackedMessageIndexToResend() const
+	void ReliableOrderedChannel::ProcessOrderedMessage( std::unique_ptr< Message > message,
+	                                                    Metrics::MetricsHandler& metrics_handler )
 	{
-		int32 index = 0;
-		std::list< float32 >::const_iterator cit = _unackedReliableMessageTimeouts.cbegin();
-		bool found = false;
-		while ( cit != _unackedReliableMessageTimeouts.cend() && !found )
+		// Add message to the ready to be processed buffer
+		AddReadyToProcessMessage( std::move( message ), metrics_handler );
+
+		// Increment the next ordered message sequence number expected
+		++_nextOrderedMessageSequenceNumber;
+
+		// Check if with this new message received we can process other newer (out of order) messages received in the
+		// previous states.
+		std::unique_ptr< Message >* slot =
+		    &_unorderedMessageSlots[ GetWindowIndex( _nextOrderedMessageSequenceNumber ) ];
+		while ( *slot != nullptr )
 		{
-			float32 timeout = *cit;
-			if ( timeout <= 0 )
-			{
-				found = true;
-			}
-			else
-			{
-				++index;
-				++cit;
-			}
+			AddReadyToProcessMessage( std::move( *slot ), metrics_handler );
+			++_nextOrderedMessageSequenceNumber;
+			slot = &_unorderedMessageSlots[ GetWindowIndex( _nextOrderedMessageSequenceNumber ) ];
 		}
+	}
 
-		if ( !found )
+	void ReliableOrderedChannel::AddReadyToProcessMessage( std::unique_ptr< Message > message,
+	                                                       Metrics::MetricsHandler& metrics_handler )
+	{
+		if ( message->GetHeader().type != MessageType::Fragment )
 		{
-			index = -1;
+			_readyToProcessMessages.push( std::move( message ) );
+			return;
 		}
 
-		return index;
-	}
+		if ( metrics_handler.HasMetric( Metrics::MetricType::RECEIVED_FRAGMENTS ) )
+		{
+			metrics_handler.AddValue( Metrics::MetricType::RECEIVED_FRAGMENTS, 1 );
+		}
 
-	void ReliableOrderedChannel::AddUnackedMessage( std::unique_ptr< Message > message )
-	{
-		_unackedReliableMessages.push_back( std::move( message ) );
-		const float32 retransmissionTimeout = GetRetransmissionTimeout();
-		LOG_INFO( "Retransmission Timeout: %f", retransmissionTimeout );
-		_unackedReliableMessageTimeouts.push_back( retransmissionTimeout );
+		std::unique_ptr< Message > reassembledMessage =
+		    ReassembleFragment( static_cast< const FragmentMessage& >( *message ) );
+		if ( reassembledMessage != nullptr )
+		{
+			// The message takes the sequence number of its last fragment, which is the one it is delivered at
+			reassembledMessage->SetHeaderPacketSequenceNumber( message->GetHeader().messageSequenceNumber );
+			_readyToProcessMessages.push( std::move( reassembledMessage ) );
+		}
+
+		_messageFactory->ReleaseMessage( std::move( message ) );
 	}
 
-	bool ReliableOrderedChannel::DoesUnorderedMessagesBufferContainsSequenceNumber( uint16 sequence_number,
-	                                                                                uint32& out_index ) const
+	std::unique_ptr< Message > ReliableOrderedChannel::ReassembleFragment( const FragmentMessage& fragment )
 	{
-		const Message* message = nullptr;
-		uint32 idx = 0;
-		for ( std::list< std::unique_ptr< Message > >::const_iterator cit =
-		          _unorderedMessagesWaitingForPrevious.cbegin();
-		      cit != _unorderedMessagesWaitingForPrevious.cend(); ++cit )
+		if ( fragment.fragmentIndex == 0 )
 		{
-			message = ( *cit ).get();
-			if ( message->GetHeader().messageSequenceNumber == sequence_number )
+			if ( _numberOfFragmentsToReassemble > 0 )
 			{
-				out_index = idx;
-				return true;
+				LOG_WARNING( "[ReliableOrderedChannel.%s] New fragmented message received before completing the "
+				             "previous one. Discarding the previous one...",
+				             THIS_FUNCTION_NAME );
 			}
 
-			++idx;
+			ClearReassembly();
+			_numberOfFragmentsToReassemble = fragment.numberOfFragments;
+		}
+		else if ( fragment.fragmentIndex != _numberOfReassembledFragments ||
+		          fragment.numberOfFragments != _numberOfFragmentsToReassemble )
+		{
+			LOG_ERROR( "[ReliableOrderedChannel.%s] Unexpected fragment %hhu of %hhu. Expected fragment %u of %u. "
+			           "Discarding the message...",
+			           THIS_FUNCTION_NAME, fragment.fragmentIndex, fragment.numberOfFragments,
+			           _numberOfReassembledFragments, _numberOfFragmentsToReassemble );
+			ClearReassembly();
+			return nullptr;
 		}
 
-		return false;
-	}
+		_reassemblyBuffer.insert( _reassemblyBuffer.end(), fragment.data, fragment.data + fragment.dataSize );
+		++_numberOfReassembledFragments;
 
-	void ReliableOrderedChannel::ProcessOrderedMessage( std::unique_ptr< Message > message )
-	{
-		// Add message to the ready to be processed buffer
-		_readyToProcessMessages.push( std::move( message ) );
+		if ( _numberOfReassembledFragments < _numberOfFragmentsToReassemble )
+		{
+			return nullptr;
+		}
 
-		// Increment the next ordered message sequence number expected
-		++_nextOrderedMessageSequenceNumber;
+		Buffer buffer( _reassemblyBuffer.data(), static_cast< uint32 >( _reassemblyBuffer.size() ) );
+		std::unique_ptr< Message > message = MessageUtils::ReadMessage( *_messageFactory, buffer );
+		ClearReassembly();
 
-		// Check if with this new message received we can process other newer (out of order) messages received in the
-		// previous states.
-		bool continueProcessing = true;
-		while ( !_unorderedMessagesWaitingForPrevious.empty() && continueProcessing )
+		if ( message == nullptr )
 		{
-			uint32 index = 0;
-			if ( DoesUnorderedMessagesBufferContainsSequenceNumber( _nextOrderedMessageSequenceNumber, index ) )
-			{
-				std::list< std::unique_ptr< Message > >::iterator it = _unorderedMessagesWaitingForPrevious.begin();
-				std::advance( it, index );
-
-				std::unique_ptr< Message > readyToProcessMessage( std::move( *it ) );
-				_readyToProcessMessages.push( std::move( readyToProcessMessage ) );
-				_unorderedMessagesWaitingForPrevious.erase( it );
-				++_nextOrderedMessageSequenceNumber;
-			}
-			else
-			{
-				continueProcessing = false;
-			}
+			LOG_ERROR( "[ReliableOrderedChannel.%s] Can't read the reassembled message. Discarding it...",
+			           THIS_FUNCTION_NAME );
 		}
+		else if ( message->GetHeader().type == MessageType::Fragment )
+		{
+			LOG_ERROR( "[ReliableOrderedChannel.%s] A reassembled message can't be a fragment. Discarding it...",
+			           THIS_FUNCTION_NAME );
+			_messageFactory->ReleaseMessage( std::move( message ) );
+		}
+
+		return message;
+	}
+
+	void ReliableOrderedChannel::ClearReassembly()
+	{
+		// Clearing keeps the capacity, so reassembling messages stops allocating once the buffer has grown
+		_reassemblyBuffer.clear();
+		_numberOfReassembledFragments = 0;
+		_numberOfFragmentsToReassemble = 0;
 	}
 
 	void ReliableOrderedChannel::ProcessUnorderedMessage( std::unique_ptr< Message > message,
 	                                                      Metrics::MetricsHandler& metrics_handler )
 	{
-		AddUnorderedMessage( std::move( message ) );
+		const uint16 sequenceNumber = message->GetHeader().messageSequenceNumber;
+		_unorderedMessageSlots[ GetWindowIndex( sequenceNumber ) ] = std::move( message );
 		if ( metrics_handler.HasMetric( Metrics::MetricType::OUT_OF_ORDER_MESSAGES ) )
 		{
 			metrics_handler.AddValue( Metrics::MetricType::OUT_OF_ORDER_MESSAGES, 1 );
 		}
 	}
 
-	void ReliableOrderedChannel::AddUnorderedMessage( std::unique_ptr< Message > message )
-	{
-		_unorderedMessagesWaitingForPrevious.push_back( std::move( message ) );
-	}
-
 	bool ReliableOrderedChannel::TryRemoveAckedMessageFromUnacked( uint16 sequence_number,
 	                                                               Metrics::MetricsHandler& metrics_handler )
 	{
-		bool result = false;
-
-		const int32 index = TryGetUnackedMessageIndex( sequence_number );
-		if ( index != -1 )
+		UnackedMessageSlot& slot = _unackedMessageSlots[ GetWindowIndex( sequence_number ) ];
+		if ( slot.isAcked || slot.sequenceNumber != sequence_number )
 		{
-			// Calculate RTT of acked message
-			const TimeClock& timeClock = TimeClock::GetInstance();
-			const uint32 currentElapsedTime = static_cast< uint32 >( timeClock.GetLocalTimeMilliseconds() );
-			const uint32 messageRTT = currentElapsedTime - _unackedMessagesSendTimes[ sequence_number ];
-			UpdateRTT( messageRTT );
-
-			// Submit latency and jitter metrics
-			const uint32 latency = messageRTT / 2;
-			if ( metrics_handler.HasMetric( Metrics::MetricType::LATENCY ) )
-			{
-				metrics_handler.AddValue( Metrics::MetricType::LATENCY, latency );
-			}
-			if ( metrics_handler.HasMetric( Metrics::MetricType::JITTER ) )
-			{
-				metrics_handler.AddValue( Metrics::MetricType::JITTER, latency );
-			}
-
-			// Remove message from buffers
-			std::unique_ptr< Message > message = RemoveUnackedMessageFromBufferAtIndex( index );
+			return false;
+		}
 
-			std::unordered_map< uint16, uint32 >::iterator it = _unackedMessagesSendTimes.find( sequence_number );
-			_unackedMessagesSendTimes.erase( it );
+		// Calculate RTT of acked message
+		const TimeClock& timeClock = TimeClock::GetInstance();
+		const uint32 currentElapsedTime = static_cast< uint32 >( timeClock.GetLocalTimeMilliseconds() );
+		const uint32 messageRTT = currentElapsedTime - slot.sendTimeMilliseconds;
+		UpdateRTT( messageRTT );
 
-			// Release acked message since we no longer need it
-			_messageFactory->ReleaseMessage( std::move( message ) );
-			result = true;
+		// Submit latency and jitter metrics
+		const uint32 latency = messageRTT / 2;
+		if ( metrics_handler.HasMetric( Metrics::MetricType::LATENCY ) )
+		{
+			metrics_handler.AddValue( Metrics::MetricType::LATENCY, latency );
+		}
+		if ( metrics_handler.HasMetric( Metrics::MetricType::JITTER ) )
+		{
+			metrics_handler.AddValue( Metrics::MetricType::JITTER, latency );
 		}
 
-		return result;
-	}
+		// Release acked message since we no longer need it
+		_messageFactory->ReleaseMessage( std::move( slot.message ) );
+		slot.isAcked = true;
 
-	int32 ReliableOrderedChannel::TryGetUnackedMessageIndex( uint16 sequence_number ) const
-	{
-		int32 resultIndex = -1;
-		uint32 currentIndex = 0;
-		for ( std::list< std::unique_ptr< Message > >::const_iterator it = _unackedReliableMessages.cbegin();
-		      it != _unackedReliableMessages.cend(); ++it )
+		// If it was waiting to be resent, its slot stays reserved until the resend queue skips it
+		if ( slot.isPendingToResend )
 		{
-			if ( ( *it )->GetHeader().messageSequenceNumber == sequence_number )
+			--_numberOfMessagesPendingToResend;
+			if ( _numberOfMessagesPendingToResend == 0 )
 			{
-				resultIndex = currentIndex;
-				break;
+				ClearMessagesToResend();
 			}
+		}
 
-			++currentIndex;
+		while ( _oldestUnackedMessageSequenceNumber != GetNextMessageSequenceNumber() &&
+		        _unackedMessageSlots[ GetWindowIndex( _oldestUnackedMessageSequenceNumber ) ].isAcked )
+		{
+			++_oldestUnackedMessageSequenceNumber;
 		}
 
-		return resultIndex;
+		return true;
 	}
 
-	std::unique_ptr< Message > ReliableOrderedChannel::RemoveUnackedMessageFromBufferAtIndex( uint32 index )
+	void ReliableOrderedChannel::ClearMessagesToResend()
 	{
-		assert( index < _unackedReliableMessages.size() );
-
-		std::list< std::unique_ptr< Message > >::iterator it = _unackedReliableMessages.begin();
-		std::advance( it, index );
-		std::unique_ptr< Message > message( std::move( *it ) );
-
-		_unackedReliableMessages.erase( it );
-
-		std::list< float32 >::iterator it2 = _unackedReliableMessageTimeouts.begin();
-		std::advance( it2, index );
-		_unackedReliableMessageTimeouts.erase( it2 );
+		for ( uint32 i = 0; i < _messagesToResendCount; ++i )
+		{
+			const uint16 sequenceNumber =
+			    _messagesToResend[ ( _messagesToResendHead + i ) % RELIABLE_MESSAGES_WINDOW_SIZE ];
+			_unackedMessageSlots[ GetWindowIndex( sequenceNumber ) ].isPendingToResend = false;
+		}
 
-		return std::move( message );
+		_messagesToResendHead = 0;
+		_messagesToResendCount = 0;
+		_numberOfMessagesPendingToResend = 0;
 	}
 
 	const ReliableMessageEntry& ReliableOrderedChannel::GetRemotePeerReliableMessageEntry(
@@ -545,55 +669,59 @@ namespace NetLib
 		return ( float32 ) _rttMilliseconds / 1000 * 2;
 	}
 
-	void ReliableOrderedChannel::SetUnackedMessageSendTime( uint16 sequence_number )
-	{
-		const TimeClock& timeClock = TimeClock::GetInstance();
-		_unackedMessagesSendTimes[ sequence_number ] = static_cast< uint32 >( timeClock.GetLocalTimeMilliseconds() );
-	}
-
 	void ReliableOrderedChannel::ClearMessages()
 	{
-		std::list< std::unique_ptr< Message > >::iterator it = _unackedReliableMessages.begin();
-		while ( it != _unackedReliableMessages.end() )
+		for ( auto it = _unackedMessageSlots.begin(); it != _unackedMessageSlots.end(); ++it )
 		{
-			std::unique_ptr< Message > message( std::move( *it ) );
-			_messageFactory->ReleaseMessage( std::move( message ) );
+			if ( it->message != nullptr )
+			{
+				_messageFactory->ReleaseMessage( std::move( it->message ) );
+			}
 
-			++it;
+			*it = UnackedMessageSlot();
 		}
 
-		_unackedReliableMessages.clear();
-		_unackedReliableMessageTimeouts.clear();
-		_unackedMessagesSendTimes.clear();
+		_oldestUnackedMessageSequenceNumber = GetNextMessageSequenceNumber();
+		_messagesToResendHead = 0;
+		_messagesToResendCount = 0;
+		_numberOfMessagesPendingToResend = 0;
 
-		it = _unorderedMessagesWaitingForPrevious.begin();
-		while ( it != _unorderedMessagesWaitingForPrevious.end() )
+		for ( auto it = _unorderedMessageSlots.begin(); it != _unorderedMessageSlots.end(); ++it )
 		{
-			std::unique_ptr< Message > message( std::move( *it ) );
-			_messageFactory->ReleaseMessage( std::move( message ) );
+			if ( *it != nullptr )
+			{
+				_messageFactory->ReleaseMessage( std::move( *it ) );
+			}
+		}
+	}
 
-			++it;
+	bool ReliableOrderedChannel::SetAckWindowSize( uint32 ack_window_size )
+	{
+		if ( !AckBitfield::IsValidWindowSize( ack_window_size ) )
+		{
+			LOG_ERROR( "[ReliableOrderedChannel.%s] Invalid ACK window size %u. It must be a power of two between %u "
+			           "and %u",
+			           THIS_FUNCTION_NAME, ack_window_size, MIN_ACK_WINDOW_SIZE, MAX_ACK_WINDOW_SIZE );
+			return false;
 		}
 
-		_unorderedMessagesWaitingForPrevious.clear();
+		_ackWindowSize = ack_window_size;
+		return true;
 	}
 
-	uint32 ReliableOrderedChannel::GenerateACKs() const
+	void ReliableOrderedChannel::GenerateACKs( AckBitfield& out_acks ) const
 	{
-		// TODO Make the ACK bits be a stream instead of an uint32 so we can easily change it's size
-		uint32 acks = 0;
-		uint16 firstSequenceNumber = _lastAckedMessageSequenceNumber - 1;
-		for ( uint32 i = 0; i < ACK_BITS_SIZE; ++i )
+		const uint16 firstSequenceNumber = _lastAckedMessageSequenceNumber - 1;
+		for ( uint32 i = 0; i < _ackWindowSize; ++i )
 		{
-			uint16 currentSequenceNumber = firstSequenceNumber - i;
+			const uint16 currentSequenceNumber = firstSequenceNumber - i;
 			const ReliableMessageEntry& reliableMessageEntry =
 			    GetRemotePeerReliableMessageEntry( currentSequenceNumber );
 			if ( reliableMessageEntry.isAcked && currentSequenceNumber == reliableMessageEntry.sequenceNumber )
 			{
-				BitwiseUtils::SetBitAtIndex( acks, i );
+				out_acks.SetBit( i );
 			}
 		}
-		return acks;
 	}
 
 	void ReliableOrderedChannel::AckReliableMessage( uint16 sequence_number )
@@ -609,7 +737,7 @@ namespace NetLib
 		_areUnsentACKs = true;
 	}
 
-	void ReliableOrderedChannel::ProcessACKs( uint32 acks, uint16 lastAckedMessageSequenceNumber,
+	void ReliableOrderedChannel::ProcessACKs( const AckBitfield& acks, uint16 lastAckedMessageSequenceNumber,
 	                                          Metrics::MetricsHandler& metrics_handler )
 	{
 		LOG_INFO( "Last acked from client = %hu", lastAckedMessageSequenceNumber );
@@ -619,9 +747,11 @@ namespace NetLib
 
 		// Check for the rest of acked bits
 		const uint16 firstAckSequence = lastAckedMessageSequenceNumber - 1;
-		for ( uint32 i = 0; i < ACK_BITS_SIZE; ++i )
+		// The remote peer might use a different ACK window, so go through all the bits it sent
+		const uint32 numberOfAckBits = acks.GetNumberOfBits();
+		for ( uint32 i = 0; i < numberOfAckBits; ++i )
 		{
-			if ( BitwiseUtils::GetBitAtIndex( acks, i ) )
+			if ( acks.GetBit( i ) )
 			{
 				TryRemoveAckedMessageFromUnacked( firstAckSequence - i, metrics_handler );
 			}
@@ -630,39 +760,49 @@ namespace NetLib
 
 	bool ReliableOrderedChannel::IsMessageDuplicated( uint16 sequence_number ) const
 	{
-		bool result = false;
+		// Messages older than the next expected one have already been processed
+		const uint16 distanceToNextOrdered =
+		    static_cast< uint16 >( sequence_number - _nextOrderedMessageSequenceNumber );
+		if ( distanceToNextOrdered >= HALF_UINT16 )
+		{
+			return true;
+		}
 
-		const uint32 index = GetRollingBufferIndex( sequence_number );
-		if ( _remotePeerReliableMessageEntries[ index ].sequenceNumber == sequence_number &&
-		     _remotePeerReliableMessageEntries[ index ].isAcked )
+		if ( distanceToNextOrdered >= RELIABLE_MESSAGES_WINDOW_SIZE )
 		{
-			result = true;
+			return false;
 		}
 
-		return result;
+		return _unorderedMessageSlots[ GetWindowIndex( sequence_number ) ] != nullptr;
 	}
 
 	void ReliableOrderedChannel::Update( float32 deltaTime, Metrics::MetricsHandler& metrics_handler )
 	{
-		// Update unacked message timeouts
-		std::list< float32 >::iterator it = _unackedReliableMessageTimeouts.begin();
-		while ( it != _unackedReliableMessageTimeouts.end() )
+		// Update the timeouts of the messages in flight. The ones that expire are queued to be resent
+		for ( uint16 sequenceNumber = _oldestUnackedMessageSequenceNumber;
+		      sequenceNumber != GetNextMessageSequenceNumber(); ++sequenceNumber )
 		{
-			float32 timeout = *it;
-			timeout -= deltaTime;
+			UnackedMessageSlot& slot = _unackedMessageSlots[ GetWindowIndex( sequenceNumber ) ];
+			if ( slot.isAcked || slot.isPendingToResend )
+			{
+				continue;
+			}
 
-			if ( timeout <= 0 )
+			slot.timeout -= deltaTime;
+			if ( slot.timeout <= 0 )
 			{
 				if ( metrics_handler.HasMetric( Metrics::MetricType::PACKET_LOSS ) )
 				{
 					metrics_handler.AddValue( Metrics::MetricType::PACKET_LOSS, 1, "LOST" );
 				}
-				timeout = 0;
-			}
 
-			*it = timeout;
-
-			++it;
+				slot.timeout = 0;
+				slot.isPendingToResend = true;
+				_messagesToResend[ ( _messagesToResendHead + _messagesToResendCount ) %
+				                   RELIABLE_MESSAGES_WINDOW_SIZE ] = sequenceNumber;
+				++_messagesToResendCount;
+				++_numberOfMessagesPendingToResend;
+			}
 		}
 	}
 
@@ -674,6 +814,8 @@ namespace NetLib
 		_nextOrderedMessageSequenceNumber = 1;
 		_areUnsentACKs = false;
 		_rttMilliseconds = 0;
+		_ackWindowSize = MIN_ACK_WINDOW_SIZE;
+		ClearReassembly();
 
 		for ( uint32 i = 0; i < _reliableMessageEntriesBufferSize; ++i )
 		{
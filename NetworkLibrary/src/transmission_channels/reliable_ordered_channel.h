@@ -1,8 +1,9 @@
 #pragma once
-#include <list>
-#include <unordered_map>
+#include <memory>
+#include <vector>
 
 #include "transmission_channels/transmission_channel.h"
+#include "communication/ack_bitfield.h"
 
 namespace NetLib
 {
@@ -26,6 +27,34 @@ namespace NetLib
 			uint16 sequenceNumber;
 	};
 
+	/// <summary>
+	/// Slot of the ring of sent reliable messages. Slots are indexed by sequence number, so everything needed to ack,
+	/// resend or measure the RTT of a message is found in O(1) without touching any other message.
+	/// </summary>
+	struct UnackedMessageSlot
+	{
+			UnackedMessageSlot()
+			    : message( nullptr )
+			    , sequenceNumber( 0 )
+			    , sendTimeMilliseconds( 0 )
+			    , timeout( 0.f )
+			    , isAcked( true )
+			    , isPendingToResend( false )
+			{
+			}
+
+			// It is nullptr while the message is inside the outgoing packet
+			std::unique_ptr< Message > message;
+			uint16 sequenceNumber;
+			// Local time of the first send, for RTT calculation purposes
+			uint32 sendTimeMilliseconds;
+			// Time left until the message is considered lost
+			float32 timeout;
+			// Free slots are considered acked
+			bool isAcked;
+			bool isPendingToResend;
+	};
+
 	class ReliableOrderedChannel : public TransmissionChannel
 	{
 		public:
@@ -36,7 +65,7 @@ namespace NetLib
 			ReliableOrderedChannel& operator=( const ReliableOrderedChannel& ) = delete;
 			ReliableOrderedChannel& operator=( ReliableOrderedChannel&& other ) noexcept;
 
-			bool CreateAndSendPacket( Socket& socket, const Address& address,
+			bool CreateAndSendPacket( DatagramSendQueue& send_queue, const Address& address,
 			                          Metrics::MetricsHandler& metrics_handler ) override;
 
 			bool AddMessageToSend( std::unique_ptr< Message > message ) override;
@@ -48,9 +77,18 @@ namespace NetLib
 			bool ArePendingReadyToProcessMessages() const override;
 			const Message* GetReadyToProcessMessage() override;
 
-			void ProcessACKs( uint32 acks, uint16 lastAckedMessageSequenceNumber,
+			void ProcessACKs( const AckBitfield& acks, uint16 lastAckedMessageSequenceNumber,
 			                  Metrics::MetricsHandler& metrics_handler ) override;
 
+			/// <summary>
+			/// Sets the number of remote peer messages, older than the last acked one, that are acked in each packet.
+			/// It must be at least as big as the bursts of reliable messages sent by the remote peer, otherwise the
+			/// ones out of the window will be resent even if they arrived. It is negotiated during the connection
+			/// pipeline. Returns false if the size is not valid. See AckBitfield::IsValidWindowSize.
+			/// </summary>
+			bool SetAckWindowSize( uint32 ack_window_size );
+			uint32 GetAckWindowSize() const { return _ackWindowSize; }
+
 			void Update( float32 deltaTime, Metrics::MetricsHandler& metrics_handler ) override;
 
 			void Reset() override;
@@ -60,7 +98,7 @@ namespace NetLib
 		private:
 			/// <summary>
 			/// Checks if a message associated with a sequence number is duplicated. This is done by checking if the
-			/// message has already been acked.
+			/// message has already been processed or if it is already waiting for a previous one.
 			/// </summary>
 			/// <param name="sequence_number">The sequence number associated with the message.</param>
 			/// <returns>True if the message is duplicated, False otherwise.</returns>
@@ -88,8 +126,8 @@ namespace NetLib
 			/// <summary>
 			/// Generates the ACK bits to be sent in the next packet.
 			/// </summary>
-			/// <returns>The ACK bits.</returns>
-			uint32 GenerateACKs() const;
+			/// <param name="out_acks">[Out Parameter] The ACK bits. It must be empty.</param>
+			void GenerateACKs( AckBitfield& out_acks ) const;
 
 			/// <summary>
 			/// Acks a reliable message from the remote peer associated to the given sequence number. This will be used
@@ -111,77 +149,65 @@ namespace NetLib
 			// UNACKED MESSAGES
 			//////////////////////
 
+			uint32 GetWindowIndex( uint16 sequence_number ) const
+			{
+				return sequence_number % RELIABLE_MESSAGES_WINDOW_SIZE;
+			};
+
 			/// <summary>
-			/// Checks if there are any unacked messages that need to be resent.
+			/// Checks if a new message can be sent. The slot of its sequence number must be free, otherwise there are
+			/// already RELIABLE_MESSAGES_WINDOW_SIZE messages in flight and it has to wait until the oldest one is
+			/// acked.
 			/// </summary>
-			/// <returns>True if there are unacked messages to be resent, False otherwise.</returns>
-			bool AreUnackedMessagesToResend() const;
+			/// <returns>True if there is an unsent message and it can be sent, False otherwise.</returns>
+			bool CanSendNewMessage() const;
 
 			/// <summary>
 			/// Gets, if available, the first unacked message that is considered lost and needs to be resent. If there
-			/// are no unacked messages to be resent this method returns nullptr. See also AreUnackedMessagesToResend().
+			/// are no unacked messages to be resent this method returns nullptr.
 			/// </summary>
 			/// <returns>The message to be resent if available or nullptr otherwise.</returns>
 			std::unique_ptr< Message > TryGetUnackedMessageToResend();
 
 			/// <summary>
-			/// Gets, if available, the first _unackedReliableMessageTimeouts index that has timed out and needs to be
-			/// resent. If there are no unacked messages to be resent this method returns -1.
+			/// Gets, if available, the slot of the first unacked message that is considered lost and needs to be
+			/// resent. If there are no unacked messages to be resent this method returns nullptr.
 			/// </summary>
-			/// <returns>The _unackedReliableMessageTimeouts index to be resent if available or -1 otherwise.</returns>
-			int32 TryGetNextUnackedMessageIndexToResend() const;
+			const UnackedMessageSlot* TryGetNextUnackedMessageSlotToResend() const;
 
 			/// <summary>
-			/// Adds an unacked message to the unacked messages buffer (_unackedReliableMessages). Also, calculates the
-			/// dynamic timeout for that unacked message and adds it to the _unackedReliableMessageTimeouts buffer.
+			/// Puts back a sent message into its unacked message slot and calculates its dynamic retransmission
+			/// timeout.
 			/// </summary>
 			/// <param name="message">The message to be tagged as unacked.</param>
 			void AddUnackedMessage( std::unique_ptr< Message > message );
 
 			/// <summary>
-			///	Removes, if available, from the _unackedReliableMessages buffer an unacked message that has been acked
-			/// by the remote peer.
+			///	Frees, if it is in use, the unacked message slot of a message that has been acked by the remote peer.
 			/// </summary>
 			/// <param name="sequence_number">The sequence number of the acked message.</param>
 			/// <param name="metrics_handler">A pointer to the metrics handler to update LATENCY and JITTER
 			/// metrics.</param>
-			/// <returns>True if the acked message was removed from _unackedReliableMessages, False otherwise.</returns>
+			/// <returns>True if the acked message was removed from the unacked messages, False otherwise.</returns>
 			bool TryRemoveAckedMessageFromUnacked( uint16 sequence_number, Metrics::MetricsHandler& metrics_handler );
 
 			/// <summary>
-			/// Gets, if available, from the _unackedReliableMessages buffer the unacked message index associated to
-			/// sequence_number. If no unacked message associated with that sequence number is found this method returns
-			/// -1.
-			/// </summary>
-			/// <param name="sequence_number">The sequence number associated with the unacked message we want to
-			/// get.</param> <returns>The _unackedReliableMessages index to be resent if available or -1
-			/// otherwise.</returns>
-			int32 TryGetUnackedMessageIndex( uint16 sequence_number ) const;
-
-			/// <summary>
-			/// Removes from the _unackedReliableMessages buffer a message at the specified index and returns it.
-			/// </summary>
-			/// <param name="index">The buffer index where the message to be deleted is at.</param>
-			/// <returns>The message that was erased from the buffer.</returns>
-			std::unique_ptr< Message > RemoveUnackedMessageFromBufferAtIndex( uint32 index );
-
-			/// <summary>
-			/// Sets the unacked message send time for the given sequence number. This is used to calculate the RTT when
-			/// the ACK arrives.
+			/// Empties the queue of messages to resend, releasing the slots reserved by its entries. Only called once
+			/// all of them have been acked.
 			/// </summary>
-			/// <param name="sequence_number">The sequence number of the unacked message we want to set the send
-			/// time.</param>
-			void SetUnackedMessageSendTime( uint16 sequence_number );
+			void ClearMessagesToResend();
 
 			////////////////////////
 			// UNORDERED MESSAGES
 			////////////////////////
 
 			/// <summary>
-			///
+			/// Processes the message we were expecting along with the newer messages already received that were
+			/// waiting for it.
 			/// </summary>
-			/// <param name="message"></param>
-			void ProcessOrderedMessage( std::unique_ptr< Message > message );
+			/// <param name="message">The ordered message received</param>
+			/// <param name="metrics_handler">The metrics handler to update the received fragments metric</param>
+			void ProcessOrderedMessage( std::unique_ptr< Message > message, Metrics::MetricsHandler& metrics_handler );
 
 			/// <summary>
 			/// Processes an unordered message received. This means that the message is not the one we were expecting
@@ -192,22 +218,33 @@ namespace NetLib
 			void ProcessUnorderedMessage( std::unique_ptr< Message > message,
 			                              Metrics::MetricsHandler& metrics_handler );
 
+			///////////////////
+			// FRAGMENTATION
+			///////////////////
+
 			/// <summary>
-			/// Adds an unordered message to the _unorderedMessagesWaitingForPrevious buffer until you get them in the
-			/// correct order. The message will wait there until all previous messages are received.
+			/// Serializes a message bigger than MAX_FRAGMENT_DATA_SIZE and queues it as consecutive fragments. Since
+			/// this channel is ordered, the remote peer receives them one after another.
 			/// </summary>
-			/// <param name="message">The unordered message to buffer.</param>
-			void AddUnorderedMessage( std::unique_ptr< Message > message );
+			/// <param name="message">The message to split</param>
+			/// <returns>True if the fragments were queued, False if the message needs more than
+			/// MAX_NUMBER_OF_FRAGMENTS fragments.</returns>
+			bool AddFragmentedMessageToSend( std::unique_ptr< Message > message );
 
 			/// <summary>
-			/// Checks if the message associated to sequence_number is inside the _unorderedMessagesWaitingForPrevious
-			/// buiffer
+			/// Makes an ordered message available to be processed. Fragments are accumulated instead, and the message
+			/// they belong to is read back and made available once the last one arrives.
 			/// </summary>
-			/// <param name="sequence_number">The sequence number associated with the message you want to look
-			/// for</param>
-			/// <param name="index">[Out Parameter] The buffer index where the message is located</param>
-			/// <returns>True if the message was found (check out_index for position), False otherwise.</returns>
-			bool DoesUnorderedMessagesBufferContainsSequenceNumber( uint16 sequence_number, uint32& out_index ) const;
+			void AddReadyToProcessMessage( std::unique_ptr< Message > message,
+			                               Metrics::MetricsHandler& metrics_handler );
+
+			/// <summary>
+			/// Appends a fragment to the message being reassembled. Returns the reassembled message after the last
+			/// fragment or nullptr otherwise.
+			/// </summary>
+			std::unique_ptr< Message > ReassembleFragment( const FragmentMessage& fragment );
+
+			void ClearReassembly();
 
 			////////
 			// RTT
@@ -233,7 +270,12 @@ namespace NetLib
 
 			// RELIABLE RELATED
 
-			const uint32 ACK_BITS_SIZE = 32;
+			/// <summary>
+			/// Maximum number of reliable messages in flight, both sent and waiting for an ACK and received and waiting
+			/// for a previous message. It must be a power of two so the slots don't break when sequence numbers wrap
+			/// around.
+			/// </summary>
+			const uint32 RELIABLE_MESSAGES_WINDOW_SIZE = 512;
 
 			/// <summary>
 			/// Retransmission timeout when RTT is zero (At the beginning of the game for example)
@@ -241,15 +283,28 @@ namespace NetLib
 			const float32 INITIAL_TIMEOUT = 0.5f;
 
 			/// <summary>
-			/// Reliable messages that have not already been acked
+			/// Ring of reliable messages that have not already been acked, indexed by sequence number
+			/// </summary>
+			std::vector< UnackedMessageSlot > _unackedMessageSlots;
+
+			/// <summary>
+			/// Sequence number of the oldest message that might not have been acked yet. Only the slots from this one
+			/// up to the next message sequence number are in use.
 			/// </summary>
-			std::list< std::unique_ptr< Message > > _unackedReliableMessages;
+			uint16 _oldestUnackedMessageSequenceNumber;
 
 			/// <summary>
-			/// Timeouts of _unackedReliableMessages. This is used to determine when a message needs to be resent. When
-			/// the message's timeout expires, it will be considered lost and as a consequence a resend will happen.
+			/// FIFO ring of the sequence numbers of the messages that timed out and need to be resent. Entries of
+			/// messages that got acked while waiting are skipped when reached.
 			/// </summary>
-			std::list< float32 > _unackedReliableMessageTimeouts;
+			std::vector< uint16 > _messagesToResend;
+			uint32 _messagesToResendHead;
+			uint32 _messagesToResendCount;
+
+			/// <summary>
+			/// Number of entries in _messagesToResend whose message still needs to be resent
+			/// </summary>
+			uint32 _numberOfMessagesPendingToResend;
 
 			/// <summary>
 			/// Flag to check if there are pending ACKs to send. This will allow us to not wait until there's a message
@@ -269,10 +324,9 @@ namespace NetLib
 			uint32 _reliableMessageEntriesBufferSize;
 
 			/// <summary>
-			/// Elapsed time since start of the program that each reliable message was sent (For RTT calculation
-			/// purposes)
+			/// Number of remote peer messages, before the last acked one, covered by the ACK bits of each packet
 			/// </summary>
-			std::unordered_map< uint16, uint32 > _unackedMessagesSendTimes;
+			uint32 _ackWindowSize;
 
 			// RTT RELATED
 
@@ -284,13 +338,29 @@ namespace NetLib
 			// ORDERED RELATED
 
 			/// <summary>
-			/// Messages waiting for a previous message in order to guarantee ordered delivery
+			/// Ring of messages waiting for a previous message in order to guarantee ordered delivery, indexed by
+			/// sequence number
 			/// </summary>
-			std::list< std::unique_ptr< Message > > _unorderedMessagesWaitingForPrevious;
+			std::vector< std::unique_ptr< Message > > _unorderedMessageSlots;
 
 			/// <summary>
 			/// Next message sequence number expected to guarantee ordered transmission
 			/// </summary>
-			uint32 _nextOrderedMessageSequenceNumber;
+			uint16 _nextOrderedMessageSequenceNumber;
+
+			// FRAGMENTATION RELATED
+
+			/// <summary>
+			/// Scratch buffer to serialize messages that need to be fragmented
+			/// </summary>
+			std::vector< uint8 > _fragmentationBuffer;
+
+			/// <summary>
+			/// Serialized message being reassembled. Fragments are received in order, so there is only one at a time
+			/// and it never grows beyond MAX_NUMBER_OF_FRAGMENTS * MAX_FRAGMENT_DATA_SIZE bytes.
+			/// </summary>
+			std::vector< uint8 > _reassemblyBuffer;
+			uint32 _numberOfReassembledFragments;
+			uint32 _numberOfFragmentsToReassemble;
 	};
 } // namespace NetLib
@@ -1,5 +1,7 @@
 #include "transmission_channel.h"
 
+#include <utility>
+
 #include "asserts.h"
 
 #include "communication/message_factory.h"
@@ -10,8 +10,9 @@
 namespace NetLib
 {
 	class MessageFactory;
-	class Socket;
+	class DatagramSendQueue;
 	class Address;
+	class AckBitfield;
 
 	namespace Metrics
 	{
@@ -39,14 +40,15 @@ namespace NetLib
 			TransmissionChannelType GetType() { return _type; }
 
 			/// <summary>
-			/// Creates a packet with pending data and sends it through the socket to the specified address.
+			/// Creates a packet with pending data and queues it to be sent to the specified address.
 			/// </summary>
-			/// <param name="socket">The socket to send the packet through.</param>
+			/// <param name="send_queue">The queue of outgoing datagrams. It is flushed by the peer at the end of the
+			/// tick.</param>
 			/// <param name="address">The targed address where the packet is going to be sent to.</param>
 			/// <param name="metrics_handler">A pointer to the metrics handler to submit any metrics such as
 			/// bandwidth.</param>
 			/// <returns>True if the packet was created and sent, False otherwise.</returns>
-			virtual bool CreateAndSendPacket( Socket& socket, const Address& address,
+			virtual bool CreateAndSendPacket( DatagramSendQueue& send_queue, const Address& address,
 			                                  Metrics::MetricsHandler& metrics_handler ) = 0;
 
 			/// <summary>
@@ -75,7 +77,7 @@ namespace NetLib
 			virtual const Message* GetReadyToProcessMessage() = 0;
 			void FreeProcessedMessages();
 
-			virtual void ProcessACKs( uint32 acks, uint16 lastAckedMessageSequenceNumber,
+			virtual void ProcessACKs( const AckBitfield& acks, uint16 lastAckedMessageSequenceNumber,
 			                          Metrics::MetricsHandler& metrics_handler ) = 0;
 
 			virtual void Update( float32 deltaTime, Metrics::MetricsHandler& metrics_handler ) = 0;
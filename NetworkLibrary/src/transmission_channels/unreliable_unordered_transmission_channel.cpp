@@ -3,12 +3,13 @@
 #include <cassert>
 
 #include "logger.h"
+#include "asserts.h"
 
 #include "communication/message_factory.h"
 #include "communication/network_packet.h"
 
 #include "core/buffer.h"
-#include "core/socket.h"
+#include "core/datagram_send_queue.h"
 #include "core/address.h"
 
 #include "metrics/metrics_handler.h"
@@ -34,7 +35,8 @@ namespace NetLib
 		return *this;
 	}
 
-	bool UnreliableUnorderedTransmissionChannel::CreateAndSendPacket( Socket& socket, const Address& address,
+	bool UnreliableUnorderedTransmissionChannel::CreateAndSendPacket( DatagramSendQueue& send_queue,
+	                                                                  const Address& address,
 	                                                                  Metrics::MetricsHandler& metrics_handler )
 	{
 		bool result = false;
@@ -44,7 +46,8 @@ namespace NetLib
 			return result;
 		}
 
-		NetworkPacket packet;
+		NetworkPacket& packet = send_queue.GetOutgoingPacket();
+		ASSERT( packet.GetNumberOfMessages() == 0, "The outgoing packet must be empty before using it" );
 
 		// TODO Check somewhere if there is a message larger than the maximum packet size. Log a warning saying that the
 		// message will never get sent and delete it.
@@ -67,19 +70,24 @@ namespace NetLib
 		}
 
 		// Set packet header
-		packet.SetHeaderACKs( 0 );
+		packet.SetHeaderACKs( AckBitfield() );
 		packet.SetHeaderLastAcked( 0 );
 		packet.SetHeaderChannelType( GetType() );
 
-		uint8* bufferData = new uint8[ packet.Size() ];
-		Buffer buffer( bufferData, packet.Size() );
-		packet.Write( buffer );
-		socket.SendTo( buffer.GetData(), buffer.GetSize(), address );
+		// Serialize packet straight into the send queue, no intermediate buffer needed
+		const uint32 packetSize = packet.Size();
+		uint8* bufferData = send_queue.AcquireDatagramBuffer( packetSize );
+		if ( bufferData != nullptr )
+		{
+			Buffer buffer( bufferData, packetSize );
+			packet.Write( buffer );
+			send_queue.CommitDatagram( packetSize, address );
+		}
 
-		// TODO See what happens when the socket couldn't send the packet
+		// TODO See what happens when the send queue couldn't send the packet
 		if ( metrics_handler.HasMetric( Metrics::MetricType::UPLOAD_BANDWIDTH ) )
 		{
-			metrics_handler.AddValue( Metrics::MetricType::UPLOAD_BANDWIDTH, packet.Size() );
+			metrics_handler.AddValue( Metrics::MetricType::UPLOAD_BANDWIDTH, packetSize );
 		}
 
 		// Send messages ownership back to remote peer
@@ -89,8 +97,6 @@ namespace NetLib
 			_messageFactory->ReleaseMessage( std::move( message ) );
 		}
 
-		delete[] bufferData;
-
 		result = true;
 		return result;
 	}
@@ -176,7 +182,8 @@ namespace NetLib
 		return messageToReturn;
 	}
 
-	void UnreliableUnorderedTransmissionChannel::ProcessACKs( uint32 acks, uint16 lastAckedMessageSequenceNumber,
+	void UnreliableUnorderedTransmissionChannel::ProcessACKs( const AckBitfield& acks,
+	                                                          uint16 lastAckedMessageSequenceNumber,
 	                                                          Metrics::MetricsHandler& metrics_handler )
 	{
 	}
@@ -20,7 +20,7 @@ namespace NetLib
 			UnreliableUnorderedTransmissionChannel& operator=(
 			    UnreliableUnorderedTransmissionChannel&& other ) noexcept;
 
-			bool CreateAndSendPacket( Socket& socket, const Address& address,
+			bool CreateAndSendPacket( DatagramSendQueue& send_queue, const Address& address,
 			                          Metrics::MetricsHandler& metrics_handler ) override;
 
 			bool AddMessageToSend( std::unique_ptr< Message > message ) override;
@@ -33,7 +33,7 @@ namespace NetLib
 			bool ArePendingReadyToProcessMessages() const override;
 			const Message* GetReadyToProcessMessage() override;
 
-			void ProcessACKs( uint32 acks, uint16 lastAckedMessageSequenceNumber,
+			void ProcessACKs( const AckBitfield& acks, uint16 lastAckedMessageSequenceNumber,
 			                  Metrics::MetricsHandler& metrics_handler ) override;
 			bool IsMessageDuplicated( uint16 messageSequenceNumber ) const;
 
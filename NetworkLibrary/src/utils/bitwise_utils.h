@@ -2,6 +2,7 @@
 #include "numeric_types.h"
 
 #include <cassert>
+#include <cmath>
 
 namespace NetLib
 {
@@ -31,5 +32,29 @@ namespace NetLib
 				assert( ( index >= 0 && index < 32 ) );
 				return ( byte >> index ) & 0x1;
 			}
+
+			/// <summary>
+			/// Returns the number of bits needed to represent any value in range [0, max_value].
+			/// </summary>
+			static constexpr uint32 GetNumberOfBitsRequired( uint32 max_value )
+			{
+				uint32 result = 0;
+				while ( max_value > 0 )
+				{
+					++result;
+					max_value >>= 1;
+				}
+
+				return result;
+			}
+
+			/// <summary>
+			/// Returns the highest quantized value of a float in range [min, max] using the given resolution.
+			/// </summary>
+			static uint32 GetNumberOfQuantizationSteps( float32 min, float32 max, float32 resolution )
+			{
+				assert( max > min && resolution > 0.f );
+				return static_cast< uint32 >( std::ceil( ( max - min ) / resolution ) );
+			}
 	};
 } // namespace NetLib
@@ -1,6 +1,8 @@
 #include "gtest/gtest.h"
 
 #include "core/Buffer.h"
+#include "core/bit_writer.h"
+#include "core/bit_reader.h"
 
 #include "shared/player_simulation/player_state.h"
 #include "shared/player_simulation/player_state_utils.h"
@@ -17,9 +19,14 @@ namespace
 		uint8* bufferData = new uint8[ 1024 ];
 		NetLib::Buffer buffer( bufferData, 1024 );
 
-		SerializePlayerStateToBuffer( playerState, buffer );
+		NetLib::BitWriter writer( buffer );
+		SerializePlayerState( playerState, writer );
+		writer.Flush();
 		buffer.ResetAccessIndex();
-		PlayerSimulation::PlayerState resultPlayerState = PlayerSimulation::DeserializePlayerStateFromBuffer( buffer );
+
+		NetLib::BitReader reader( buffer );
+		PlayerSimulation::PlayerState resultPlayerState;
+		EXPECT_TRUE( PlayerSimulation::DeserializePlayerState( reader, resultPlayerState ) );
 
 		EXPECT_EQ( playerState.tick, resultPlayerState.tick );
 		EXPECT_FLOAT_EQ( playerState.position.X(), resultPlayerState.position.X() );
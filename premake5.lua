@@ -59,6 +59,12 @@ PROJECT_DATA =
 		NAME = "TestEngine",
 		PATH = ROOT_PATH "test_engine/",
 		PREMAKE_PATH = ROOT_PATH "test_engine/test_engine_premake5.lua"
+	},
+	TEST_NETWORK_LIBRARY =
+	{
+		NAME = "TestNetworkLibrary",
+		PATH = ROOT_PATH "test_network_library/",
+		PREMAKE_PATH = ROOT_PATH "test_network_library/test_network_library_premake5.lua"
 	}
 }
 
@@ -127,3 +133,4 @@ group "Tests"
 include (PROJECT_DATA.TEST_GAME.PREMAKE_PATH)
 include (PROJECT_DATA.TEST_COMMON.PREMAKE_PATH)
 include (PROJECT_DATA.TEST_ENGINE.PREMAKE_PATH)
+include (PROJECT_DATA.TEST_NETWORK_LIBRARY.PREMAKE_PATH)
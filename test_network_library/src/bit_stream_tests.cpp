@@ -0,0 +1,134 @@
+#include "gtest/gtest.h"
+
+#include "numeric_types.h"
+
+#include "core/buffer.h"
+#include "core/bit_writer.h"
+#include "core/bit_reader.h"
+
+#include "communication/message_header.h"
+
+namespace
+{
+	TEST( BitStreamTests, ArbitraryBitWidthsAreReadBackInOrder )
+	{
+		uint8 data[ 16 ] = {};
+		NetLib::Buffer buffer( data, 16 );
+
+		NetLib::BitWriter writer( buffer );
+		writer.WriteBits( 5, 3 );
+		writer.WriteBool( true );
+		writer.WriteBits( 1023, 10 );
+		writer.WriteBool( false );
+		writer.WriteInteger( 0xDEADBEEF );
+		writer.WriteFloat( -3.25f );
+		writer.Flush();
+
+		// 3 + 1 + 10 + 1 + 32 + 32 bits fit in 10 bytes
+		EXPECT_EQ( buffer.GetAccessIndex(), 10 );
+		EXPECT_EQ( writer.GetNumberOfBitsWritten(), 80 );
+
+		buffer.ResetAccessIndex();
+		NetLib::BitReader reader( buffer );
+		uint32 value;
+		bool flag;
+		float32 floatValue;
+
+		EXPECT_TRUE( reader.ReadBits( value, 3 ) );
+		EXPECT_EQ( value, 5 );
+		EXPECT_TRUE( reader.ReadBool( flag ) );
+		EXPECT_TRUE( flag );
+		EXPECT_TRUE( reader.ReadBits( value, 10 ) );
+		EXPECT_EQ( value, 1023 );
+		EXPECT_TRUE( reader.ReadBool( flag ) );
+		EXPECT_FALSE( flag );
+		EXPECT_TRUE( reader.ReadInteger( value ) );
+		EXPECT_EQ( value, 0xDEADBEEF );
+		EXPECT_TRUE( reader.ReadFloat( floatValue ) );
+		EXPECT_FLOAT_EQ( floatValue, -3.25f );
+	}
+
+	TEST( BitStreamTests, RangedIntegersUseOnlyTheBitsOfTheirRange )
+	{
+		uint8 data[ 16 ] = {};
+		NetLib::Buffer buffer( data, 16 );
+
+		NetLib::BitWriter writer( buffer );
+		writer.WriteRangedInteger( -7, -10, 10 );
+		writer.WriteRangedInteger( 100, 0, 100 );
+		EXPECT_EQ( writer.GetNumberOfBitsWritten(), 12 );
+		writer.Flush();
+
+		buffer.ResetAccessIndex();
+		NetLib::BitReader reader( buffer );
+		int32 value;
+		EXPECT_TRUE( reader.ReadRangedInteger( value, -10, 10 ) );
+		EXPECT_EQ( value, -7 );
+		EXPECT_TRUE( reader.ReadRangedInteger( value, 0, 100 ) );
+		EXPECT_EQ( value, 100 );
+	}
+
+	TEST( BitStreamTests, QuantizedFloatsAreWithinResolutionAndClamped )
+	{
+		uint8 data[ 16 ] = {};
+		NetLib::Buffer buffer( data, 16 );
+
+		NetLib::BitWriter writer( buffer );
+		writer.WriteQuantizedFloat( 0.123f, -1.f, 1.f, 0.01f );
+		writer.WriteQuantizedFloat( 5.f, -1.f, 1.f, 0.01f );
+		writer.WriteQuantizedFloat( -5.f, -1.f, 1.f, 0.01f );
+		// 200 steps need 8 bits each
+		EXPECT_EQ( writer.GetNumberOfBitsWritten(), 24 );
+		writer.Flush();
+
+		buffer.ResetAccessIndex();
+		NetLib::BitReader reader( buffer );
+		float32 value;
+		EXPECT_TRUE( reader.ReadQuantizedFloat( value, -1.f, 1.f, 0.01f ) );
+		EXPECT_NEAR( value, 0.123f, 0.005f );
+		EXPECT_TRUE( reader.ReadQuantizedFloat( value, -1.f, 1.f, 0.01f ) );
+		EXPECT_FLOAT_EQ( value, 1.f );
+		EXPECT_TRUE( reader.ReadQuantizedFloat( value, -1.f, 1.f, 0.01f ) );
+		EXPECT_FLOAT_EQ( value, -1.f );
+	}
+
+	TEST( BitStreamTests, ReadingPastTheEndOfTheBufferFails )
+	{
+		uint8 data[ 2 ] = {};
+		NetLib::Buffer buffer( data, 2 );
+		NetLib::BitReader reader( buffer );
+
+		uint32 value;
+		EXPECT_TRUE( reader.ReadBits( value, 12 ) );
+		EXPECT_FALSE( reader.ReadBits( value, 5 ) );
+	}
+
+	TEST( BitStreamTests, OutOfRangeRangedIntegerIsRejected )
+	{
+		// Range [0, 4] needs 3 bits, so a malformed 7 can still be decoded from the wire
+		uint8 data[ 1 ] = { 7 };
+		NetLib::Buffer buffer( data, 1 );
+		NetLib::BitReader reader( buffer );
+
+		int32 value;
+		EXPECT_FALSE( reader.ReadRangedInteger( value, 0, 4 ) );
+	}
+
+	TEST( BitStreamTests, MessageHeaderIsPackedIntoThreeBytes )
+	{
+		uint8 data[ 8 ] = {};
+		NetLib::Buffer buffer( data, 8 );
+
+		const NetLib::MessageHeader header( NetLib::MessageType::Replication, 65000, true, false );
+		header.Write( buffer );
+		EXPECT_EQ( buffer.GetAccessIndex(), NetLib::MessageHeader::Size() );
+
+		buffer.ResetAccessIndex();
+		NetLib::MessageHeader readHeader( NetLib::MessageType::ConnectionRequest, 0, false, false );
+		EXPECT_TRUE( readHeader.Read( buffer ) );
+		EXPECT_EQ( readHeader.type, NetLib::MessageType::Replication );
+		EXPECT_EQ( readHeader.messageSequenceNumber, 65000 );
+		EXPECT_TRUE( readHeader.isReliable );
+		EXPECT_FALSE( readHeader.isOrdered );
+	}
+} // namespace
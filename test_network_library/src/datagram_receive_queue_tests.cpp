@@ -0,0 +1,102 @@
+#include "gtest/gtest.h"
+
+#include <thread>
+
+#include "numeric_types.h"
+
+#include "core/address.h"
+#include "core/datagram_receive_queue.h"
+
+namespace
+{
+	const uint32 DATAGRAM_MAX_SIZE = 8;
+
+	TEST( DatagramReceiveQueueTests, DropsDatagramsWhenFull )
+	{
+		NetLib::DatagramReceiveQueue queue( 2, DATAGRAM_MAX_SIZE );
+		const NetLib::Address address( NetLib::IPV4_LOOPBACK, 50000 );
+
+		for ( uint32 i = 0; i < 2; ++i )
+		{
+			uint8* slot = queue.GetNextFreeSlot();
+			ASSERT_NE( slot, nullptr );
+			slot[ 0 ] = static_cast< uint8 >( i );
+			EXPECT_TRUE( queue.CommitNextFreeSlot( 1, address ) );
+		}
+
+		EXPECT_EQ( queue.GetNextFreeSlot(), nullptr );
+		EXPECT_FALSE( queue.PushConnectionReset( address ) );
+
+		NetLib::ReceivedDatagram datagram;
+		ASSERT_TRUE( queue.TryPeek( datagram ) );
+		EXPECT_EQ( datagram.data[ 0 ], 0 );
+		EXPECT_FALSE( datagram.isConnectionReset );
+		queue.Pop();
+
+		// Popping a datagram frees its slot
+		EXPECT_TRUE( queue.PushConnectionReset( address ) );
+
+		ASSERT_TRUE( queue.TryPeek( datagram ) );
+		EXPECT_EQ( datagram.data[ 0 ], 1 );
+		queue.Pop();
+
+		ASSERT_TRUE( queue.TryPeek( datagram ) );
+		EXPECT_TRUE( datagram.isConnectionReset );
+		EXPECT_EQ( *datagram.address, address );
+		queue.Pop();
+
+		EXPECT_TRUE( queue.IsEmpty() );
+		EXPECT_FALSE( queue.TryPeek( datagram ) );
+	}
+
+	TEST( DatagramReceiveQueueTests, ConsumerReceivesEveryDatagramInOrder )
+	{
+		const uint32 NUMBER_OF_DATAGRAMS = 100000;
+
+		NetLib::DatagramReceiveQueue queue( 64, DATAGRAM_MAX_SIZE );
+		const NetLib::Address address( NetLib::IPV4_LOOPBACK, 50000 );
+
+		std::thread producer(
+		    [ &queue, &address, NUMBER_OF_DATAGRAMS ]()
+		    {
+			    for ( uint32 i = 0; i < NUMBER_OF_DATAGRAMS; ++i )
+			    {
+				    uint8* slot = queue.GetNextFreeSlot();
+				    while ( slot == nullptr )
+				    {
+					    std::this_thread::yield();
+					    slot = queue.GetNextFreeSlot();
+				    }
+
+				    *reinterpret_cast< uint32* >( slot ) = i;
+				    queue.CommitNextFreeSlot( sizeof( uint32 ), address );
+			    }
+		    } );
+
+		uint32 expectedValue = 0;
+		uint32 numberOfOutOfOrderDatagrams = 0;
+		NetLib::ReceivedDatagram datagram;
+		while ( expectedValue < NUMBER_OF_DATAGRAMS )
+		{
+			if ( !queue.TryPeek( datagram ) )
+			{
+				std::this_thread::yield();
+				continue;
+			}
+
+			if ( datagram.size != sizeof( uint32 ) || *reinterpret_cast< uint32* >( datagram.data ) != expectedValue )
+			{
+				++numberOfOutOfOrderDatagrams;
+			}
+
+			queue.Pop();
+			++expectedValue;
+		}
+
+		producer.join();
+
+		EXPECT_EQ( numberOfOutOfOrderDatagrams, 0 );
+		EXPECT_TRUE( queue.IsEmpty() );
+		EXPECT_EQ( queue.ConsumeNumberOfDroppedDatagrams(), 0 );
+	}
+} // namespace
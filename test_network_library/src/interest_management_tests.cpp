@@ -0,0 +1,303 @@
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <vector>
+
+#include "numeric_types.h"
+
+#include "core/buffer.h"
+#include "core/bit_reader.h"
+#include "core/bit_writer.h"
+
+#include "communication/message.h"
+#include "communication/message_factory.h"
+#include "communication/message_utils.h"
+
+#include "replication/always_relevant_interest_manager.h"
+#include "replication/grid_interest_manager.h"
+#include "replication/network_entity_communication_callbacks.h"
+#include "replication/on_network_entity_create_config.h"
+#include "replication/replication_action_type.h"
+#include "replication/replication_manager.h"
+#include "replication/replication_messages_processor.h"
+
+namespace
+{
+	const uint32 FIRST_PEER_ID = 1;
+	const uint32 SECOND_PEER_ID = 2;
+
+	class InterestManagementTests : public ::testing::Test
+	{
+		protected:
+			InterestManagementTests()
+			    : _messageFactory( 16 )
+			{
+			}
+
+			void SetUp() override
+			{
+				_server.SubscribeToOnNetworkEntityCreate( []( const NetLib::OnNetworkEntityCreateConfig& ) {} );
+				_server.SubscribeToOnNetworkEntityDestroy( []( uint32 ) {} );
+			}
+
+			// Replicates one snapshot to the remote peer and returns the ids of the entities affected by each action
+			void ReplicateSnapshot( uint32 remote_peer_id, std::vector< uint32 >& created,
+			                        std::vector< uint32 >& updated, std::vector< uint32 >& destroyed )
+			{
+				created.clear();
+				updated.clear();
+				destroyed.clear();
+
+				std::vector< std::unique_ptr< NetLib::ReplicationMessage > > messages;
+				_server.Server_ReplicateWorldState( _messageFactory, remote_peer_id, messages );
+				_server.Server_IncrementSnapshotSequenceNumber();
+
+				for ( auto it = messages.begin(); it != messages.end(); ++it )
+				{
+					const NetLib::ReplicationActionType action =
+					    static_cast< NetLib::ReplicationActionType >( ( *it )->replicationAction );
+					if ( action == NetLib::ReplicationActionType::CREATE )
+					{
+						created.push_back( ( *it )->networkEntityId );
+					}
+					else if ( action == NetLib::ReplicationActionType::UPDATE )
+					{
+						updated.push_back( ( *it )->networkEntityId );
+					}
+					else
+					{
+						destroyed.push_back( ( *it )->networkEntityId );
+					}
+
+					_messageFactory.ReleaseMessage( std::move( *it ) );
+				}
+			}
+
+			NetLib::MessageFactory _messageFactory;
+			NetLib::ReplicationManager _server;
+	};
+
+	TEST_F( InterestManagementTests, EntitiesAreCreatedAndDestroyedWhenEnteringAndLeavingTheViewDistance )
+	{
+		NetLib::GridInterestManagerConfig config;
+		config.cellSize = 10.f;
+		config.viewDistanceInCells = 1;
+		NetLib::GridInterestManager interestManager( config );
+		_server.SetInterestManager( &interestManager );
+
+		// Network entity ids start at 1
+		_server.CreateNetworkEntity( 0, FIRST_PEER_ID, 0.f, 0.f );
+		_server.CreateNetworkEntity( 0, SECOND_PEER_ID, 100.f, 0.f );
+
+		std::vector< uint32 > created, updated, destroyed;
+		ReplicateSnapshot( FIRST_PEER_ID, created, updated, destroyed );
+		EXPECT_EQ( created, std::vector< uint32 >( { 1 } ) );
+		EXPECT_EQ( updated, std::vector< uint32 >( { 1 } ) );
+		EXPECT_TRUE( destroyed.empty() );
+
+		// The second entity moves into a neighbour cell
+		EXPECT_TRUE( _server.SetNetworkEntityPosition( 2, -5.f, 15.f ) );
+		ReplicateSnapshot( FIRST_PEER_ID, created, updated, destroyed );
+		EXPECT_EQ( created, std::vector< uint32 >( { 2 } ) );
+		EXPECT_EQ( updated, std::vector< uint32 >( { 1, 2 } ) );
+		EXPECT_TRUE( destroyed.empty() );
+
+		// Nothing changes while it stays relevant
+		ReplicateSnapshot( FIRST_PEER_ID, created, updated, destroyed );
+		EXPECT_TRUE( created.empty() );
+		EXPECT_TRUE( destroyed.empty() );
+
+		EXPECT_TRUE( _server.SetNetworkEntityPosition( 2, 25.f, 0.f ) );
+		ReplicateSnapshot( FIRST_PEER_ID, created, updated, destroyed );
+		EXPECT_TRUE( created.empty() );
+		EXPECT_EQ( updated, std::vector< uint32 >( { 1 } ) );
+		EXPECT_EQ( destroyed, std::vector< uint32 >( { 2 } ) );
+
+		_server.SetInterestManager( nullptr );
+	}
+
+	TEST_F( InterestManagementTests, RemovedEntitiesAreDestroyedOnlyWhereTheyWereRelevant )
+	{
+		NetLib::GridInterestManagerConfig config;
+		config.cellSize = 10.f;
+		config.viewDistanceInCells = 0;
+		NetLib::GridInterestManager interestManager( config );
+		_server.SetInterestManager( &interestManager );
+
+		_server.CreateNetworkEntity( 0, FIRST_PEER_ID, 0.f, 0.f );
+		_server.CreateNetworkEntity( 0, SECOND_PEER_ID, 100.f, 0.f );
+
+		std::vector< uint32 > created, updated, destroyed;
+		ReplicateSnapshot( FIRST_PEER_ID, created, updated, destroyed );
+		ReplicateSnapshot( SECOND_PEER_ID, created, updated, destroyed );
+		EXPECT_EQ( created, std::vector< uint32 >( { 2 } ) );
+
+		_server.RemoveNetworkEntity( 2 );
+		ReplicateSnapshot( FIRST_PEER_ID, created, updated, destroyed );
+		EXPECT_TRUE( destroyed.empty() );
+		ReplicateSnapshot( SECOND_PEER_ID, created, updated, destroyed );
+		EXPECT_EQ( destroyed, std::vector< uint32 >( { 2 } ) );
+
+		_server.SetInterestManager( nullptr );
+	}
+
+	TEST_F( InterestManagementTests, UpdateBudgetUpdatesTheOwnedEntityFirstAndTheRestInTurns )
+	{
+		NetLib::AlwaysRelevantInterestManager interestManager( 2 );
+		_server.SetInterestManager( &interestManager );
+
+		_server.CreateNetworkEntity( 0, FIRST_PEER_ID, 0.f, 0.f );
+		_server.CreateNetworkEntity( 0, SECOND_PEER_ID, 0.f, 0.f );
+		_server.CreateNetworkEntity( 0, SECOND_PEER_ID, 0.f, 0.f );
+
+		std::vector< uint32 > created, updated, destroyed;
+		ReplicateSnapshot( FIRST_PEER_ID, created, updated, destroyed );
+		EXPECT_EQ( created, std::vector< uint32 >( { 1, 2, 3 } ) );
+		EXPECT_EQ( updated, std::vector< uint32 >( { 1, 2 } ) );
+
+		// Entity 3 waited the longest among the ones not controlled by the remote peer
+		ReplicateSnapshot( FIRST_PEER_ID, created, updated, destroyed );
+		EXPECT_EQ( updated, std::vector< uint32 >( { 1, 3 } ) );
+
+		ReplicateSnapshot( FIRST_PEER_ID, created, updated, destroyed );
+		EXPECT_EQ( updated, std::vector< uint32 >( { 1, 2 } ) );
+
+		_server.SetInterestManager( nullptr );
+	}
+
+	TEST_F( InterestManagementTests, ByteBudgetSendsTheHighestPriorityUpdatesFirst )
+	{
+		NetLib::AlwaysRelevantInterestManager interestManager;
+		_server.SetInterestManager( &interestManager );
+		_server.SetEntityPriorityFunction(
+		    []( uint32 remote_peer_id, const NetLib::NetworkEntityData& network_entity_data )
+		    {
+			    // Entity 3 is three times as important as the rest
+			    return ( network_entity_data.id == 3 ) ? 3.f : 1.f;
+		    } );
+
+		_server.CreateNetworkEntity( 0, FIRST_PEER_ID, 0.f, 0.f );
+		_server.CreateNetworkEntity( 0, SECOND_PEER_ID, 0.f, 0.f );
+		_server.CreateNetworkEntity( 0, SECOND_PEER_ID, 0.f, 0.f );
+
+		// Create messages are always sent even if they exceed the budget
+		_server.SetMaxReplicationBytesPerTick( 1 );
+		std::vector< uint32 > created, updated, destroyed;
+		ReplicateSnapshot( FIRST_PEER_ID, created, updated, destroyed );
+		EXPECT_EQ( created, std::vector< uint32 >( { 1, 2, 3 } ) );
+		EXPECT_TRUE( updated.empty() );
+
+		// Entities have no state, so every update has the same size. Leave room for a single one
+		NetLib::ReplicationMessage emptyUpdate;
+		emptyUpdate.replicationAction = static_cast< uint8 >( NetLib::ReplicationActionType::UPDATE );
+		_server.SetMaxReplicationBytesPerTick( emptyUpdate.Size() );
+
+		ReplicateSnapshot( FIRST_PEER_ID, created, updated, destroyed );
+		EXPECT_EQ( updated, std::vector< uint32 >( { 3 } ) );
+
+		// Priorities of 1 and 2 keep growing while they wait. It's a tie with 3, broken by id
+		ReplicateSnapshot( FIRST_PEER_ID, created, updated, destroyed );
+		EXPECT_EQ( updated, std::vector< uint32 >( { 1 } ) );
+		ReplicateSnapshot( FIRST_PEER_ID, created, updated, destroyed );
+		EXPECT_EQ( updated, std::vector< uint32 >( { 3 } ) );
+		// Entity 2 has waited long enough to beat entity 3
+		ReplicateSnapshot( FIRST_PEER_ID, created, updated, destroyed );
+		EXPECT_EQ( updated, std::vector< uint32 >( { 2 } ) );
+
+		_server.SetEntityPriorityFunction( nullptr );
+		_server.SetInterestManager( nullptr );
+	}
+
+	TEST_F( InterestManagementTests, EntitiesThatBecomeRelevantAgainAreCreatedAgainOnTheClient )
+	{
+		NetLib::GridInterestManagerConfig config;
+		config.cellSize = 10.f;
+		config.viewDistanceInCells = 1;
+		NetLib::GridInterestManager interestManager( config );
+		_server.SetInterestManager( &interestManager );
+
+		uint32 serverValue = 0;
+		_server.SubscribeToOnNetworkEntityCreate(
+		    [ &serverValue ]( const NetLib::OnNetworkEntityCreateConfig& create_config )
+		    {
+			    create_config.communicationCallbacks->OnSerializeEntityStateForNonOwner.AddSubscriber(
+			        [ &serverValue ]( NetLib::BitWriter& writer ) { writer.WriteInteger( serverValue ); } );
+		    } );
+
+		uint32 clientValue = 0;
+		uint32 numberOfClientCreates = 0;
+		uint32 numberOfClientDestroys = 0;
+		NetLib::ReplicationMessagesProcessor client;
+		client.SetLocalClientId( FIRST_PEER_ID );
+		client.SubscribeToOnNetworkEntityCreate(
+		    [ &clientValue, &numberOfClientCreates ]( const NetLib::OnNetworkEntityCreateConfig& create_config )
+		    {
+			    ++numberOfClientCreates;
+			    create_config.communicationCallbacks->OnUnserializeEntityStateForNonOwner.AddSubscriber(
+			        [ &clientValue ]( NetLib::BitReader& reader ) { reader.ReadInteger( clientValue ); } );
+		    } );
+		client.SubscribeToOnNetworkEntityDestroy( [ &numberOfClientDestroys ]( uint32 )
+		                                          { ++numberOfClientDestroys; } );
+
+		// Replicates one snapshot to the client through the wire format and acks it back
+		auto replicateSnapshot = [ this, &client ]()
+		{
+			std::vector< std::unique_ptr< NetLib::ReplicationMessage > > messages;
+			_server.Server_ReplicateWorldState( _messageFactory, FIRST_PEER_ID, messages );
+			_server.Server_IncrementSnapshotSequenceNumber();
+
+			for ( auto it = messages.begin(); it != messages.end(); ++it )
+			{
+				uint8 data[ 256 ];
+				NetLib::Buffer buffer( data, 256 );
+				( *it )->Write( buffer );
+				buffer.ResetAccessIndex();
+
+				std::unique_ptr< NetLib::Message > receivedMessage =
+				    NetLib::MessageUtils::ReadMessage( _messageFactory, buffer );
+				ASSERT_NE( receivedMessage, nullptr );
+				client.Client_ProcessReceivedReplicationMessage(
+				    static_cast< const NetLib::ReplicationMessage& >( *receivedMessage ) );
+				_messageFactory.ReleaseMessage( std::move( receivedMessage ) );
+				_messageFactory.ReleaseMessage( std::move( *it ) );
+			}
+
+			client.Client_ConsumePendingSnapshotAcks(
+			    [ this ]( uint16 snapshot_sequence_number, uint16 number_of_updates_received ) {
+				    _server.Server_ProcessReplicationAck( FIRST_PEER_ID, snapshot_sequence_number,
+				                                          number_of_updates_received );
+			    } );
+		};
+
+		// The client views the world from its own entity. The second one is controlled by the other peer, so the
+		// client receives its non owner state
+		_server.CreateNetworkEntity( 0, FIRST_PEER_ID, 0.f, 0.f );
+		_server.CreateNetworkEntity( 0, SECOND_PEER_ID, 0.f, 0.f );
+		serverValue = 10;
+		replicateSnapshot();
+		serverValue = 11;
+		replicateSnapshot();
+		EXPECT_EQ( numberOfClientCreates, 2 );
+		EXPECT_EQ( clientValue, 11 );
+
+		// It leaves the view distance
+		EXPECT_TRUE( _server.SetNetworkEntityPosition( 2, 100.f, 0.f ) );
+		serverValue = 12;
+		replicateSnapshot();
+		EXPECT_EQ( numberOfClientDestroys, 1 );
+		EXPECT_EQ( clientValue, 11 );
+
+		// It comes back, so it is created again and its updates are applied to the new instance
+		EXPECT_TRUE( _server.SetNetworkEntityPosition( 2, 0.f, 0.f ) );
+		serverValue = 13;
+		replicateSnapshot();
+		EXPECT_EQ( numberOfClientCreates, 3 );
+		EXPECT_EQ( clientValue, 13 );
+
+		serverValue = 14;
+		replicateSnapshot();
+		EXPECT_EQ( clientValue, 14 );
+
+		_server.SetInterestManager( nullptr );
+	}
+} // namespace
@@ -0,0 +1,64 @@
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <vector>
+
+#include "numeric_types.h"
+
+#include "communication/message.h"
+#include "communication/message_factory.h"
+
+namespace
+{
+	TEST( MessageFactoryTests, ReleasedMessagesAreLentAgain )
+	{
+		NetLib::MessageFactory messageFactory( 4 );
+
+		std::unique_ptr< NetLib::Message > message = messageFactory.LendMessage( NetLib::MessageType::TimeRequest );
+		ASSERT_NE( message, nullptr );
+		EXPECT_EQ( message->GetHeader().type, NetLib::MessageType::TimeRequest );
+
+		const NetLib::Message* releasedMessage = message.get();
+		messageFactory.ReleaseMessage( std::move( message ) );
+
+		message = messageFactory.LendMessage( NetLib::MessageType::TimeRequest );
+		EXPECT_EQ( message.get(), releasedMessage );
+		messageFactory.ReleaseMessage( std::move( message ) );
+	}
+
+	TEST( MessageFactoryTests, EmptyPoolGrowsAndTracksHighWaterMark )
+	{
+		const uint32 INITIAL_SIZE = 4;
+		const uint32 NUMBER_OF_LENT_MESSAGES = 10;
+
+		NetLib::MessageFactory messageFactory( INITIAL_SIZE );
+
+		std::vector< std::unique_ptr< NetLib::Message > > messages;
+		for ( uint32 i = 0; i < NUMBER_OF_LENT_MESSAGES; ++i )
+		{
+			messages.push_back( messageFactory.LendMessage( NetLib::MessageType::Replication ) );
+			ASSERT_NE( messages.back(), nullptr );
+			EXPECT_EQ( messages.back()->GetHeader().type, NetLib::MessageType::Replication );
+		}
+
+		NetLib::MessagePoolStats stats = messageFactory.GetPoolStats( NetLib::MessageType::Replication );
+		EXPECT_GE( stats.numberOfMessages, NUMBER_OF_LENT_MESSAGES );
+		EXPECT_EQ( stats.numberOfLentMessages, NUMBER_OF_LENT_MESSAGES );
+		EXPECT_EQ( stats.numberOfFreeMessages, stats.numberOfMessages - NUMBER_OF_LENT_MESSAGES );
+
+		for ( auto it = messages.begin(); it != messages.end(); ++it )
+		{
+			messageFactory.ReleaseMessage( std::move( *it ) );
+		}
+
+		stats = messageFactory.GetPoolStats( NetLib::MessageType::Replication );
+		EXPECT_EQ( stats.numberOfLentMessages, 0 );
+		EXPECT_EQ( stats.numberOfFreeMessages, stats.numberOfMessages );
+		EXPECT_EQ( stats.maxNumberOfLentMessages, NUMBER_OF_LENT_MESSAGES );
+
+		// The rest of pools are untouched
+		stats = messageFactory.GetPoolStats( NetLib::MessageType::Inputs );
+		EXPECT_EQ( stats.numberOfMessages, INITIAL_SIZE );
+		EXPECT_EQ( stats.maxNumberOfLentMessages, 0 );
+	}
+} // namespace
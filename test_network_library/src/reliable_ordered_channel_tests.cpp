@@ -0,0 +1,360 @@
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "numeric_types.h"
+
+#include "communication/ack_bitfield.h"
+#include "communication/message.h"
+#include "communication/message_factory.h"
+#include "communication/network_packet.h"
+#include "communication/network_packet_utils.h"
+
+#include "core/address.h"
+#include "core/buffer.h"
+#include "core/datagram_batch.h"
+#include "core/datagram_send_queue.h"
+#include "core/socket.h"
+#include "core/time_clock.h"
+
+#include "metrics/metrics_handler.h"
+
+#include "transmission_channels/reliable_ordered_channel.h"
+
+namespace
+{
+	const float32 TICK_DELTA_TIME = 1.f / 60.f;
+	const float32 PACKET_LOSS_RATIO = 0.05f;
+
+	// One direction of a simulated network link. Datagrams arrive a fixed number of ticks after being sent and some
+	// of them, picked by a seeded generator so every run is the same, never arrive.
+	class LossyLink
+	{
+		public:
+			LossyLink( uint32 latency_ticks, float32 loss_ratio, uint32 seed )
+			    : _latencyTicks( latency_ticks )
+			    , _lossRatio( loss_ratio )
+			    , _generator( seed )
+			    , _distribution( 0.f, 1.f )
+			    , _inFlightDatagrams()
+			{
+			}
+
+			void Send( NetLib::DatagramSendQueue& send_queue, uint32 current_tick )
+			{
+				const NetLib::DatagramBatch& datagrams = send_queue.GetQueuedDatagrams();
+				for ( uint32 i = 0; i < datagrams.GetCount(); ++i )
+				{
+					if ( _distribution( _generator ) < _lossRatio )
+					{
+						continue;
+					}
+
+					const uint8* data = datagrams.GetDatagramData( i );
+					InFlightDatagram datagram;
+					datagram.arrivalTick = current_tick + _latencyTicks;
+					datagram.data.assign( data, data + datagrams.GetDatagramSize( i ) );
+					_inFlightDatagrams.push_back( std::move( datagram ) );
+				}
+
+				send_queue.Discard();
+			}
+
+			// Reads the next datagram arriving at the current tick into out_packet
+			bool Receive( uint32 current_tick, NetLib::MessageFactory& message_factory,
+			              NetLib::NetworkPacket& out_packet )
+			{
+				if ( _inFlightDatagrams.empty() || _inFlightDatagrams.front().arrivalTick > current_tick )
+				{
+					return false;
+				}
+
+				std::vector< uint8 >& data = _inFlightDatagrams.front().data;
+				NetLib::Buffer buffer( data.data(), static_cast< uint32 >( data.size() ) );
+				const bool result =
+				    NetLib::NetworkPacketUtils::ReadNetworkPacket( buffer, message_factory, out_packet );
+				_inFlightDatagrams.pop_front();
+				return result;
+			}
+
+		private:
+			struct InFlightDatagram
+			{
+					uint32 arrivalTick;
+					std::vector< uint8 > data;
+			};
+
+			uint32 _latencyTicks;
+			float32 _lossRatio;
+			std::mt19937 _generator;
+			std::uniform_real_distribution< float32 > _distribution;
+			std::deque< InFlightDatagram > _inFlightDatagrams;
+	};
+
+	struct LossySimulationResult
+	{
+			uint32 numberOfDeliveredMessages;
+			uint32 numberOfTicks;
+			uint32 numberOfRetransmissions;
+			bool isDeliveredInOrder;
+			float64 elapsedMilliseconds;
+	};
+
+	// Sends number_of_messages reliable messages from one channel to another over a link with the same packet loss in
+	// both directions. Both channels send one packet per tick. Once everything is delivered it keeps ticking for a
+	// while so the messages that were never acked time out and get counted as retransmissions.
+	LossySimulationResult SimulateLossyLink( uint32 number_of_messages, uint32 messages_per_tick, uint32 latency_ticks,
+	                                         float32 loss_ratio, uint32 ack_window_size )
+	{
+		const uint32 MAX_TICKS = 100000;
+		const uint32 SETTLE_TICKS = 60;
+
+		NetLib::TimeClock::CreateInstance();
+
+		NetLib::Socket socket;
+		const NetLib::Address address( NetLib::IPV4_LOOPBACK, 54998 );
+		NetLib::MessageFactory messageFactory( 256 );
+		NetLib::Metrics::MetricsHandler metricsHandler;
+		metricsHandler.StartUp( 1.f, NetLib::Metrics::MetricsEnableConfig::CUSTOM,
+		                        { NetLib::Metrics::MetricType::RETRANSMISSIONS } );
+
+		NetLib::DatagramSendQueue senderQueue( socket, 16, NetLib::MTU_SIZE_BYTES );
+		NetLib::DatagramSendQueue receiverQueue( socket, 16, NetLib::MTU_SIZE_BYTES );
+		NetLib::ReliableOrderedChannel sender( &messageFactory );
+		NetLib::ReliableOrderedChannel receiver( &messageFactory );
+		sender.SetAckWindowSize( ack_window_size );
+		receiver.SetAckWindowSize( ack_window_size );
+		LossyLink senderToReceiver( latency_ticks, loss_ratio, 1 );
+		LossyLink receiverToSender( latency_ticks, loss_ratio, 2 );
+		NetLib::NetworkPacket packet;
+
+		LossySimulationResult result;
+		result.numberOfDeliveredMessages = 0;
+		result.numberOfTicks = 0;
+		result.isDeliveredInOrder = true;
+
+		uint32 numberOfQueuedMessages = 0;
+		uint32 numberOfSettleTicks = 0;
+		uint16 expectedSequenceNumber = 1;
+
+		const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+		while ( numberOfSettleTicks < SETTLE_TICKS && result.numberOfTicks < MAX_TICKS )
+		{
+			const uint32 tick = result.numberOfTicks + numberOfSettleTicks;
+
+			for ( uint32 i = 0; i < messages_per_tick && numberOfQueuedMessages < number_of_messages; ++i )
+			{
+				std::unique_ptr< NetLib::Message > message =
+				    messageFactory.LendMessage( NetLib::MessageType::TimeRequest );
+				message->SetReliability( true );
+				message->SetOrdered( true );
+				sender.AddMessageToSend( std::move( message ) );
+				++numberOfQueuedMessages;
+			}
+
+			sender.Update( TICK_DELTA_TIME, metricsHandler );
+			receiver.Update( TICK_DELTA_TIME, metricsHandler );
+
+			sender.CreateAndSendPacket( senderQueue, address, metricsHandler );
+			senderToReceiver.Send( senderQueue, tick );
+
+			while ( senderToReceiver.Receive( tick, messageFactory, packet ) )
+			{
+				receiver.ProcessACKs( packet.GetHeader().ackBits, packet.GetHeader().lastAckedSequenceNumber,
+				                      metricsHandler );
+				while ( packet.GetNumberOfMessages() > 0 )
+				{
+					receiver.AddReceivedMessage( packet.TryGetNextMessage(), metricsHandler );
+				}
+			}
+
+			while ( receiver.ArePendingReadyToProcessMessages() )
+			{
+				const NetLib::Message* message = receiver.GetReadyToProcessMessage();
+				if ( message->GetHeader().messageSequenceNumber != expectedSequenceNumber )
+				{
+					result.isDeliveredInOrder = false;
+				}
+
+				++expectedSequenceNumber;
+				++result.numberOfDeliveredMessages;
+			}
+			receiver.FreeProcessedMessages();
+
+			receiver.CreateAndSendPacket( receiverQueue, address, metricsHandler );
+			receiverToSender.Send( receiverQueue, tick );
+
+			while ( receiverToSender.Receive( tick, messageFactory, packet ) )
+			{
+				sender.ProcessACKs( packet.GetHeader().ackBits, packet.GetHeader().lastAckedSequenceNumber,
+				                    metricsHandler );
+				NetLib::NetworkPacketUtils::CleanPacket( messageFactory, packet );
+			}
+
+			if ( result.numberOfDeliveredMessages == number_of_messages )
+			{
+				++numberOfSettleTicks;
+			}
+			else
+			{
+				++result.numberOfTicks;
+			}
+		}
+
+		const std::chrono::duration< float64, std::milli > elapsedTime = std::chrono::steady_clock::now() - startTime;
+		result.elapsedMilliseconds = elapsedTime.count();
+		result.numberOfRetransmissions = metricsHandler.GetValue( NetLib::Metrics::MetricType::RETRANSMISSIONS,
+		                                                          NetLib::Metrics::ValueType::CURRENT );
+
+		metricsHandler.ShutDown();
+		NetLib::TimeClock::DeleteInstance();
+		return result;
+	}
+
+	TEST( ReliableOrderedChannelTests, DeliversEveryMessageInOrderUnderPacketLoss )
+	{
+		const uint32 NUMBER_OF_MESSAGES = 2000;
+
+		const LossySimulationResult result =
+		    SimulateLossyLink( NUMBER_OF_MESSAGES, 4, 2, PACKET_LOSS_RATIO, NetLib::MIN_ACK_WINDOW_SIZE );
+
+		EXPECT_EQ( result.numberOfDeliveredMessages, NUMBER_OF_MESSAGES );
+		EXPECT_TRUE( result.isDeliveredInOrder );
+	}
+
+	// A burst bigger than the ACK window can't be fully acked by a single packet, so the messages out of the window are
+	// resent even if the link doesn't lose anything
+	TEST( ReliableOrderedChannelTests, WideAckWindowAvoidsSpuriousRetransmissionsOfBursts )
+	{
+		const uint32 NUMBER_OF_MESSAGES = 200;
+
+		const LossySimulationResult narrowWindowResult =
+		    SimulateLossyLink( NUMBER_OF_MESSAGES, NUMBER_OF_MESSAGES, 2, 0.f, NetLib::MIN_ACK_WINDOW_SIZE );
+		const LossySimulationResult wideWindowResult =
+		    SimulateLossyLink( NUMBER_OF_MESSAGES, NUMBER_OF_MESSAGES, 2, 0.f, NetLib::MAX_ACK_WINDOW_SIZE );
+
+		EXPECT_EQ( narrowWindowResult.numberOfDeliveredMessages, NUMBER_OF_MESSAGES );
+		EXPECT_GT( narrowWindowResult.numberOfRetransmissions, 0 );
+		EXPECT_EQ( wideWindowResult.numberOfDeliveredMessages, NUMBER_OF_MESSAGES );
+		EXPECT_TRUE( wideWindowResult.isDeliveredInOrder );
+		EXPECT_EQ( wideWindowResult.numberOfRetransmissions, 0 );
+	}
+
+	TEST( ReliableOrderedChannelTests, ReassemblesMessagesBiggerThanAPacketUnderPacketLoss )
+	{
+		const uint16 DATA_SIZE = 20000;
+		const uint32 MAX_TICKS = 10000;
+
+		NetLib::TimeClock::CreateInstance();
+
+		NetLib::Socket socket;
+		const NetLib::Address address( NetLib::IPV4_LOOPBACK, 54998 );
+		NetLib::MessageFactory messageFactory( 64 );
+		NetLib::Metrics::MetricsHandler metricsHandler;
+		metricsHandler.StartUp(
+		    1.f, NetLib::Metrics::MetricsEnableConfig::CUSTOM,
+		    { NetLib::Metrics::MetricType::SENT_FRAGMENTS, NetLib::Metrics::MetricType::RECEIVED_FRAGMENTS } );
+
+		NetLib::DatagramSendQueue senderQueue( socket, 16, NetLib::MTU_SIZE_BYTES );
+		NetLib::DatagramSendQueue receiverQueue( socket, 16, NetLib::MTU_SIZE_BYTES );
+		NetLib::ReliableOrderedChannel sender( &messageFactory );
+		NetLib::ReliableOrderedChannel receiver( &messageFactory );
+		sender.SetAckWindowSize( NetLib::MAX_ACK_WINDOW_SIZE );
+		receiver.SetAckWindowSize( NetLib::MAX_ACK_WINDOW_SIZE );
+		LossyLink senderToReceiver( 2, PACKET_LOSS_RATIO, 3 );
+		LossyLink receiverToSender( 2, PACKET_LOSS_RATIO, 4 );
+		NetLib::NetworkPacket packet;
+
+		std::unique_ptr< NetLib::Message > message = messageFactory.LendMessage( NetLib::MessageType::Inputs );
+		message->SetReliability( true );
+		message->SetOrdered( true );
+		NetLib::InputStateMessage& inputStateMessage = static_cast< NetLib::InputStateMessage& >( *message );
+		uint8* data = inputStateMessage.AllocateData( DATA_SIZE );
+		for ( uint32 i = 0; i < DATA_SIZE; ++i )
+		{
+			data[ i ] = static_cast< uint8 >( i * 7 );
+		}
+		const uint32 expectedNumberOfFragments =
+		    ( inputStateMessage.Size() + NetLib::MAX_FRAGMENT_DATA_SIZE - 1 ) / NetLib::MAX_FRAGMENT_DATA_SIZE;
+		EXPECT_TRUE( sender.AddMessageToSend( std::move( message ) ) );
+
+		bool isDelivered = false;
+		bool isDataEqual = false;
+		for ( uint32 tick = 0; tick < MAX_TICKS && !isDelivered; ++tick )
+		{
+			sender.Update( TICK_DELTA_TIME, metricsHandler );
+			receiver.Update( TICK_DELTA_TIME, metricsHandler );
+
+			sender.CreateAndSendPacket( senderQueue, address, metricsHandler );
+			senderToReceiver.Send( senderQueue, tick );
+			while ( senderToReceiver.Receive( tick, messageFactory, packet ) )
+			{
+				while ( packet.GetNumberOfMessages() > 0 )
+				{
+					receiver.AddReceivedMessage( packet.TryGetNextMessage(), metricsHandler );
+				}
+			}
+
+			while ( receiver.ArePendingReadyToProcessMessages() )
+			{
+				const NetLib::Message* receivedMessage = receiver.GetReadyToProcessMessage();
+				ASSERT_EQ( receivedMessage->GetHeader().type, NetLib::MessageType::Inputs );
+				const NetLib::InputStateMessage& receivedInputStateMessage =
+				    static_cast< const NetLib::InputStateMessage& >( *receivedMessage );
+				isDelivered = true;
+				isDataEqual = receivedInputStateMessage.dataSize == DATA_SIZE;
+				for ( uint32 i = 0; isDataEqual && i < DATA_SIZE; ++i )
+				{
+					isDataEqual = receivedInputStateMessage.data[ i ] == static_cast< uint8 >( i * 7 );
+				}
+			}
+			receiver.FreeProcessedMessages();
+
+			receiver.CreateAndSendPacket( receiverQueue, address, metricsHandler );
+			receiverToSender.Send( receiverQueue, tick );
+			while ( receiverToSender.Receive( tick, messageFactory, packet ) )
+			{
+				sender.ProcessACKs( packet.GetHeader().ackBits, packet.GetHeader().lastAckedSequenceNumber,
+				                    metricsHandler );
+				NetLib::NetworkPacketUtils::CleanPacket( messageFactory, packet );
+			}
+		}
+
+		EXPECT_TRUE( isDelivered );
+		EXPECT_TRUE( isDataEqual );
+		EXPECT_EQ( metricsHandler.GetValue( NetLib::Metrics::MetricType::SENT_FRAGMENTS,
+		                                    NetLib::Metrics::ValueType::CURRENT ),
+		           expectedNumberOfFragments );
+		EXPECT_GE( metricsHandler.GetValue( NetLib::Metrics::MetricType::RECEIVED_FRAGMENTS,
+		                                    NetLib::Metrics::ValueType::CURRENT ),
+		           expectedNumberOfFragments );
+
+		metricsHandler.ShutDown();
+		NetLib::TimeClock::DeleteInstance();
+	}
+
+	// Microbenchmark of the sender and receiver bookkeeping with a few hundred reliable messages in flight. Run it
+	// with --gtest_also_run_disabled_tests and an optimized build.
+	TEST( ReliableOrderedChannelTests, DISABLED_BenchmarkUnderFivePercentLoss )
+	{
+		const uint32 NUMBER_OF_MESSAGES = 60000;
+		const uint32 MESSAGES_PER_TICK = 8;
+		const uint32 LATENCY_TICKS = 3;
+
+		const LossySimulationResult result = SimulateLossyLink( NUMBER_OF_MESSAGES, MESSAGES_PER_TICK, LATENCY_TICKS,
+		                                                        PACKET_LOSS_RATIO, NetLib::MIN_ACK_WINDOW_SIZE );
+
+		EXPECT_EQ( result.numberOfDeliveredMessages, NUMBER_OF_MESSAGES );
+		EXPECT_TRUE( result.isDeliveredInOrder );
+
+		const float64 nanosecondsPerMessage = ( result.elapsedMilliseconds * 1000000.0 ) / NUMBER_OF_MESSAGES;
+		std::cout << "[ BENCHMARK ] " << NUMBER_OF_MESSAGES << " messages in " << result.numberOfTicks
+		          << " ticks, " << result.elapsedMilliseconds << " ms, " << nanosecondsPerMessage
+		          << " ns per message" << std::endl;
+	}
+} // namespace
@@ -0,0 +1,90 @@
+#include "gtest/gtest.h"
+
+#include "numeric_types.h"
+
+#include "communication/message_factory.h"
+
+#include "core/address.h"
+#include "core/remote_peer.h"
+#include "core/remote_peers_handler.h"
+
+namespace
+{
+	const uint32 MAX_CONNECTIONS = 300;
+	const uint32 FIRST_PORT = 50000;
+
+	NetLib::Address GetRemotePeerAddress( uint32 id )
+	{
+		return NetLib::Address( NetLib::IPV4_LOOPBACK, FIRST_PORT + id );
+	}
+
+	uint32 CountValidRemotePeers( NetLib::RemotePeersHandler& remote_peers_handler )
+	{
+		uint32 count = 0;
+		auto it = remote_peers_handler.GetValidRemotePeersIterator();
+		auto pastTheEndIt = remote_peers_handler.GetValidRemotePeersPastTheEndIterator();
+		for ( ; it != pastTheEndIt; ++it )
+		{
+			++count;
+		}
+
+		return count;
+	}
+
+	TEST( RemotePeersHandlerTests, LooksUpRemotePeersAfterAddingAndRemovingThem )
+	{
+		NetLib::MessageFactory messageFactory( 4 );
+		NetLib::RemotePeersHandler remotePeersHandler;
+		remotePeersHandler.Initialize( MAX_CONNECTIONS, &messageFactory );
+
+		for ( uint16 id = 0; id < MAX_CONNECTIONS; ++id )
+		{
+			ASSERT_TRUE( remotePeersHandler.AddRemotePeer( GetRemotePeerAddress( id ), id, 0, 0 ) );
+		}
+
+		EXPECT_EQ( remotePeersHandler.GetNumberOfAvailableRemotePeerSlots(), 0 );
+		EXPECT_EQ( remotePeersHandler.FindFreeRemotePeerSlot(), -1 );
+		EXPECT_EQ( remotePeersHandler.IsRemotePeerAbleToConnect( GetRemotePeerAddress( MAX_CONNECTIONS ) ),
+		           NetLib::RemotePeersHandlerResult::RPH_FULL );
+		EXPECT_EQ( CountValidRemotePeers( remotePeersHandler ), MAX_CONNECTIONS );
+
+		// Remove every even remote peer
+		for ( uint16 id = 0; id < MAX_CONNECTIONS; id += 2 )
+		{
+			ASSERT_TRUE( remotePeersHandler.RemoveRemotePeer( id ) );
+		}
+
+		EXPECT_FALSE( remotePeersHandler.RemoveRemotePeer( 0 ) );
+		EXPECT_EQ( remotePeersHandler.GetNumberOfAvailableRemotePeerSlots(), MAX_CONNECTIONS / 2 );
+		EXPECT_EQ( CountValidRemotePeers( remotePeersHandler ), MAX_CONNECTIONS / 2 );
+
+		for ( uint16 id = 0; id < MAX_CONNECTIONS; ++id )
+		{
+			const NetLib::Address address = GetRemotePeerAddress( id );
+			NetLib::RemotePeer* remotePeer = remotePeersHandler.GetRemotePeerFromAddress( address );
+			if ( id % 2 == 0 )
+			{
+				EXPECT_EQ( remotePeer, nullptr );
+				EXPECT_FALSE( remotePeersHandler.DoesRemotePeerIdExist( id ) );
+			}
+			else
+			{
+				ASSERT_NE( remotePeer, nullptr );
+				EXPECT_EQ( remotePeer->GetClientIndex(), id );
+				EXPECT_EQ( remotePeersHandler.GetRemotePeerFromId( id ), remotePeer );
+				EXPECT_EQ( remotePeersHandler.IsRemotePeerAbleToConnect( address ),
+				           NetLib::RemotePeersHandlerResult::RPH_ALREADYEXIST );
+			}
+		}
+
+		// Freed slots are reused
+		ASSERT_TRUE( remotePeersHandler.AddRemotePeer( GetRemotePeerAddress( 0 ), 0, 0, 0 ) );
+		EXPECT_NE( remotePeersHandler.GetRemotePeerFromAddress( GetRemotePeerAddress( 0 ) ), nullptr );
+		EXPECT_EQ( CountValidRemotePeers( remotePeersHandler ), ( MAX_CONNECTIONS / 2 ) + 1 );
+
+		remotePeersHandler.RemoveAllRemotePeers();
+		EXPECT_EQ( remotePeersHandler.GetNumberOfAvailableRemotePeerSlots(), MAX_CONNECTIONS );
+		EXPECT_EQ( CountValidRemotePeers( remotePeersHandler ), 0 );
+		EXPECT_EQ( remotePeersHandler.GetRemotePeerFromAddress( GetRemotePeerAddress( 1 ) ), nullptr );
+	}
+} // namespace
@@ -0,0 +1,376 @@
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <vector>
+
+#include "numeric_types.h"
+
+#include "core/buffer.h"
+#include "core/bit_writer.h"
+#include "core/bit_reader.h"
+
+#include "communication/message.h"
+#include "communication/message_factory.h"
+#include "communication/message_utils.h"
+
+#include "replication/always_relevant_interest_manager.h"
+#include "replication/client_snapshot_tracker.h"
+#include "replication/delta_compression_utils.h"
+#include "replication/network_entity_communication_callbacks.h"
+#include "replication/on_network_entity_create_config.h"
+#include "replication/replication_action_type.h"
+#include "replication/replication_manager.h"
+#include "replication/replication_messages_processor.h"
+
+namespace
+{
+	const uint32 OWNER_PEER_ID = 1;
+	const uint32 NON_OWNER_PEER_ID = 2;
+	const uint32 OTHER_NON_OWNER_PEER_ID = 3;
+	const uint32 NUMBER_OF_STATE_VALUES = 8;
+
+	TEST( ReplicationDeltaTests, DeltaRebuildsTheCurrentState )
+	{
+		uint8 baseline[ 16 ] = {};
+		uint8 current[ 16 ] = {};
+		current[ 3 ] = 42;
+		current[ 15 ] = 7;
+
+		uint8 delta[ 32 ];
+		const uint32 deltaSize = NetLib::DeltaCompressionUtils::EncodeDelta( baseline, current, 16, delta, 32 );
+		// 16 changed bits + 2 changed bytes
+		EXPECT_EQ( deltaSize, 4 );
+
+		uint8 rebuilt[ 16 ];
+		EXPECT_TRUE( NetLib::DeltaCompressionUtils::DecodeDelta( baseline, 16, delta, deltaSize, rebuilt ) );
+		for ( uint32 i = 0; i < 16; ++i )
+		{
+			EXPECT_EQ( rebuilt[ i ], current[ i ] );
+		}
+	}
+
+	TEST( ReplicationDeltaTests, PartiallyReceivedSnapshotIsNotUsedAsBaseline )
+	{
+		NetLib::ClientSnapshotTracker tracker;
+		tracker.BeginSnapshot( 0 );
+		tracker.OnEntityUpdateSent( 7, 0 );
+		tracker.OnEntityUpdateSent( 8, 0 );
+
+		uint16 baseline;
+		tracker.AcknowledgeSnapshot( 0, 1 );
+		EXPECT_FALSE( tracker.TryGetBaseline( 7, 1, baseline ) );
+
+		tracker.AcknowledgeSnapshot( 0, 2 );
+		EXPECT_TRUE( tracker.TryGetBaseline( 7, 1, baseline ) );
+		EXPECT_EQ( baseline, 0 );
+
+		// Entity 9 was never sent, so it has no baseline
+		EXPECT_FALSE( tracker.TryGetBaseline( 9, 1, baseline ) );
+	}
+
+	TEST( ReplicationDeltaTests, BaselineOlderThanTheHistoryIsNotUsed )
+	{
+		NetLib::ClientSnapshotTracker tracker;
+		tracker.BeginSnapshot( 65530 );
+		tracker.OnEntityUpdateSent( 7, 65530 );
+		tracker.AcknowledgeSnapshot( 65530, 1 );
+
+		uint16 baseline;
+		// The sequence number wraps around
+		EXPECT_TRUE( tracker.TryGetBaseline( 7, 4, baseline ) );
+		EXPECT_EQ( baseline, 65530 );
+
+		const uint16 tooNew = static_cast< uint16 >( 65530 + NetLib::SNAPSHOT_HISTORY_SIZE );
+		EXPECT_FALSE( tracker.TryGetBaseline( 7, tooNew, baseline ) );
+	}
+
+	class ReplicationDeltaEndToEndTests : public ::testing::Test
+	{
+		protected:
+			ReplicationDeltaEndToEndTests()
+			    : _messageFactory( 8 )
+			    , _serverValues()
+			    , _clientValues()
+			    , _numberOfSerializations( 0 )
+			{
+			}
+
+			void SetUp() override
+			{
+				_server.SubscribeToOnNetworkEntityCreate(
+				    [ this ]( const NetLib::OnNetworkEntityCreateConfig& config )
+				    {
+					    auto serialize = [ this ]( NetLib::BitWriter& writer )
+					    {
+						    ++_numberOfSerializations;
+						    for ( uint32 i = 0; i < NUMBER_OF_STATE_VALUES; ++i )
+						    {
+							    writer.WriteInteger( _serverValues[ i ] );
+						    }
+					    };
+					    config.communicationCallbacks->OnSerializeEntityStateForNonOwner.AddSubscriber( serialize );
+				    } );
+				_server.SubscribeToOnNetworkEntityDestroy( []( uint32 ) {} );
+
+				_client.SetLocalClientId( NON_OWNER_PEER_ID );
+				_client.SubscribeToOnNetworkEntityCreate(
+				    [ this ]( const NetLib::OnNetworkEntityCreateConfig& config )
+				    {
+					    auto deserialize = [ this ]( NetLib::BitReader& reader )
+					    {
+						    for ( uint32 i = 0; i < NUMBER_OF_STATE_VALUES; ++i )
+						    {
+							    reader.ReadInteger( _clientValues[ i ] );
+						    }
+					    };
+					    config.communicationCallbacks->OnUnserializeEntityStateForNonOwner.AddSubscriber( deserialize );
+				    } );
+				_client.SubscribeToOnNetworkEntityDestroy( []( uint32 ) {} );
+
+				_server.SetInterestManager( &_interestManager );
+				_server.CreateNetworkEntity( 0, OWNER_PEER_ID, 0.f, 0.f );
+			}
+
+			// Replicates one snapshot to the non owner peer through the wire format. Returns whether the entity
+			// update was delta encoded.
+			bool ReplicateSnapshot( bool deliver_acks )
+			{
+				std::vector< std::unique_ptr< NetLib::ReplicationMessage > > messages;
+				_server.Server_ReplicateWorldState( _messageFactory, NON_OWNER_PEER_ID, messages );
+				_server.Server_IncrementSnapshotSequenceNumber();
+
+				bool isDeltaEncoded = false;
+				for ( auto it = messages.begin(); it != messages.end(); ++it )
+				{
+					uint8 data[ 256 ];
+					NetLib::Buffer buffer( data, 256 );
+					( *it )->Write( buffer );
+					buffer.ResetAccessIndex();
+
+					std::unique_ptr< NetLib::Message > receivedMessage =
+					    NetLib::MessageUtils::ReadMessage( _messageFactory, buffer );
+					EXPECT_NE( receivedMessage, nullptr );
+					const NetLib::ReplicationMessage& replicationMessage =
+					    static_cast< const NetLib::ReplicationMessage& >( *receivedMessage );
+					if ( replicationMessage.replicationAction ==
+					     static_cast< uint8 >( NetLib::ReplicationActionType::UPDATE ) )
+					{
+						isDeltaEncoded = replicationMessage.isDeltaEncoded;
+					}
+
+					_client.Client_ProcessReceivedReplicationMessage( replicationMessage );
+					_messageFactory.ReleaseMessage( std::move( receivedMessage ) );
+					_messageFactory.ReleaseMessage( std::move( *it ) );
+				}
+
+				_client.Client_ConsumePendingSnapshotAcks(
+				    [ this, deliver_acks ]( uint16 snapshot_sequence_number, uint16 number_of_updates_received )
+				    {
+					    if ( deliver_acks )
+					    {
+						    _server.Server_ProcessReplicationAck( NON_OWNER_PEER_ID, snapshot_sequence_number,
+						                                          number_of_updates_received );
+					    }
+				    } );
+
+				return isDeltaEncoded;
+			}
+
+			void ExpectClientStateMatchesServer() const
+			{
+				for ( uint32 i = 0; i < NUMBER_OF_STATE_VALUES; ++i )
+				{
+					EXPECT_EQ( _clientValues[ i ], _serverValues[ i ] );
+				}
+			}
+
+			NetLib::MessageFactory _messageFactory;
+			NetLib::AlwaysRelevantInterestManager _interestManager;
+			NetLib::ReplicationManager _server;
+			NetLib::ReplicationMessagesProcessor _client;
+			uint32 _serverValues[ NUMBER_OF_STATE_VALUES ];
+			uint32 _clientValues[ NUMBER_OF_STATE_VALUES ];
+			uint32 _numberOfSerializations;
+	};
+
+	TEST_F( ReplicationDeltaEndToEndTests, UpdatesAreDeltaEncodedOnceTheBaselineIsAcked )
+	{
+		_serverValues[ 0 ] = 10;
+		EXPECT_FALSE( ReplicateSnapshot( true ) );
+		ExpectClientStateMatchesServer();
+
+		_serverValues[ 0 ] = 11;
+		_serverValues[ 5 ] = 500;
+		EXPECT_TRUE( ReplicateSnapshot( true ) );
+		ExpectClientStateMatchesServer();
+	}
+
+	TEST_F( ReplicationDeltaEndToEndTests, FullStateIsSentUntilTheClientAcksASnapshot )
+	{
+		_serverValues[ 0 ] = 10;
+		EXPECT_FALSE( ReplicateSnapshot( false ) );
+		_serverValues[ 0 ] = 20;
+		EXPECT_FALSE( ReplicateSnapshot( false ) );
+		ExpectClientStateMatchesServer();
+
+		// Once acked, deltas are computed against the last acked snapshot even if newer ones were lost
+		_serverValues[ 1 ] = 30;
+		EXPECT_FALSE( ReplicateSnapshot( true ) );
+		_serverValues[ 1 ] = 40;
+		EXPECT_TRUE( ReplicateSnapshot( false ) );
+		_serverValues[ 2 ] = 50;
+		EXPECT_TRUE( ReplicateSnapshot( false ) );
+		ExpectClientStateMatchesServer();
+	}
+
+	TEST_F( ReplicationDeltaEndToEndTests, NonOwnerStateIsSerializedOncePerSnapshotForAllRemotePeers )
+	{
+		std::vector< std::unique_ptr< NetLib::ReplicationMessage > > firstPeerMessages;
+		std::vector< std::unique_ptr< NetLib::ReplicationMessage > > secondPeerMessages;
+		_server.Server_ReplicateWorldState( _messageFactory, NON_OWNER_PEER_ID, firstPeerMessages );
+		_server.Server_ReplicateWorldState( _messageFactory, OTHER_NON_OWNER_PEER_ID, secondPeerMessages );
+		EXPECT_EQ( _numberOfSerializations, 1 );
+
+		// Both update messages reference the same payload
+		ASSERT_EQ( firstPeerMessages.size(), secondPeerMessages.size() );
+		EXPECT_NE( firstPeerMessages.back()->data, nullptr );
+		EXPECT_EQ( firstPeerMessages.back()->data, secondPeerMessages.back()->data );
+
+		// Releasing the messages of one peer doesn't free the payload still referenced by the other one
+		_server.Server_IncrementSnapshotSequenceNumber();
+		for ( auto it = firstPeerMessages.begin(); it != firstPeerMessages.end(); ++it )
+		{
+			_messageFactory.ReleaseMessage( std::move( *it ) );
+		}
+		firstPeerMessages.clear();
+		EXPECT_EQ( secondPeerMessages.back()->dataSize, NUMBER_OF_STATE_VALUES * sizeof( uint32 ) );
+		EXPECT_EQ( secondPeerMessages.back()->GetPayload().use_count(), 1 );
+		for ( auto it = secondPeerMessages.begin(); it != secondPeerMessages.end(); ++it )
+		{
+			_messageFactory.ReleaseMessage( std::move( *it ) );
+		}
+
+		_server.Server_ReplicateWorldState( _messageFactory, NON_OWNER_PEER_ID, firstPeerMessages );
+		EXPECT_EQ( _numberOfSerializations, 2 );
+		for ( auto it = firstPeerMessages.begin(); it != firstPeerMessages.end(); ++it )
+		{
+			_messageFactory.ReleaseMessage( std::move( *it ) );
+		}
+	}
+
+	class ReplicationBigStateTests : public ::testing::Test
+	{
+		protected:
+			ReplicationBigStateTests()
+			    : _messageFactory( 8 )
+			    , _serverValues()
+			    , _clientValues()
+			{
+			}
+
+			void SetUp() override
+			{
+				_server.SubscribeToOnNetworkEntityCreate(
+				    [ this ]( const NetLib::OnNetworkEntityCreateConfig& config )
+				    {
+					    auto serialize = [ this ]( NetLib::BitWriter& writer )
+					    {
+						    for ( auto it = _serverValues.cbegin(); it != _serverValues.cend(); ++it )
+						    {
+							    writer.WriteInteger( *it );
+						    }
+					    };
+					    config.communicationCallbacks->OnSerializeEntityStateForNonOwner.AddSubscriber( serialize );
+				    } );
+				_server.SubscribeToOnNetworkEntityDestroy( []( uint32 ) {} );
+				_server.SetInterestManager( &_interestManager );
+
+				_client.SetLocalClientId( NON_OWNER_PEER_ID );
+				_client.SubscribeToOnNetworkEntityCreate(
+				    [ this ]( const NetLib::OnNetworkEntityCreateConfig& config )
+				    {
+					    auto deserialize = [ this ]( NetLib::BitReader& reader )
+					    {
+						    for ( auto it = _clientValues.begin(); it != _clientValues.end(); ++it )
+						    {
+							    reader.ReadInteger( *it );
+						    }
+					    };
+					    config.communicationCallbacks->OnUnserializeEntityStateForNonOwner.AddSubscriber( deserialize );
+				    } );
+				_client.SubscribeToOnNetworkEntityDestroy( []( uint32 ) {} );
+			}
+
+			void TearDown() override { _server.SetInterestManager( nullptr ); }
+
+			// Replicates one snapshot to the non owner peer, acking it back. Returns the number of entity updates
+			// sent and whether any of them was delta encoded.
+			uint32 ReplicateSnapshot( bool& is_delta_encoded )
+			{
+				std::vector< std::unique_ptr< NetLib::ReplicationMessage > > messages;
+				_server.Server_ReplicateWorldState( _messageFactory, NON_OWNER_PEER_ID, messages );
+				_server.Server_IncrementSnapshotSequenceNumber();
+
+				uint32 numberOfUpdates = 0;
+				is_delta_encoded = false;
+				for ( auto it = messages.begin(); it != messages.end(); ++it )
+				{
+					if ( ( *it )->replicationAction == static_cast< uint8 >( NetLib::ReplicationActionType::UPDATE ) )
+					{
+						is_delta_encoded |= ( *it )->isDeltaEncoded;
+						++numberOfUpdates;
+					}
+
+					_client.Client_ProcessReceivedReplicationMessage( **it );
+					_messageFactory.ReleaseMessage( std::move( *it ) );
+				}
+
+				_client.Client_ConsumePendingSnapshotAcks(
+				    [ this ]( uint16 snapshot_sequence_number, uint16 number_of_updates_received ) {
+					    _server.Server_ProcessReplicationAck( NON_OWNER_PEER_ID, snapshot_sequence_number,
+					                                          number_of_updates_received );
+				    } );
+
+				return numberOfUpdates;
+			}
+
+			NetLib::MessageFactory _messageFactory;
+			NetLib::AlwaysRelevantInterestManager _interestManager;
+			NetLib::ReplicationManager _server;
+			NetLib::ReplicationMessagesProcessor _client;
+			std::vector< uint32 > _serverValues;
+			std::vector< uint32 > _clientValues;
+	};
+
+	TEST_F( ReplicationBigStateTests, StatesBiggerThanTheHistoryAreSentWithoutDelta )
+	{
+		// Still small enough for its update to fit in a single packet
+		const uint32 numberOfValues = ( NetLib::MAX_ENTITY_STATE_SIZE / sizeof( uint32 ) ) * 2;
+		_serverValues.assign( numberOfValues, 1 );
+		_clientValues.assign( numberOfValues, 0 );
+		_server.CreateNetworkEntity( 0, OWNER_PEER_ID, 0.f, 0.f );
+
+		bool isDeltaEncoded = false;
+		EXPECT_EQ( ReplicateSnapshot( isDeltaEncoded ), 1 );
+		EXPECT_FALSE( isDeltaEncoded );
+		EXPECT_EQ( _clientValues, _serverValues );
+
+		// The first snapshot has been acked, but there is no baseline to encode a delta against
+		_serverValues[ numberOfValues - 1 ] = 2;
+		EXPECT_EQ( ReplicateSnapshot( isDeltaEncoded ), 1 );
+		EXPECT_FALSE( isDeltaEncoded );
+		EXPECT_EQ( _clientValues, _serverValues );
+	}
+
+	TEST_F( ReplicationBigStateTests, StatesBiggerThanTheReplicationDataLimitAreSkipped )
+	{
+		const uint32 numberOfValues = ( NetLib::MAX_REPLICATION_DATA_SIZE / sizeof( uint32 ) ) + 1;
+		_serverValues.assign( numberOfValues, 1 );
+		_clientValues.assign( numberOfValues, 0 );
+		_server.CreateNetworkEntity( 0, OWNER_PEER_ID, 0.f, 0.f );
+
+		bool isDeltaEncoded = false;
+		EXPECT_EQ( ReplicateSnapshot( isDeltaEncoded ), 0 );
+		EXPECT_EQ( _clientValues[ 0 ], 0 );
+	}
+} // namespace
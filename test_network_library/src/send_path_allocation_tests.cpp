@@ -0,0 +1,160 @@
+#include "gtest/gtest.h"
+
+#include <cstdlib>
+#include <new>
+
+#include "numeric_types.h"
+
+#include "communication/message.h"
+#include "communication/message_factory.h"
+#include "communication/message_utils.h"
+
+#include "core/address.h"
+#include "core/buffer.h"
+#include "core/socket.h"
+#include "core/datagram_send_queue.h"
+
+#include "metrics/metrics_handler.h"
+
+#include "transmission_channels/unreliable_unordered_transmission_channel.h"
+
+// Global allocation counter. Only the allocations done while counting is enabled are tracked.
+namespace
+{
+	bool g_isCountingAllocations = false;
+	uint32 g_numberOfAllocations = 0;
+
+	void* CountedAllocation( size_t size )
+	{
+		if ( g_isCountingAllocations )
+		{
+			++g_numberOfAllocations;
+		}
+
+		return std::malloc( size == 0 ? 1 : size );
+	}
+} // namespace
+
+void* operator new( size_t size )
+{
+	return CountedAllocation( size );
+}
+
+void* operator new[]( size_t size )
+{
+	return CountedAllocation( size );
+}
+
+void operator delete( void* pointer ) noexcept
+{
+	std::free( pointer );
+}
+
+void operator delete[]( void* pointer ) noexcept
+{
+	std::free( pointer );
+}
+
+void operator delete( void* pointer, size_t ) noexcept
+{
+	std::free( pointer );
+}
+
+void operator delete[]( void* pointer, size_t ) noexcept
+{
+	std::free( pointer );
+}
+
+namespace
+{
+	void AddUnreliableMessages( NetLib::MessageFactory& message_factory,
+	                            NetLib::UnreliableUnorderedTransmissionChannel& channel, uint32 number_of_messages )
+	{
+		for ( uint32 i = 0; i < number_of_messages; ++i )
+		{
+			std::unique_ptr< NetLib::Message > message =
+			    message_factory.LendMessage( NetLib::MessageType::TimeRequest );
+			message->SetReliability( false );
+			message->SetOrdered( false );
+			channel.AddMessageToSend( std::move( message ) );
+		}
+	}
+
+	TEST( SendPathAllocationTests, UnreliableChannelSteadyStateTickDoesNotAllocate )
+	{
+		const uint32 MESSAGES_PER_TICK = 4;
+		const uint32 WARM_UP_TICKS = 10;
+		const uint32 MEASURED_TICKS = 200;
+
+		NetLib::Socket socket;
+		ASSERT_EQ( socket.Start(), NetLib::SocketResult::SOKT_SUCCESS );
+		ASSERT_EQ( socket.Bind( NetLib::Address( NetLib::IPV4_LOOPBACK, 0 ) ), NetLib::SocketResult::SOKT_SUCCESS );
+		const NetLib::Address remoteAddress( NetLib::IPV4_LOOPBACK, 54999 );
+
+		NetLib::MessageFactory messageFactory( 8 );
+		NetLib::Metrics::MetricsHandler metricsHandler;
+		metricsHandler.StartUp( 1.f, NetLib::Metrics::MetricsEnableConfig::CUSTOM,
+		                        { NetLib::Metrics::MetricType::UPLOAD_BANDWIDTH } );
+		NetLib::DatagramSendQueue sendQueue( socket, 16, NetLib::MTU_SIZE_BYTES );
+		NetLib::UnreliableUnorderedTransmissionChannel channel( &messageFactory );
+
+		// Warm up so every reusable container reaches its steady state capacity
+		for ( uint32 i = 0; i < WARM_UP_TICKS; ++i )
+		{
+			AddUnreliableMessages( messageFactory, channel, MESSAGES_PER_TICK );
+			EXPECT_TRUE( channel.CreateAndSendPacket( sendQueue, remoteAddress, metricsHandler ) );
+			sendQueue.Flush();
+		}
+
+		g_numberOfAllocations = 0;
+		g_isCountingAllocations = true;
+		for ( uint32 i = 0; i < MEASURED_TICKS; ++i )
+		{
+			AddUnreliableMessages( messageFactory, channel, MESSAGES_PER_TICK );
+			channel.CreateAndSendPacket( sendQueue, remoteAddress, metricsHandler );
+			sendQueue.Flush();
+		}
+		g_isCountingAllocations = false;
+
+		EXPECT_EQ( g_numberOfAllocations, 0 );
+
+		metricsHandler.ShutDown();
+	}
+
+	TEST( SendPathAllocationTests, SmallInputMessagesDoNotAllocate )
+	{
+		const uint16 INPUT_DATA_SIZE = 24;
+		const uint32 NUMBER_OF_MESSAGES = 200;
+
+		NetLib::MessageFactory messageFactory( 4 );
+		uint8 serializedData[ NetLib::MESSAGE_INLINE_DATA_SIZE * 2 ];
+
+		g_numberOfAllocations = 0;
+		g_isCountingAllocations = true;
+		for ( uint32 i = 0; i < NUMBER_OF_MESSAGES; ++i )
+		{
+			// Outgoing message
+			std::unique_ptr< NetLib::Message > message = messageFactory.LendMessage( NetLib::MessageType::Inputs );
+			NetLib::InputStateMessage& inputStateMessage = static_cast< NetLib::InputStateMessage& >( *message );
+			uint8* data = inputStateMessage.AllocateData( INPUT_DATA_SIZE );
+			for ( uint32 j = 0; j < INPUT_DATA_SIZE; ++j )
+			{
+				data[ j ] = static_cast< uint8 >( i + j );
+			}
+
+			NetLib::Buffer writeBuffer( serializedData, sizeof( serializedData ) );
+			message->Write( writeBuffer );
+			messageFactory.ReleaseMessage( std::move( message ) );
+
+			// Incoming message
+			NetLib::Buffer readBuffer( serializedData, sizeof( serializedData ) );
+			message = NetLib::MessageUtils::ReadMessage( messageFactory, readBuffer );
+			ASSERT_NE( message, nullptr );
+			EXPECT_EQ( static_cast< NetLib::InputStateMessage& >( *message ).data[ 0 ], static_cast< uint8 >( i ) );
+			messageFactory.ReleaseMessage( std::move( message ) );
+		}
+		g_isCountingAllocations = false;
+
+		EXPECT_EQ( g_numberOfAllocations, 0 );
+	}
+} // namespace
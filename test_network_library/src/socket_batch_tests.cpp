@@ -0,0 +1,94 @@
+#include "gtest/gtest.h"
+
+#include <cstring>
+
+#include "numeric_types.h"
+
+#include "core/address.h"
+#include "core/socket.h"
+#include "core/datagram_batch.h"
+
+namespace
+{
+	const uint32 DATAGRAM_MAX_SIZE = 64;
+	const uint32 TRUNCATION_RECEIVER_PORT = 47860;
+	const uint32 FAILED_SEND_RECEIVER_PORT = 47861;
+
+	void StartLoopbackSockets( NetLib::Socket& receiver, NetLib::Socket& sender, uint32 receiver_port )
+	{
+		ASSERT_EQ( receiver.Start(), NetLib::SocketResult::SOKT_SUCCESS );
+		ASSERT_EQ( receiver.Bind( NetLib::Address( NetLib::IPV4_LOOPBACK, receiver_port ) ),
+		           NetLib::SocketResult::SOKT_SUCCESS );
+		ASSERT_EQ( sender.Start(), NetLib::SocketResult::SOKT_SUCCESS );
+		ASSERT_EQ( sender.Bind( NetLib::Address( NetLib::IPV4_LOOPBACK, 0 ) ), NetLib::SocketResult::SOKT_SUCCESS );
+	}
+
+	void AddDatagram( NetLib::DatagramBatch& batch, uint8 value, uint32 size, const NetLib::Address& address )
+	{
+		uint8* slot = batch.GetNextFreeSlot();
+		ASSERT_NE( slot, nullptr );
+		std::memset( slot, value, size );
+		ASSERT_TRUE( batch.CommitNextFreeSlot( size, address ) );
+	}
+
+#if defined( __linux__ )
+	// Winsock reads datagram by datagram and stops at the first one that doesn't fit, so only recvmmsg compacts them
+	TEST( SocketBatchTests, TruncatedDatagramsAreRemovedFromTheReceivedBatch )
+	{
+		const NetLib::Address receiverAddress( NetLib::IPV4_LOOPBACK, TRUNCATION_RECEIVER_PORT );
+		NetLib::Socket receiver;
+		NetLib::Socket sender;
+		StartLoopbackSockets( receiver, sender, TRUNCATION_RECEIVER_PORT );
+
+		uint8 data[ DATAGRAM_MAX_SIZE * 2 ];
+		std::memset( data, 1, 10 );
+		ASSERT_EQ( sender.SendTo( data, 10, receiverAddress ), NetLib::SocketResult::SOKT_SUCCESS );
+		std::memset( data, 2, DATAGRAM_MAX_SIZE * 2 );
+		ASSERT_EQ( sender.SendTo( data, DATAGRAM_MAX_SIZE * 2, receiverAddress ), NetLib::SocketResult::SOKT_SUCCESS );
+		std::memset( data, 3, 20 );
+		ASSERT_EQ( sender.SendTo( data, 20, receiverAddress ), NetLib::SocketResult::SOKT_SUCCESS );
+
+		// Loopback datagrams are queued as soon as they are sent, so a single call reads all of them
+		ASSERT_EQ( receiver.WaitForIncomingData( 200 ), NetLib::SocketResult::SOKT_SUCCESS );
+		NetLib::DatagramBatch batch( 8, DATAGRAM_MAX_SIZE );
+		NetLib::Address resetRemoteAddress = NetLib::Address::GetInvalid();
+		EXPECT_EQ( receiver.ReceiveBatchFrom( batch, resetRemoteAddress ), NetLib::SocketResult::SOKT_SUCCESS );
+
+		ASSERT_EQ( batch.GetCount(), 2 );
+		EXPECT_EQ( batch.GetDatagramSize( 0 ), 10 );
+		EXPECT_EQ( batch.GetDatagramData( 0 )[ 9 ], 1 );
+		EXPECT_EQ( batch.GetDatagramSize( 1 ), 20 );
+		EXPECT_EQ( batch.GetDatagramData( 1 )[ 0 ], 3 );
+		EXPECT_EQ( batch.GetDatagramData( 1 )[ 19 ], 3 );
+	}
+#endif
+
+	TEST( SocketBatchTests, FailedDatagramsDontBlockTheRestOfTheBatch )
+	{
+		const NetLib::Address receiverAddress( NetLib::IPV4_LOOPBACK, FAILED_SEND_RECEIVER_PORT );
+		NetLib::Socket receiver;
+		NetLib::Socket sender;
+		StartLoopbackSockets( receiver, sender, FAILED_SEND_RECEIVER_PORT );
+
+		// The sender doesn't allow broadcasts, so the first datagram is rejected
+		NetLib::DatagramBatch batch( 4, DATAGRAM_MAX_SIZE );
+		AddDatagram( batch, 1, 10, NetLib::Address( "255.255.255.255", FAILED_SEND_RECEIVER_PORT ) );
+		AddDatagram( batch, 2, 20, receiverAddress );
+		AddDatagram( batch, 3, 30, receiverAddress );
+
+		uint32 numberOfDatagramsSent = 0;
+		EXPECT_EQ( sender.SendBatchTo( batch, numberOfDatagramsSent ), NetLib::SocketResult::SOKT_ERR );
+		EXPECT_EQ( numberOfDatagramsSent, 2 );
+
+		ASSERT_EQ( receiver.WaitForIncomingData( 200 ), NetLib::SocketResult::SOKT_SUCCESS );
+		NetLib::DatagramBatch receivedBatch( 4, DATAGRAM_MAX_SIZE );
+		NetLib::Address resetRemoteAddress = NetLib::Address::GetInvalid();
+		EXPECT_EQ( receiver.ReceiveBatchFrom( receivedBatch, resetRemoteAddress ), NetLib::SocketResult::SOKT_SUCCESS );
+
+		ASSERT_EQ( receivedBatch.GetCount(), 2 );
+		EXPECT_EQ( receivedBatch.GetDatagramSize( 0 ), 20 );
+		EXPECT_EQ( receivedBatch.GetDatagramData( 0 )[ 0 ], 2 );
+		EXPECT_EQ( receivedBatch.GetDatagramSize( 1 ), 30 );
+		EXPECT_EQ( receivedBatch.GetDatagramData( 1 )[ 0 ], 3 );
+	}
+} // namespace
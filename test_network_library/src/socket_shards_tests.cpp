@@ -0,0 +1,119 @@
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "numeric_types.h"
+
+#include "core/client.h"
+#include "core/server.h"
+#include "core/remote_peer.h"
+#include "core/initializer.h"
+
+namespace
+{
+	const uint32 NUMBER_OF_CLIENTS = 16;
+	const uint32 NUMBER_OF_SOCKET_SHARDS = 2;
+	const uint32 SERVER_PORT = 47870;
+	const float32 TICK_ELAPSED_TIME = 0.05f;
+	const float32 SERVER_MAX_INACTIVITY_TIMEOUT = 1.f;
+
+	// Gives access to the remote peers of the server to check which socket shard handles them
+	class ShardedServer : public NetLib::Server
+	{
+		public:
+			ShardedServer()
+			    : NetLib::Server( NUMBER_OF_CLIENTS )
+			{
+			}
+
+			uint32 GetNumberOfRemotePeersInSocketShard( uint32 socket_shard_index )
+			{
+				uint32 numberOfRemotePeers = 0;
+				auto it = _remotePeersHandler.GetValidRemotePeersIterator();
+				auto pastTheEndIt = _remotePeersHandler.GetValidRemotePeersPastTheEndIterator();
+				for ( ; it != pastTheEndIt; ++it )
+				{
+					if ( ( *it )->GetSocketShardIndex() == socket_shard_index )
+					{
+						++numberOfRemotePeers;
+					}
+				}
+
+				return numberOfRemotePeers;
+			}
+	};
+
+	class SocketShardsTests : public ::testing::Test
+	{
+		protected:
+			void SetUp() override { NetLib::Initializer::Initialize(); }
+			void TearDown() override { NetLib::Initializer::Finalize(); }
+	};
+
+	void TickPeers( ShardedServer& server, std::vector< std::unique_ptr< NetLib::Client > >& clients,
+	                uint32 number_of_ticks )
+	{
+		for ( uint32 i = 0; i < number_of_ticks; ++i )
+		{
+			server.PreTick();
+			server.Tick( TICK_ELAPSED_TIME );
+			for ( auto it = clients.begin(); it != clients.end(); ++it )
+			{
+				( *it )->PreTick();
+				( *it )->Tick( TICK_ELAPSED_TIME );
+			}
+
+			// Let the receive threads queue what has just been sent
+			std::this_thread::sleep_for( std::chrono::milliseconds( 2 ) );
+		}
+	}
+
+#if defined( __linux__ )
+	// Windows doesn't support SO_REUSEPORT, so the server falls back to a single socket there
+	TEST_F( SocketShardsTests, RemotePeersAreServedThroughTheSocketTheirTrafficArrivesOn )
+	{
+		ShardedServer server;
+		server.SetNumberOfSocketShards( NUMBER_OF_SOCKET_SHARDS );
+		ASSERT_TRUE( server.StartServer( SERVER_PORT ) );
+
+		std::vector< std::unique_ptr< NetLib::Client > > clients;
+		for ( uint32 i = 0; i < NUMBER_OF_CLIENTS; ++i )
+		{
+			clients.push_back( std::make_unique< NetLib::Client >( SERVER_MAX_INACTIVITY_TIMEOUT ) );
+			ASSERT_TRUE( clients.back()->StartClient( "127.0.0.1", SERVER_PORT ) );
+		}
+
+		TickPeers( server, clients, 20 );
+		for ( auto it = clients.begin(); it != clients.end(); ++it )
+		{
+			EXPECT_EQ( ( *it )->GetConnectionState(), NetLib::PeerConnectionState::Connected );
+		}
+
+		// The OS spreads the clients among both sockets. The chance of all of them landing on the main one is 2^-16
+		const uint32 numberOfRemotePeersInMainShard = server.GetNumberOfRemotePeersInSocketShard( 0 );
+		const uint32 numberOfRemotePeersInSecondShard = server.GetNumberOfRemotePeersInSocketShard( 1 );
+		EXPECT_EQ( numberOfRemotePeersInMainShard + numberOfRemotePeersInSecondShard, NUMBER_OF_CLIENTS );
+		EXPECT_GT( numberOfRemotePeersInSecondShard, 0 );
+
+		// After the connection handshake, which goes through the main socket, the clients only hear from the server
+		// through the socket of their shard. They would time out if that data didn't reach them
+		TickPeers( server, clients, 3 * static_cast< uint32 >( SERVER_MAX_INACTIVITY_TIMEOUT / TICK_ELAPSED_TIME ) );
+		for ( auto it = clients.begin(); it != clients.end(); ++it )
+		{
+			EXPECT_EQ( ( *it )->GetConnectionState(), NetLib::PeerConnectionState::Connected );
+		}
+
+		// Peers stop on their next tick
+		for ( auto it = clients.begin(); it != clients.end(); ++it )
+		{
+			( *it )->Stop();
+		}
+
+		server.Stop();
+		TickPeers( server, clients, 1 );
+	}
+#endif
+} // namespace
@@ -0,0 +1,82 @@
+#include "gtest/gtest.h"
+
+#include <cstring>
+
+#include "numeric_types.h"
+
+#include "core/address.h"
+#include "core/socket.h"
+
+namespace
+{
+	const uint32 LOOPBACK_RECEIVER_PORT = 47840;
+	const uint32 TRUNCATION_RECEIVER_PORT = 47841;
+
+	void StartLoopbackSockets( NetLib::Socket& receiver, NetLib::Socket& sender, uint32 receiver_port )
+	{
+		ASSERT_EQ( receiver.Start(), NetLib::SocketResult::SOKT_SUCCESS );
+		ASSERT_EQ( receiver.Bind( NetLib::Address( NetLib::IPV4_LOOPBACK, receiver_port ) ),
+		           NetLib::SocketResult::SOKT_SUCCESS );
+		ASSERT_EQ( sender.Start(), NetLib::SocketResult::SOKT_SUCCESS );
+		ASSERT_EQ( sender.Bind( NetLib::Address( NetLib::IPV4_LOOPBACK, 0 ) ), NetLib::SocketResult::SOKT_SUCCESS );
+	}
+
+	TEST( SocketTests, DatagramSentThroughLoopbackIsReceivedOnceReady )
+	{
+		const NetLib::Address receiverAddress( NetLib::IPV4_LOOPBACK, LOOPBACK_RECEIVER_PORT );
+		NetLib::Socket receiver;
+		NetLib::Socket sender;
+		StartLoopbackSockets( receiver, sender, LOOPBACK_RECEIVER_PORT );
+
+		uint8 data[ 32 ];
+		uint32 numberOfBytesRead = 0;
+		NetLib::Address remoteAddress = NetLib::Address::GetInvalid();
+
+		// Nothing has been sent yet, so neither waiting nor reading find any data
+		EXPECT_EQ( receiver.WaitForIncomingData( 0 ), NetLib::SocketResult::SOKT_WOULDBLOCK );
+		EXPECT_EQ( receiver.ReceiveFrom( data, sizeof( data ), remoteAddress, numberOfBytesRead ),
+		           NetLib::SocketResult::SOKT_WOULDBLOCK );
+
+		std::memset( data, 7, sizeof( data ) );
+		ASSERT_EQ( sender.SendTo( data, 20, receiverAddress ), NetLib::SocketResult::SOKT_SUCCESS );
+
+		ASSERT_EQ( receiver.WaitForIncomingData( 200 ), NetLib::SocketResult::SOKT_SUCCESS );
+		std::memset( data, 0, sizeof( data ) );
+		ASSERT_EQ( receiver.ReceiveFrom( data, sizeof( data ), remoteAddress, numberOfBytesRead ),
+		           NetLib::SocketResult::SOKT_SUCCESS );
+		EXPECT_EQ( numberOfBytesRead, 20 );
+		EXPECT_EQ( data[ 0 ], 7 );
+		EXPECT_EQ( data[ 19 ], 7 );
+		EXPECT_EQ( data[ 20 ], 0 );
+		EXPECT_NE( remoteAddress.GetPort(), 0 );
+
+		// The only datagram has been read, so the socket is no longer ready
+		EXPECT_EQ( receiver.WaitForIncomingData( 0 ), NetLib::SocketResult::SOKT_WOULDBLOCK );
+	}
+
+#if defined( __linux__ )
+	// Winsock reports the truncation through its own error code, only the epoll backend reads it through MSG_TRUNC
+	TEST( SocketTests, DatagramBiggerThanTheBufferIsReportedAsAnError )
+	{
+		const NetLib::Address receiverAddress( NetLib::IPV4_LOOPBACK, TRUNCATION_RECEIVER_PORT );
+		NetLib::Socket receiver;
+		NetLib::Socket sender;
+		StartLoopbackSockets( receiver, sender, TRUNCATION_RECEIVER_PORT );
+
+		uint8 data[ 64 ];
+		std::memset( data, 1, sizeof( data ) );
+		ASSERT_EQ( sender.SendTo( data, sizeof( data ), receiverAddress ), NetLib::SocketResult::SOKT_SUCCESS );
+		ASSERT_EQ( sender.SendTo( data, 10, receiverAddress ), NetLib::SocketResult::SOKT_SUCCESS );
+
+		ASSERT_EQ( receiver.WaitForIncomingData( 200 ), NetLib::SocketResult::SOKT_SUCCESS );
+		uint32 numberOfBytesRead = 0;
+		NetLib::Address remoteAddress = NetLib::Address::GetInvalid();
+		EXPECT_EQ( receiver.ReceiveFrom( data, 32, remoteAddress, numberOfBytesRead ), NetLib::SocketResult::SOKT_ERR );
+
+		// The truncated datagram is consumed, so the next one is read normally
+		ASSERT_EQ( receiver.ReceiveFrom( data, 32, remoteAddress, numberOfBytesRead ),
+		           NetLib::SocketResult::SOKT_SUCCESS );
+		EXPECT_EQ( numberOfBytesRead, 10 );
+	}
+#endif
+} // namespace
@@ -0,0 +1,44 @@
+local project_data = PROJECT_DATA.TEST_NETWORK_LIBRARY
+local common_project_data = PROJECT_DATA.COMMON
+local network_library_project_data = PROJECT_DATA.NETWORK_LIBRARY
+
+project (project_data.NAME)
+	kind "ConsoleApp"
+	location (project_data.PATH)
+	language "C++"
+	targetdir (project_data.PATH .. "bin/")
+	targetname (project_data.NAME .. "_%{cfg.buildcfg}")
+
+	files
+	{
+		ROOT_PATH "vendor/googletest/googletest/src/gtest-all.cc",
+
+		project_data.PATH .. "src/**.h",
+		project_data.PATH .. "src/**.cpp"
+	}
+
+	includedirs
+	{
+		project_data.PATH .. "src",
+		common_project_data.PATH .. "src",
+		network_library_project_data.PATH .. "src",
+
+		ROOT_PATH "vendor/googletest/googletest/include",
+		ROOT_PATH "vendor/googletest/googletest"
+	}
+
+	libdirs
+	{
+	}
+
+	links
+	{
+		network_library_project_data.NAME,
+		common_project_data.NAME
+	}
+
+	filter "system:Windows"
+		links
+		{
+			"Ws2_32"
+		}